@@ -0,0 +1,168 @@
+#include "CommandScript.h"
+#include "GameEngine.h"
+#include "HardcodedDescAdapter.h"
+#include "HeadlessAdapter.h"
+#include "IGenerateDescriptionPort.h"
+#include "ILoadGameStatePort.h"
+#include "ISaveGameStatePort.h"
+#include "InMemoryAdapter.h"
+#include "Log.h"
+#include "PlayerActionCommand.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Counts every heap allocation made by the benchmark process so turns can be
+// reported in allocations per turn. This includes the description worker.
+namespace {
+std::atomic<std::size_t> allocation_count{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+void addCounters(benchmark::State &state, uint64_t cnt) {
+  state.counters["OPS"] = benchmark::Counter(cnt, benchmark::Counter::kIsRate);
+  state.counters["Latency"] = benchmark::Counter(
+      cnt, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+} // namespace
+
+namespace TuiRogGame {
+namespace Benchmark {
+
+struct BenchmarkInitializer {
+  BenchmarkInitializer() { spdlog::set_level(spdlog::level::off); }
+};
+static BenchmarkInitializer benchmark_initializer;
+
+// The engine wired the way the application wires it, minus the terminal and
+// the disk: in-memory persistence and hardcoded descriptions. A fixed seed
+// keeps the maps, and so the turns played, identical between runs.
+class HeadlessGame {
+public:
+  static constexpr std::uint64_t kSeed = 42;
+
+  explicit HeadlessGame(bool with_descriptions = true) {
+    std::unique_ptr<Port::Out::IGenerateDescriptionPort> descriptions;
+    if (with_descriptions) {
+      descriptions =
+          std::make_unique<Adapter::Out::Description::HardcodedDescAdapter>();
+    }
+    auto persistence =
+        std::make_shared<Adapter::Out::Persistence::InMemoryAdapter>();
+    engine_ = std::make_shared<Domain::Service::GameEngine>(
+        std::static_pointer_cast<Port::Out::ISaveGameStatePort>(persistence),
+        std::static_pointer_cast<Port::Out::ILoadGameStatePort>(persistence),
+        std::move(descriptions), nullptr, nullptr, kSeed);
+    adapter_ =
+        std::make_unique<Adapter::In::Headless::HeadlessAdapter>(engine_);
+    engine_->setRenderPort(adapter_.get());
+    adapter_->start();
+    engine_->waitForDescriptions();
+    adapter_->resetStats();
+  }
+
+  ~HeadlessGame() {
+    // Descriptions still in flight would otherwise reach a destroyed adapter.
+    engine_->waitForDescriptions();
+    engine_->setRenderPort(nullptr);
+  }
+
+  Domain::Service::GameEngine &getEngine() { return *engine_; }
+  Adapter::In::Headless::HeadlessAdapter &getAdapter() { return *adapter_; }
+
+private:
+  std::shared_ptr<Domain::Service::GameEngine> engine_;
+  std::unique_ptr<Adapter::In::Headless::HeadlessAdapter> adapter_;
+};
+
+void runTurns(benchmark::State &state,
+              const std::vector<Port::In::PlayerActionCommand> &commands,
+              bool with_descriptions = true) {
+  HeadlessGame game(with_descriptions);
+  auto &adapter = game.getAdapter();
+
+  const std::size_t start_allocations = allocation_count.load();
+  std::size_t next = 0;
+  for (auto _ : state) {
+    adapter.play(commands[next]);
+    next = (next + 1) % commands.size();
+  }
+  // Outside the timed loop, but the description allocations still count.
+  game.getEngine().waitForDescriptions();
+
+  const auto &stats = adapter.getStats();
+  state.counters["TurnsPerSec"] = stats.getTurnsPerSecond();
+  state.counters["P50ns"] =
+      static_cast<double>(stats.getPercentile(50).count());
+  state.counters["P99ns"] =
+      static_cast<double>(stats.getPercentile(99).count());
+  state.counters["AllocsPerTurn"] =
+      static_cast<double>(allocation_count.load() - start_allocations) /
+      static_cast<double>(state.iterations());
+  addCounters(state, state.iterations());
+}
+
+static void BM_GameEngine_RandomTurns(benchmark::State &state) {
+  runTurns(state, Adapter::In::Headless::generateRandomCommands(
+                      4096, static_cast<std::uint32_t>(state.range(0))));
+}
+BENCHMARK(BM_GameEngine_RandomTurns)->Arg(1)->Arg(42);
+
+// Walks back and forth; turns that hit a wall are still turns. The argument
+// switches the description port on (1) or off (0); without one, a turn's
+// allocations are down to the save path.
+static void BM_GameEngine_ScriptedTurns(benchmark::State &state) {
+  runTurns(state,
+           *Adapter::In::Headless::parseCommandScript("dddd ssss aaaa wwww xu"),
+           state.range(0) != 0);
+}
+BENCHMARK(BM_GameEngine_ScriptedTurns)->Arg(1)->Arg(0);
+
+// Scripted turns logging to a file. The first argument picks the sink: 0 is
+// the previous setup, a synchronous file sink flushed on every info message;
+// 1 is the current default, a background logger with a bounded queue flushed
+// on warnings. The second is the runtime level (1 = debug, 2 = info).
+static void BM_GameEngine_LoggedTurns(benchmark::State &state) {
+  auto previous_logger = spdlog::default_logger();
+  Common::LogOptions options;
+  options.file_path = "GameEngineBenchmark.log";
+  options.level = static_cast<spdlog::level::level_enum>(state.range(1));
+  if (state.range(0) == 0) {
+    options.flush_level = spdlog::level::info;
+    options.async_queue_size = 0;
+  }
+  Common::initLogging(options);
+
+  runTurns(state,
+           *Adapter::In::Headless::parseCommandScript("dddd ssss aaaa wwww xu"),
+           false);
+
+  spdlog::default_logger()->flush();
+  spdlog::set_default_logger(previous_logger);
+}
+BENCHMARK(BM_GameEngine_LoggedTurns)
+    ->Args({0, 1})
+    ->Args({1, 1})
+    ->Args({0, 2})
+    ->Args({1, 2});
+
+} // namespace Benchmark
+} // namespace TuiRogGame
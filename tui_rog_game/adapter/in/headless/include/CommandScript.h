@@ -0,0 +1,31 @@
+#pragma once
+
+#include "PlayerActionCommand.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace In {
+namespace Headless {
+
+// Command streams for driving the engine without a terminal.
+//
+// Scripts use the TUI's key bindings, one command per character:
+//   w/a/s/d move, x attacks, u uses a Health Potion, q quits.
+// Whitespace is ignored. Returns nullopt on any other character.
+std::optional<std::vector<Port::In::PlayerActionCommand>>
+parseCommandScript(const std::string &script);
+
+// A reproducible stream of gameplay commands (no INITIALIZE or QUIT), mostly
+// moves with occasional attacks and item uses.
+std::vector<Port::In::PlayerActionCommand>
+generateRandomCommands(std::size_t count, std::uint32_t seed);
+
+} // namespace Headless
+} // namespace In
+} // namespace Adapter
+} // namespace TuiRogGame
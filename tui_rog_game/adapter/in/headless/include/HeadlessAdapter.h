@@ -0,0 +1,68 @@
+#pragma once
+
+#include "EventBuffer.h"
+#include "GameStateDTO.h"
+#include "IGetPlayerActionUseCase.h"
+#include "IRenderPort.h"
+#include "PlayerActionCommand.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace In {
+namespace Headless {
+
+// Wall-clock time of each handlePlayerAction call, in play order.
+struct TurnStats {
+  std::vector<std::chrono::nanoseconds> latencies;
+  std::chrono::nanoseconds total{0};
+
+  std::size_t getTurnCount() const { return latencies.size(); }
+  double getTurnsPerSecond() const;
+  // Nearest-rank percentile, p in [0, 100]. Zero if no turns were played.
+  std::chrono::nanoseconds getPercentile(double p) const;
+};
+
+// Drives the engine without a terminal: feeds it commands and renders
+// nothing, only counting what it would have drawn. Used for throughput
+// measurements and scripted runs.
+class HeadlessAdapter : public Port::Out::IRenderPort {
+public:
+  explicit HeadlessAdapter(
+      std::shared_ptr<Port::In::IGetPlayerActionUseCase> game_engine);
+
+  // Sends INITIALIZE, which is not counted as a turn.
+  void start();
+  // Sends each command in order, recording its latency.
+  void play(const std::vector<Port::In::PlayerActionCommand> &commands);
+  void play(const Port::In::PlayerActionCommand &command);
+
+  const TurnStats &getStats() const { return stats_; }
+  void resetStats() { stats_ = TurnStats(); }
+
+  std::size_t getRenderCount() const { return render_count_; }
+  std::size_t getEventCount() const { return event_count_; }
+  std::size_t getDescriptionCount() const { return description_count_; }
+
+  void render(const Port::Out::GameStateDTO &game_state,
+              Domain::Event::EventSpan events) override;
+  void renderDescription(
+      const Domain::Event::DescriptionGeneratedEvent &description) override;
+
+private:
+  std::shared_ptr<Port::In::IGetPlayerActionUseCase> game_engine_;
+  TurnStats stats_;
+  std::size_t render_count_ = 0;
+  std::size_t event_count_ = 0;
+  // Descriptions arrive on a worker thread.
+  std::atomic<std::size_t> description_count_{0};
+};
+
+} // namespace Headless
+} // namespace In
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,79 @@
+#include "CommandScript.h"
+#include <cctype>
+#include <random>
+#include <spdlog/spdlog.h>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace In {
+namespace Headless {
+
+namespace {
+
+using Command = Port::In::PlayerActionCommand;
+
+const char *const kItemName = "Health Potion";
+
+std::optional<Command> commandForKey(char key) {
+  switch (key) {
+  case 'w':
+    return Command(Command::MOVE_UP);
+  case 's':
+    return Command(Command::MOVE_DOWN);
+  case 'a':
+    return Command(Command::MOVE_LEFT);
+  case 'd':
+    return Command(Command::MOVE_RIGHT);
+  case 'x':
+    // The engine uses the player's own attack power; the payload is unused.
+    return Command(Command::ATTACK, 0);
+  case 'u':
+    return Command(Command::USE_ITEM, std::string(kItemName));
+  case 'q':
+    return Command(Command::QUIT);
+  default:
+    return std::nullopt;
+  }
+}
+
+} // namespace
+
+std::optional<std::vector<Port::In::PlayerActionCommand>>
+parseCommandScript(const std::string &script) {
+  std::vector<Command> commands;
+  commands.reserve(script.size());
+  for (char key : script) {
+    if (std::isspace(static_cast<unsigned char>(key))) {
+      continue;
+    }
+    auto command = commandForKey(key);
+    if (!command) {
+      spdlog::error("CommandScript: Unknown command key '{}'.", key);
+      return std::nullopt;
+    }
+    commands.push_back(std::move(*command));
+  }
+  return commands;
+}
+
+std::vector<Port::In::PlayerActionCommand>
+generateRandomCommands(std::size_t count, std::uint32_t seed) {
+  // Weighted like real play: moves dominate, fights and potions are rarer.
+  static const char kKeys[] = {'w', 'a', 's', 'd', 'w', 'a', 's',
+                               'd', 'w', 'a', 's', 'd', 'x', 'x',
+                               'x', 'u'};
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<std::size_t> pick(0, sizeof(kKeys) - 1);
+
+  std::vector<Command> commands;
+  commands.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    commands.push_back(*commandForKey(kKeys[pick(gen)]));
+  }
+  return commands;
+}
+
+} // namespace Headless
+} // namespace In
+} // namespace Adapter
+} // namespace TuiRogGame
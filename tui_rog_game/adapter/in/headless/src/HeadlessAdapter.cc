@@ -0,0 +1,77 @@
+#include "HeadlessAdapter.h"
+#include "DescriptionGeneratedEvent.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace In {
+namespace Headless {
+
+double TurnStats::getTurnsPerSecond() const {
+  if (total.count() == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(latencies.size()) /
+         std::chrono::duration<double>(total).count();
+}
+
+std::chrono::nanoseconds TurnStats::getPercentile(double p) const {
+  if (latencies.empty()) {
+    return std::chrono::nanoseconds(0);
+  }
+  std::vector<std::chrono::nanoseconds> sorted = latencies;
+  std::sort(sorted.begin(), sorted.end());
+  const double clamped = std::min(100.0, std::max(0.0, p));
+  const std::size_t rank = static_cast<std::size_t>(
+      std::ceil(clamped / 100.0 * static_cast<double>(sorted.size())));
+  return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+HeadlessAdapter::HeadlessAdapter(
+    std::shared_ptr<Port::In::IGetPlayerActionUseCase> game_engine)
+    : game_engine_(std::move(game_engine)) {
+  spdlog::info("HeadlessAdapter initialized.");
+}
+
+void HeadlessAdapter::start() {
+  game_engine_->handlePlayerAction(
+      Port::In::PlayerActionCommand(Port::In::PlayerActionCommand::INITIALIZE));
+}
+
+void HeadlessAdapter::play(
+    const std::vector<Port::In::PlayerActionCommand> &commands) {
+  stats_.latencies.reserve(stats_.latencies.size() + commands.size());
+  for (const auto &command : commands) {
+    play(command);
+  }
+}
+
+void HeadlessAdapter::play(const Port::In::PlayerActionCommand &command) {
+  const auto start = std::chrono::steady_clock::now();
+  game_engine_->handlePlayerAction(command);
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  stats_.latencies.push_back(elapsed);
+  stats_.total += elapsed;
+}
+
+void HeadlessAdapter::render(const Port::Out::GameStateDTO &game_state,
+                             Domain::Event::EventSpan events) {
+  ++render_count_;
+  event_count_ += events.size();
+}
+
+void HeadlessAdapter::renderDescription(
+    const Domain::Event::DescriptionGeneratedEvent &description) {
+  if (description.isPartial()) {
+    return; // Only complete descriptions are counted.
+  }
+  description_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Headless
+} // namespace In
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,81 @@
+#include "CommandScript.h"
+#include "HeadlessAdapter.h"
+#include "IGetPlayerActionUseCase.h"
+#include "PlayerActionCommand.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::In::Headless;
+using namespace TuiRogGame::Port::In;
+
+namespace {
+
+class RecordingUseCase : public IGetPlayerActionUseCase {
+public:
+  void handlePlayerAction(const PlayerActionCommand &command) override {
+    types.push_back(command.type);
+  }
+  void toggleDescriptionPort() override {}
+
+  std::vector<PlayerActionCommand::ActionType> types;
+};
+
+} // namespace
+
+TEST(CommandScriptTest, ParsesTuiKeys) {
+  auto commands = parseCommandScript("wasd x\nuq");
+  ASSERT_TRUE(commands.has_value());
+  std::vector<PlayerActionCommand::ActionType> types;
+  for (const auto &command : *commands) {
+    types.push_back(command.type);
+  }
+  std::vector<PlayerActionCommand::ActionType> expected = {
+      PlayerActionCommand::MOVE_UP,   PlayerActionCommand::MOVE_LEFT,
+      PlayerActionCommand::MOVE_DOWN, PlayerActionCommand::MOVE_RIGHT,
+      PlayerActionCommand::ATTACK,    PlayerActionCommand::USE_ITEM,
+      PlayerActionCommand::QUIT};
+  ASSERT_EQ(types, expected);
+
+  ASSERT_FALSE(parseCommandScript("wz").has_value());
+}
+
+TEST(CommandScriptTest, RandomCommandsAreReproducible) {
+  auto first = generateRandomCommands(64, 7);
+  auto second = generateRandomCommands(64, 7);
+  ASSERT_EQ(first.size(), 64u);
+  for (std::size_t i = 0; i < first.size(); ++i) {
+    ASSERT_EQ(first[i].type, second[i].type);
+    ASSERT_NE(first[i].type, PlayerActionCommand::QUIT);
+  }
+}
+
+TEST(HeadlessAdapterTest, PlaysCommandsAndRecordsLatency) {
+  auto use_case = std::make_shared<RecordingUseCase>();
+  HeadlessAdapter adapter(use_case);
+
+  adapter.start();
+  adapter.play(*parseCommandScript("wwx"));
+
+  ASSERT_EQ(use_case->types.size(), 4u);
+  ASSERT_EQ(use_case->types.front(), PlayerActionCommand::INITIALIZE);
+  ASSERT_EQ(adapter.getStats().getTurnCount(), 3u);
+  ASSERT_LE(adapter.getStats().getPercentile(50),
+            adapter.getStats().getPercentile(99));
+  ASSERT_EQ(adapter.getStats().getPercentile(100),
+            *std::max_element(adapter.getStats().latencies.begin(),
+                              adapter.getStats().latencies.end()));
+}
+
+TEST(TurnStatsTest, NearestRankPercentile) {
+  TurnStats stats;
+  for (int i = 1; i <= 100; ++i) {
+    stats.latencies.push_back(std::chrono::nanoseconds(i));
+  }
+  ASSERT_EQ(stats.getPercentile(50).count(), 50);
+  ASSERT_EQ(stats.getPercentile(99).count(), 99);
+  ASSERT_EQ(stats.getPercentile(0).count(), 1);
+  ASSERT_EQ(TurnStats().getPercentile(50).count(), 0);
+}
@@ -0,0 +1,86 @@
+#include "CommandScript.h"
+#include "GameEngine.h"
+#include "GameServer.h"
+#include "ILoadGameStatePort.h"
+#include "ISaveGameStatePort.h"
+#include "InMemoryAdapter.h"
+#include "PlayerActionCommand.h"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+namespace {
+void addCounters(benchmark::State &state, uint64_t cnt) {
+  state.counters["OPS"] = benchmark::Counter(cnt, benchmark::Counter::kIsRate);
+  state.counters["Latency"] = benchmark::Counter(
+      cnt, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+} // namespace
+
+namespace TuiRogGame {
+namespace Benchmark {
+
+struct BenchmarkInitializer {
+  BenchmarkInitializer() { spdlog::set_level(spdlog::level::off); }
+};
+static BenchmarkInitializer benchmark_initializer;
+
+constexpr std::uint64_t kSeed = 42;
+constexpr std::size_t kTurnsPerSession = 64;
+
+// Sessions backed by in-memory persistence and without descriptions, so the
+// benchmark measures turn handling and scheduling only.
+std::shared_ptr<Port::In::IGetPlayerActionUseCase>
+makeSession(const std::string &) {
+  auto persistence =
+      std::make_shared<Adapter::Out::Persistence::InMemoryAdapter>();
+  return std::make_shared<Domain::Service::GameEngine>(
+      std::static_pointer_cast<Port::Out::ISaveGameStatePort>(persistence),
+      std::static_pointer_cast<Port::Out::ILoadGameStatePort>(persistence),
+      nullptr, nullptr, nullptr, kSeed);
+}
+
+// Every session plays kTurnsPerSession random commands, submitted round-robin
+// the way independent clients would send them.
+// Args: session count, worker count.
+static void BM_GameServer_Sessions(benchmark::State &state) {
+  const auto session_count = static_cast<std::size_t>(state.range(0));
+  const auto worker_count = static_cast<std::size_t>(state.range(1));
+
+  Adapter::In::Server::GameServer server(makeSession, worker_count);
+  std::vector<std::string> session_ids;
+  std::vector<std::vector<Port::In::PlayerActionCommand>> scripts;
+  for (std::size_t i = 0; i < session_count; ++i) {
+    session_ids.push_back("session" + std::to_string(i));
+    scripts.push_back(Adapter::In::Headless::generateRandomCommands(
+        kTurnsPerSession, static_cast<std::uint32_t>(i)));
+    server.openSession(session_ids.back());
+  }
+  server.waitIdle();
+
+  uint64_t cnt = 0;
+  for (auto _ : state) {
+    for (std::size_t turn = 0; turn < kTurnsPerSession; ++turn) {
+      for (std::size_t i = 0; i < session_count; ++i) {
+        server.submit(session_ids[i], scripts[i][turn]);
+      }
+    }
+    server.waitIdle();
+    cnt += session_count * kTurnsPerSession;
+  }
+  addCounters(state, cnt);
+  state.counters["ActionsPerSec"] =
+      benchmark::Counter(cnt, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GameServer_Sessions)
+    ->ArgsProduct({{1, 64, 1024, 4096}, {1, 2, 4, 8}})
+    ->ArgNames({"sessions", "workers"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace Benchmark
+} // namespace TuiRogGame
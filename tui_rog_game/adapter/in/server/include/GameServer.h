@@ -0,0 +1,74 @@
+#pragma once
+
+#include "IGetPlayerActionUseCase.h"
+#include "PlayerActionCommand.h"
+#include "Strand.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace In {
+namespace Server {
+
+// Hosts many independent game sessions without a terminal. Each session has
+// its own use case (engine) created by the factory; actions are handled on a
+// shared worker pool, one at a time and in submission order per session.
+class GameServer {
+public:
+  using SessionFactory =
+      std::function<std::shared_ptr<Port::In::IGetPlayerActionUseCase>(
+          const std::string &session_id)>;
+
+  GameServer(SessionFactory session_factory, std::size_t worker_count);
+  // Finishes every action already submitted.
+  ~GameServer();
+
+  GameServer(const GameServer &) = delete;
+  GameServer &operator=(const GameServer &) = delete;
+
+  // Creates the session and queues its INITIALIZE. Returns false if the id is
+  // already in use or the factory returned nothing.
+  bool openSession(const std::string &session_id);
+  // Queues QUIT and forgets the session; its queued actions still run.
+  bool closeSession(const std::string &session_id);
+  // Returns false for an unknown session.
+  bool submit(const std::string &session_id,
+              const Port::In::PlayerActionCommand &command);
+  // Blocks until every submitted action has been handled.
+  void waitIdle();
+
+  std::size_t getSessionCount() const;
+  std::size_t getWorkerCount() const { return pool_.getWorkerCount(); }
+  std::uint64_t getHandledActionCount() const { return handled_actions_; }
+
+private:
+  struct Session {
+    std::shared_ptr<Port::In::IGetPlayerActionUseCase> use_case;
+    std::shared_ptr<Common::Strand> strand;
+  };
+
+  std::shared_ptr<Session> findSession(const std::string &session_id) const;
+  void post(const std::shared_ptr<Session> &session,
+            const Port::In::PlayerActionCommand &command);
+
+  SessionFactory session_factory_;
+  // Declared before the sessions so that it is destroyed after them: the
+  // strands submit to it.
+  Common::ThreadPool pool_;
+  mutable std::shared_mutex sessions_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Session>> sessions_;
+  std::atomic<std::uint64_t> handled_actions_{0};
+};
+
+} // namespace Server
+} // namespace In
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,101 @@
+#include "GameServer.h"
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace In {
+namespace Server {
+
+GameServer::GameServer(SessionFactory session_factory,
+                       std::size_t worker_count)
+    : session_factory_(std::move(session_factory)), pool_(worker_count) {
+  spdlog::info("GameServer initialized with {} worker(s).",
+               pool_.getWorkerCount());
+}
+
+GameServer::~GameServer() { waitIdle(); }
+
+bool GameServer::openSession(const std::string &session_id) {
+  if (findSession(session_id)) {
+    spdlog::warn("GameServer: Session '{}' is already open.", session_id);
+    return false;
+  }
+  // Building an engine may hit the disk; keep it outside the lock.
+  auto use_case = session_factory_(session_id);
+  if (!use_case) {
+    spdlog::error("GameServer: Could not create session '{}'.", session_id);
+    return false;
+  }
+  auto session = std::make_shared<Session>(
+      Session{std::move(use_case), std::make_shared<Common::Strand>(pool_)});
+  {
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+    if (!sessions_.emplace(session_id, session).second) {
+      spdlog::warn("GameServer: Session '{}' is already open.", session_id);
+      return false;
+    }
+  }
+  post(session, Port::In::PlayerActionCommand(
+                    Port::In::PlayerActionCommand::INITIALIZE));
+  spdlog::info("GameServer: Opened session '{}'.", session_id);
+  return true;
+}
+
+bool GameServer::closeSession(const std::string &session_id) {
+  std::shared_ptr<Session> session;
+  {
+    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+    auto it = sessions_.find(session_id);
+    if (it == sessions_.end()) {
+      return false;
+    }
+    session = std::move(it->second);
+    sessions_.erase(it);
+  }
+  post(session,
+       Port::In::PlayerActionCommand(Port::In::PlayerActionCommand::QUIT));
+  spdlog::info("GameServer: Closed session '{}'.", session_id);
+  return true;
+}
+
+bool GameServer::submit(const std::string &session_id,
+                        const Port::In::PlayerActionCommand &command) {
+  auto session = findSession(session_id);
+  if (!session) {
+    spdlog::warn("GameServer: Action for unknown session '{}'.", session_id);
+    return false;
+  }
+  post(session, command);
+  return true;
+}
+
+void GameServer::waitIdle() { pool_.waitIdle(); }
+
+std::size_t GameServer::getSessionCount() const {
+  std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+  return sessions_.size();
+}
+
+std::shared_ptr<GameServer::Session>
+GameServer::findSession(const std::string &session_id) const {
+  std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
+  auto it = sessions_.find(session_id);
+  return it == sessions_.end() ? nullptr : it->second;
+}
+
+void GameServer::post(const std::shared_ptr<Session> &session,
+                      const Port::In::PlayerActionCommand &command) {
+  // The task keeps the session alive, so a closed session still finishes
+  // the actions queued before it was closed.
+  session->strand->post([this, session, command] {
+    session->use_case->handlePlayerAction(command);
+    handled_actions_.fetch_add(1, std::memory_order_relaxed);
+  });
+}
+
+} // namespace Server
+} // namespace In
+} // namespace Adapter
+} // namespace TuiRogGame
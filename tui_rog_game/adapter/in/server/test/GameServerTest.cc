@@ -0,0 +1,104 @@
+#include "GameServer.h"
+#include "IGetPlayerActionUseCase.h"
+#include "PlayerActionCommand.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::In::Server;
+using namespace TuiRogGame::Port::In;
+
+namespace {
+
+// Records the actions of one session and fails on overlapping calls.
+class RecordingUseCase : public IGetPlayerActionUseCase {
+public:
+  void handlePlayerAction(const PlayerActionCommand &command) override {
+    if (in_call_.exchange(true)) {
+      overlapped_ = true;
+    }
+    // Widen the window for overlapping calls to show up.
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    types.push_back(command.type);
+    in_call_ = false;
+  }
+  void toggleDescriptionPort() override {}
+
+  std::vector<PlayerActionCommand::ActionType> types;
+  std::atomic<bool> overlapped_{false};
+
+private:
+  std::atomic<bool> in_call_{false};
+};
+
+class GameServerTest : public ::testing::Test {
+protected:
+  GameServer::SessionFactory factory() {
+    return [this](const std::string &session_id) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto use_case = std::make_shared<RecordingUseCase>();
+      use_cases_[session_id] = use_case;
+      return use_case;
+    };
+  }
+
+  std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<RecordingUseCase>> use_cases_;
+};
+
+} // namespace
+
+TEST_F(GameServerTest, SerializesActionsPerSession) {
+  GameServer server(factory(), 4);
+  const std::vector<std::string> ids = {"a", "b", "c"};
+  for (const auto &id : ids) {
+    ASSERT_TRUE(server.openSession(id));
+  }
+  ASSERT_FALSE(server.openSession("a"));
+
+  for (int i = 0; i < 50; ++i) {
+    const auto type = i % 2 == 0 ? PlayerActionCommand::MOVE_UP
+                                 : PlayerActionCommand::MOVE_DOWN;
+    for (const auto &id : ids) {
+      ASSERT_TRUE(server.submit(id, PlayerActionCommand(type)));
+    }
+  }
+  server.waitIdle();
+
+  EXPECT_EQ(server.getSessionCount(), 3u);
+  EXPECT_EQ(server.getHandledActionCount(), 3u * 51u);
+  for (const auto &id : ids) {
+    const auto &use_case = *use_cases_[id];
+    EXPECT_FALSE(use_case.overlapped_);
+    ASSERT_EQ(use_case.types.size(), 51u);
+    EXPECT_EQ(use_case.types.front(), PlayerActionCommand::INITIALIZE);
+    for (std::size_t i = 1; i < use_case.types.size(); ++i) {
+      EXPECT_EQ(use_case.types[i], i % 2 == 1 ? PlayerActionCommand::MOVE_UP
+                                              : PlayerActionCommand::MOVE_DOWN);
+    }
+  }
+}
+
+TEST_F(GameServerTest, ClosedSessionFinishesQueuedActions) {
+  GameServer server(factory(), 2);
+  const PlayerActionCommand move_left(PlayerActionCommand::MOVE_LEFT);
+  ASSERT_TRUE(server.openSession("a"));
+  ASSERT_TRUE(server.submit("a", move_left));
+  ASSERT_TRUE(server.closeSession("a"));
+
+  EXPECT_FALSE(server.submit("a", move_left));
+  EXPECT_FALSE(server.closeSession("a"));
+  server.waitIdle();
+
+  std::vector<PlayerActionCommand::ActionType> expected = {
+      PlayerActionCommand::INITIALIZE, PlayerActionCommand::MOVE_LEFT,
+      PlayerActionCommand::QUIT};
+  EXPECT_EQ(use_cases_["a"]->types, expected);
+  EXPECT_EQ(server.getSessionCount(), 0u);
+}
@@ -1,12 +1,15 @@
 #pragma once
 
-#include "DomainEvent.h"
+#include "EventBuffer.h"
 #include "GameStateDTO.h"
 #include "IGetPlayerActionUseCase.h"
 #include "IRenderPort.h"
+#include <cstddef>
+#include <cstdint>
 #include <ftxui/component/screen_interactive.hpp>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 
 namespace TuiRogGame {
 namespace Adapter {
@@ -21,14 +24,20 @@ public:
 
   void run();
   void render(const Port::Out::GameStateDTO &game_state,
-              const std::vector<std::unique_ptr<Domain::Event::DomainEvent>>
-                  &events) override;
+              Domain::Event::EventSpan events) override;
+  void renderDescription(
+      const Domain::Event::DescriptionGeneratedEvent &description) override;
 
 private:
   std::shared_ptr<Port::In::IGetPlayerActionUseCase> game_engine_;
   ftxui::ScreenInteractive &screen_;
   std::shared_ptr<std::optional<Port::Out::GameStateDTO>> game_state_ptr_;
   std::vector<std::string> message_log_;
+  std::uint64_t last_description_sequence_id_ = 0;
+  // message_log_ lines of the descriptions still streaming in, by sequence
+  // id. Their final text replaces the streamed one.
+  std::unordered_map<std::uint64_t, std::size_t> streaming_lines_;
+  std::uint64_t streaming_turn_id_ = 0;
   bool show_start_screen_ = true;
 };
 
@@ -1,15 +1,7 @@
 #include "TuiAdapter.h"
-#include "CombatStartedEvent.h"
-#include "DescriptionGeneratedEvent.h"
-#include "EnemyAttackedEvent.h"
-#include "EnemyDefeatedEvent.h"
-#include "ItemFoundEvent.h"
-#include "ItemUsedEvent.h"
+#include "EventVisitor.h"
 #include "Map.h"
 #include "Player.h"
-#include "PlayerAttackedEvent.h"
-#include "PlayerLeveledUpEvent.h"
-#include "PlayerMovedEvent.h"
 #include <algorithm>
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/event.hpp>
@@ -86,15 +78,17 @@ void TuiAdapter::run() {
         [&](const Domain::Model::Map &current_map,
             const Domain::Model::Player &current_player) {
           std::vector<Element> rows_elements;
-          for (int y = 0; y < current_map.getHeight(); ++y) {
+          const auto tiles = current_map.getTiles();
+          for (int y = 0; y < tiles.getHeight(); ++y) {
+            const Domain::Model::Tile *row = tiles.row(y);
             Elements row_chars;
-            for (int x = 0; x < current_map.getWidth(); ++x) {
+            for (int x = 0; x < tiles.getWidth(); ++x) {
               if (current_player.getPosition().x == x &&
                   current_player.getPosition().y == y) {
                 row_chars.push_back(text("@") | color(Color::Blue) |
                                     ftxui::blink);
               } else {
-                row_chars.push_back(TileToElement(current_map.getTile(x, y)));
+                row_chars.push_back(TileToElement(row[x]));
               }
             }
             rows_elements.push_back(hbox(row_chars));
@@ -315,6 +309,9 @@ void TuiAdapter::run() {
         message_log_.push_back("Description model toggled.");
         return true; // Event handled, no further action needed for game_engine_
       case 'q':
+        // Let the engine end the turn so pending descriptions become stale.
+        game_engine_->handlePlayerAction(
+            Port::In::PlayerActionCommand(Port::In::PlayerActionCommand::QUIT));
         screen_.Exit();
         return true;
       default:
@@ -333,9 +330,8 @@ void TuiAdapter::run() {
   spdlog::info("TuiAdapter::run() exited.");
 }
 
-void TuiAdapter::render(
-    const Port::Out::GameStateDTO &game_state,
-    const std::vector<std::unique_ptr<Domain::Event::DomainEvent>> &events) {
+void TuiAdapter::render(const Port::Out::GameStateDTO &game_state,
+                        Domain::Event::EventSpan events) {
   bool state_changed = false;
 
   if (!game_state_ptr_->has_value() ||
@@ -349,76 +345,36 @@ void TuiAdapter::render(
 
   game_state_ptr_->emplace(game_state);
 
+  using namespace Domain::Event;
+  auto log_event = Overloaded{
+      [this](const CombatStartedEvent &e) {
+        message_log_.push_back("You encountered a " + e.getEnemyName() + "!");
+      },
+      [this](const ItemFoundEvent &e) {
+        message_log_.push_back("You found a " + e.getItemName() + "!");
+      },
+      [this](const PlayerAttackedEvent &e) {
+        message_log_.push_back(e.toString());
+      },
+      [this](const EnemyAttackedEvent &e) {
+        message_log_.push_back(e.toString());
+      },
+      [this](const EnemyDefeatedEvent &e) {
+        message_log_.push_back(e.toString());
+      },
+      [this](const PlayerLeveledUpEvent &e) {
+        message_log_.push_back(e.toString());
+      },
+      [this](const ItemUsedEvent &e) {
+        message_log_.push_back("You used a " + e.getItemName() + "!");
+      },
+      [this](const DescriptionGeneratedEvent &e) {
+        message_log_.push_back(e.getDescription());
+      },
+      [](const DomainEvent &) {}};
+
   for (const auto &event : events) {
-    if (event->getType() == Domain::Event::DomainEvent::Type::CombatStarted) {
-      const auto *combat_event =
-          dynamic_cast<const Domain::Event::CombatStartedEvent *>(event.get());
-      if (combat_event) {
-        message_log_.push_back("You encountered a " +
-                               combat_event->getEnemyName() + "!");
-      }
-    } else if (event->getType() ==
-               Domain::Event::DomainEvent::Type::ItemFound) {
-      const auto *item_event =
-          dynamic_cast<const Domain::Event::ItemFoundEvent *>(event.get());
-      if (item_event) {
-        message_log_.push_back("You found a " + item_event->getItemName() +
-                               "!");
-      }
-    } else if (event->getType() ==
-               Domain::Event::DomainEvent::Type::PlayerAttacked) {
-      const auto *player_attacked_event =
-          dynamic_cast<const Domain::Event::PlayerAttackedEvent *>(event.get());
-      if (player_attacked_event) {
-        message_log_.push_back(player_attacked_event->toString());
-      }
-    } else if (event->getType() ==
-               Domain::Event::DomainEvent::Type::EnemyAttacked) {
-      const auto *enemy_attacked_event =
-          dynamic_cast<const Domain::Event::EnemyAttackedEvent *>(event.get());
-      if (enemy_attacked_event) {
-        message_log_.push_back(enemy_attacked_event->toString());
-      }
-    } else if (event->getType() ==
-               Domain::Event::DomainEvent::Type::EnemyDefeated) {
-      const auto *enemy_defeated_event =
-          dynamic_cast<const Domain::Event::EnemyDefeatedEvent *>(event.get());
-      if (enemy_defeated_event) {
-        message_log_.push_back(enemy_defeated_event->toString());
-      }
-    } else if (event->getType() ==
-               Domain::Event::DomainEvent::Type::PlayerLeveledUp) {
-      const auto *player_leveled_up_event =
-          dynamic_cast<const Domain::Event::PlayerLeveledUpEvent *>(
-              event.get());
-      if (player_leveled_up_event) {
-        message_log_.push_back(player_leveled_up_event->toString());
-      }
-    } else if (event->getType() == Domain::Event::DomainEvent::Type::ItemUsed) {
-      spdlog::info("TuiAdapter: Received ItemUsedEvent. Type: {}",
-                   static_cast<int>(event->getType()));
-      const auto *item_used_event =
-          dynamic_cast<const Domain::Event::ItemUsedEvent *>(event.get());
-      if (item_used_event) {
-        spdlog::info("TuiAdapter: dynamic_cast to ItemUsedEvent successful. "
-                     "Item name: {}",
-                     item_used_event->getItemName());
-        message_log_.push_back("You used a " + item_used_event->getItemName() +
-                               "!");
-      } else {
-        spdlog::warn("TuiAdapter: dynamic_cast to ItemUsedEvent failed for "
-                     "event type {}.",
-                     static_cast<int>(event->getType()));
-      }
-    } else if (event->getType() ==
-               Domain::Event::DomainEvent::Type::DescriptionGenerated) {
-      const auto *description_generated_event =
-          dynamic_cast<const Domain::Event::DescriptionGeneratedEvent *>(
-              event.get());
-      if (description_generated_event) {
-        message_log_.push_back(description_generated_event->getDescription());
-      }
-    }
+    visit(*event, log_event);
     state_changed = true; // 이벤트가 있으면 무조건 업데이트
   }
 
@@ -427,6 +383,45 @@ void TuiAdapter::render(
   }
 }
 
+void TuiAdapter::renderDescription(
+    const Domain::Event::DescriptionGeneratedEvent &description) {
+  // Called from the engine's description worker; message_log_ belongs to the
+  // UI thread, so the update is posted to the screen loop.
+  screen_.Post([this, text = description.getDescription(),
+                turn_id = description.getTurnId(),
+                sequence_id = description.getSequenceId(),
+                partial = description.isPartial()] {
+    if (turn_id != streaming_turn_id_) {
+      // Descriptions of an earlier turn that never finished stay as streamed.
+      streaming_lines_.clear();
+      streaming_turn_id_ = turn_id;
+    }
+    auto streaming = streaming_lines_.find(sequence_id);
+    if (streaming != streaming_lines_.end()) {
+      std::string &line = message_log_[streaming->second];
+      if (partial) {
+        line += text;
+      } else {
+        line = text;
+        streaming_lines_.erase(streaming);
+      }
+      return;
+    }
+
+    if (sequence_id < last_description_sequence_id_) {
+      spdlog::debug("TuiAdapter: Dropping out-of-order description {}.",
+                    sequence_id);
+      return;
+    }
+    last_description_sequence_id_ = sequence_id;
+    message_log_.push_back(text);
+    if (partial) {
+      streaming_lines_.emplace(sequence_id, message_log_.size() - 1);
+    }
+  });
+  screen_.PostEvent(ftxui::Event::Custom);
+}
+
 } // namespace Tui
 } // namespace In
 } // namespace Adapter
@@ -0,0 +1,302 @@
+#include "DescriptionGeneratedEvent.h"
+#include "GameEngine.h"
+#include "GameStateDTO.h"
+#include "IRenderPort.h"
+#include "InMemoryAdapter.h"
+#include "Item.h"
+#include "LlmAdapter.h"
+#include "LlmPrompt.h"
+#include "Map.h"
+#include "MockLlmServer.h"
+#include "Player.h"
+#include "PlayerActionCommand.h"
+#include "PlayerMovedEvent.h"
+#include "Rng.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+void addCounters(benchmark::State &state, uint64_t cnt) {
+  state.counters["OPS"] = benchmark::Counter(cnt, benchmark::Counter::kIsRate);
+  state.counters["Latency"] = benchmark::Counter(
+      cnt, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+} // namespace
+
+namespace TuiRogGame {
+namespace Benchmark {
+
+struct BenchmarkInitializer {
+  BenchmarkInitializer() {
+    spdlog::set_level(spdlog::level::off);
+    // The mock server accepts any key.
+    setenv("GROQ_API_KEY", "bench-key", 0);
+  }
+};
+static BenchmarkInitializer benchmark_initializer;
+
+Port::Out::GameStateDTO createGameState() {
+  Domain::Model::Map map(20, 10);
+  Domain::Model::Rng rng(7);
+  map.generate(rng);
+  Domain::Model::Player player("player1", Domain::Model::Stats{},
+                               map.getStartPlayerPosition());
+  for (int i = 0; i < 4; ++i) {
+    player.addItem(std::make_unique<Domain::Model::Item>(
+        Domain::Model::Item::ItemType::HealthPotion, "Small Health Potion"));
+  }
+  return Port::Out::GameStateDTO(std::move(map), std::move(player));
+}
+
+Adapter::Out::Description::LlmAdapter::Options
+mockOptions(const Adapter::Out::Description::MockLlmServer &server) {
+  Adapter::Out::Description::LlmAdapter::Options options;
+  options.base_url = server.getBaseUrl();
+  options.cache.capacity = 0; // Every description is a request.
+  return options;
+}
+
+// What a request costs before it leaves the process: gathering the prompt
+// inputs, hashing the cache key, and building and serializing the body for
+// a turn with that many events.
+static void BM_LlmPrompt_BuildRequest(benchmark::State &state) {
+  const Port::Out::GameStateDTO game_state = createGameState();
+  std::vector<Domain::Event::PlayerMovedEvent> events;
+  for (int i = 0; i < state.range(0); ++i) {
+    events.emplace_back(Domain::Model::Position{i, 0});
+  }
+
+  std::size_t body_bytes = 0;
+  for (auto _ : state) {
+    std::vector<Adapter::Out::Description::LlmPrompt::PromptInputs> inputs;
+    std::vector<const Adapter::Out::Description::LlmPrompt::PromptInputs *>
+        batch;
+    inputs.reserve(events.size());
+    for (const auto &event : events) {
+      inputs.push_back(Adapter::Out::Description::LlmPrompt::
+                           collectPromptInputs(game_state, event));
+      benchmark::DoNotOptimize(
+          Adapter::Out::Description::LlmPrompt::promptKey(inputs.back()));
+      batch.push_back(&inputs.back());
+    }
+    const std::string body =
+        Adapter::Out::Description::LlmPrompt::buildRequestBody(batch, false);
+    body_bytes += body.size();
+    benchmark::DoNotOptimize(body);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(body_bytes));
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_LlmPrompt_BuildRequest)->ArgName("events")->Arg(1)->Arg(3);
+
+// One description per iteration from a mock server that answers at once, so
+// the time is the adapter and the HTTP round trip. The argument keeps one
+// connection alive (1) or opens one per request (0).
+static void BM_LlmAdapter_Request(benchmark::State &state) {
+  Adapter::Out::Description::MockLlmServer server;
+  auto options = mockOptions(server);
+  options.pool.keep_alive = state.range(0) != 0;
+  Adapter::Out::Description::LlmAdapter adapter(options);
+
+  const Port::Out::GameStateDTO game_state = createGameState();
+  const Domain::Event::PlayerMovedEvent event(
+      game_state.player.getPosition());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(adapter.generateDescription(game_state, event));
+  }
+
+  const auto stats = server.getStats();
+  state.counters["Connections"] = static_cast<double>(stats.connections);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_LlmAdapter_Request)->ArgName("keep_alive")->Arg(1)->Arg(0);
+
+void addRequestCounters(benchmark::State &state,
+                        const Adapter::Out::Description::LlmAdapter &adapter) {
+  const auto stats = adapter.getRequestStats();
+  const auto millis = [](std::chrono::microseconds latency) {
+    return std::chrono::duration<double, std::milli>(latency).count();
+  };
+  state.counters["P50Ms"] = millis(stats.p50);
+  state.counters["P99Ms"] = millis(stats.p99);
+  state.counters["Hedged"] = static_cast<double>(stats.hedged);
+  state.counters["PoolUtilization"] = stats.pool.utilization;
+  state.counters["PoolWaits"] = static_cast<double>(stats.pool.waits);
+}
+
+// Eight descriptions requested at once from eight threads, as by several
+// sessions, against a server taking 10 ms each. The argument is the size of
+// the connection pool they share.
+static void BM_LlmAdapter_ConcurrentRequests(benchmark::State &state) {
+  Adapter::Out::Description::MockLlmServerOptions server_options;
+  server_options.latency = std::chrono::milliseconds(10);
+  Adapter::Out::Description::MockLlmServer server(server_options);
+  auto options = mockOptions(server);
+  options.pool.size = static_cast<std::size_t>(state.range(0));
+  Adapter::Out::Description::LlmAdapter adapter(options);
+
+  const Port::Out::GameStateDTO game_state = createGameState();
+  const Domain::Event::PlayerMovedEvent event(
+      game_state.player.getPosition());
+  constexpr int kConcurrentRequests = 8;
+  for (auto _ : state) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kConcurrentRequests; ++i) {
+      threads.emplace_back([&adapter, &game_state, &event] {
+        benchmark::DoNotOptimize(
+            adapter.generateDescription(game_state, event));
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  addRequestCounters(state, adapter);
+  addCounters(state, state.iterations() * kConcurrentRequests);
+}
+BENCHMARK(BM_LlmAdapter_ConcurrentRequests)
+    ->ArgName("pool")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Sequential descriptions from a server answering in 2-3 ms, except that
+// one request in 25 hangs for 50 ms. The argument hedges slow requests
+// (1) or waits them out (0); compare P99Ms.
+static void BM_LlmAdapter_Hedging(benchmark::State &state) {
+  Adapter::Out::Description::MockLlmServerOptions server_options;
+  server_options.latency = std::chrono::milliseconds(2);
+  server_options.jitter = std::chrono::milliseconds(1);
+  Adapter::Out::Description::MockLlmServer server(server_options);
+  auto options = mockOptions(server);
+  options.hedge = state.range(0) != 0;
+  Adapter::Out::Description::LlmAdapter adapter(options);
+
+  const Port::Out::GameStateDTO game_state = createGameState();
+  const Domain::Event::PlayerMovedEvent event(
+      game_state.player.getPosition());
+  std::size_t request = 0;
+  for (auto _ : state) {
+    if (++request % 25 == 0) {
+      auto stalling = server_options;
+      stalling.stall_next = 1;
+      stalling.stall = std::chrono::milliseconds(50);
+      server.setOptions(stalling);
+    }
+    benchmark::DoNotOptimize(adapter.generateDescription(game_state, event));
+  }
+
+  addRequestCounters(state, adapter);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_LlmAdapter_Hedging)
+    ->ArgName("hedge")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Notes when the first description text of a turn reaches the render port.
+class FirstTextRenderPort : public Port::Out::IRenderPort {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  void render(const Port::Out::GameStateDTO &game_state,
+              Domain::Event::EventSpan events) override {}
+
+  void renderDescription(
+      const Domain::Event::DescriptionGeneratedEvent &description) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!first_text_) {
+      first_text_ = Clock::now();
+    }
+  }
+
+  std::optional<Clock::time_point> takeFirstText() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::exchange(first_text_, std::nullopt);
+  }
+
+private:
+  std::mutex mutex_;
+  std::optional<Clock::time_point> first_text_;
+};
+
+// A turn from the player's key press until every description of it has been
+// delivered, with the engine describing through LlmAdapter and a mock server
+// that takes 20-30 ms to answer and 3 ms per streamed chunk. The argument
+// streams (1) or waits for whole completions (0); FirstTextMs is how long
+// the player waits to see the first words.
+static void BM_GameEngine_DescribedTurn(benchmark::State &state) {
+  Adapter::Out::Description::MockLlmServerOptions server_options;
+  server_options.latency = std::chrono::milliseconds(20);
+  server_options.jitter = std::chrono::milliseconds(10);
+  server_options.chunk_interval = std::chrono::milliseconds(3);
+  Adapter::Out::Description::MockLlmServer server(server_options);
+
+  auto llm_options = mockOptions(server);
+  llm_options.stream = state.range(0) != 0;
+  auto persistence =
+      std::make_shared<Adapter::Out::Persistence::InMemoryAdapter>();
+  Domain::Service::GameEngine engine(
+      persistence, persistence,
+      std::make_unique<Adapter::Out::Description::LlmAdapter>(llm_options),
+      nullptr, nullptr, 42);
+  FirstTextRenderPort render_port;
+  engine.setRenderPort(&render_port);
+  engine.handlePlayerAction(
+      Port::In::PlayerActionCommand(Port::In::PlayerActionCommand::INITIALIZE));
+  engine.waitForDescriptions();
+  render_port.takeFirstText();
+
+  const std::vector<Port::In::PlayerActionCommand::ActionType> moves = {
+      Port::In::PlayerActionCommand::MOVE_RIGHT,
+      Port::In::PlayerActionCommand::MOVE_DOWN,
+      Port::In::PlayerActionCommand::MOVE_LEFT,
+      Port::In::PlayerActionCommand::MOVE_UP};
+  std::size_t next = 0;
+  std::chrono::nanoseconds first_text_total{0};
+  std::size_t described_turns = 0;
+  for (auto _ : state) {
+    const auto start = FirstTextRenderPort::Clock::now();
+    engine.handlePlayerAction(Port::In::PlayerActionCommand(moves[next]));
+    engine.waitForDescriptions();
+    next = (next + 1) % moves.size();
+    if (auto first_text = render_port.takeFirstText()) {
+      first_text_total += *first_text - start;
+      ++described_turns;
+    }
+  }
+  engine.setRenderPort(nullptr);
+
+  state.counters["DescribedTurns"] = static_cast<double>(described_turns);
+  state.counters["FirstTextMs"] =
+      described_turns == 0
+          ? 0.0
+          : std::chrono::duration<double, std::milli>(first_text_total)
+                    .count() /
+                static_cast<double>(described_turns);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_GameEngine_DescribedTurn)
+    ->ArgName("stream")
+    ->Arg(0)
+    ->Arg(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace Benchmark
+} // namespace TuiRogGame
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+
+struct DescriptionCacheOptions {
+  // Entries kept; the least recently used one is evicted beyond this. 0
+  // disables the cache, including persistence.
+  std::size_t capacity = 256;
+  // Entries older than this are treated as missing.
+  std::chrono::seconds ttl{600};
+  // If set, entries are loaded from this file on construction and written
+  // back by flush() and on destruction, so they survive restarts.
+  std::string persist_path;
+};
+
+// Bounded LRU cache of generated descriptions, keyed by a hash of everything
+// that went into the prompt. Each entry remembers how long the request that
+// produced it took, so hits can report the latency they saved. Thread-safe.
+class DescriptionCache {
+public:
+  using Clock = std::chrono::system_clock;
+
+  struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0; // Including expired entries.
+    std::uint64_t expirations = 0;
+    std::uint64_t evictions = 0;
+    std::chrono::microseconds saved_latency{0};
+
+    double hitRate() const {
+      const std::uint64_t lookups = hits + misses;
+      return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+    }
+  };
+
+  explicit DescriptionCache(DescriptionCacheOptions options);
+  ~DescriptionCache();
+
+  DescriptionCache(const DescriptionCache &) = delete;
+  DescriptionCache &operator=(const DescriptionCache &) = delete;
+
+  std::optional<std::string> get(std::uint64_t key);
+  // latency is what producing the description cost, credited on every hit.
+  void put(std::uint64_t key, std::string description,
+           std::chrono::microseconds latency);
+
+  // Writes the live entries to persist_path; false if it could not be
+  // written. Does nothing without a persist_path.
+  bool flush() const;
+
+  std::size_t size() const;
+  Stats getStats() const;
+
+private:
+  struct Entry {
+    std::uint64_t key;
+    std::string description;
+    std::chrono::microseconds latency;
+    Clock::time_point created_at;
+  };
+  using EntryList = std::list<Entry>;
+
+  bool expired(const Entry &entry, Clock::time_point now) const;
+  // Inserts at the front and evicts beyond capacity. Caller holds mutex_.
+  void insert(Entry entry);
+  void load();
+
+  const DescriptionCacheOptions options_;
+  mutable std::mutex mutex_;
+  EntryList entries_; // Most recently used first.
+  std::unordered_map<std::uint64_t, EntryList::iterator> index_;
+  Stats stats_;
+};
+
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
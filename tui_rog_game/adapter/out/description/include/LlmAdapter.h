@@ -1,25 +1,74 @@
 #pragma once
 
+#include "DescriptionCache.h"
 #include "GameStateDTO.h"
 #include "IGenerateDescriptionPort.h"
+#include "LlmClientPool.h"
+#include <chrono>
+#include <cstddef>
 #include <memory>
-
-namespace httplib {
-class Client;
-}
+#include <string>
+#include <vector>
 
 namespace TuiRogGame {
 namespace Adapter {
 namespace Out {
 namespace Description {
 
+// Safe to use from several threads at once: each request borrows a client of
+// its own from the pool.
 class LlmAdapter : public Port::Out::IGenerateDescriptionPort {
 public:
+  struct Options {
+    // Answers to prompts built from the same inputs are reused rather than
+    // requested again; only successful responses are cached.
+    DescriptionCacheOptions cache;
+    // Scheme, host and port of the OpenAI-compatible API.
+    std::string base_url = "https://api.groq.com";
+    LlmClientPoolOptions pool;
+    // Most a request may take, waiting for a free client included, before
+    // its description is given up on.
+    std::chrono::milliseconds timeout{10000};
+    // If set, a request with no response after the 95th percentile of recent
+    // response times is sent again on another free client, and whichever
+    // answers first is used.
+    bool hedge = true;
+    // If set, streamDescriptions() requests server-sent events and hands the
+    // text on as it arrives instead of after the whole completion.
+    bool stream = false;
+  };
+
   LlmAdapter();
+  explicit LlmAdapter(Options options);
   ~LlmAdapter() override;
   std::string
   generateDescription(const Port::Out::GameStateDTO &game_state,
                       const Domain::Event::DomainEvent &event) override;
+  // Events the cache cannot answer are described together by one request
+  // that asks for a JSON array of descriptions. A malformed answer falls
+  // back to one request per event.
+  std::vector<std::string> generateDescriptions(
+      const std::vector<Port::Out::DescriptionSubject> &subjects) override;
+  std::vector<std::string> streamDescriptions(
+      const std::vector<Port::Out::DescriptionSubject> &subjects,
+      const Port::Out::DescriptionChunkHandler &on_chunk) override;
+
+  struct RequestStats {
+    LlmClientPool::Stats pool;
+    std::size_t requests = 0;
+    std::size_t failures = 0; // Including timeouts.
+    std::size_t timeouts = 0;
+    // Duplicates sent for slow requests, and how many of them answered first.
+    std::size_t hedged = 0;
+    std::size_t hedge_wins = 0;
+    // Percentiles of the latency of recent successful requests.
+    std::chrono::microseconds p50{0};
+    std::chrono::microseconds p95{0};
+    std::chrono::microseconds p99{0};
+  };
+
+  DescriptionCache::Stats getCacheStats() const;
+  RequestStats getRequestStats() const;
 
 private:
   struct Impl;
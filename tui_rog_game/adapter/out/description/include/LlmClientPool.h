@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace httplib {
+class Client;
+}
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+
+struct LlmClientPoolOptions {
+  // Clients, each with a connection of its own. Requests beyond this many
+  // wait for one to come free.
+  std::size_t size = 4;
+  // Clients keep their connection alive between requests instead of
+  // opening one per request.
+  bool keep_alive = true;
+};
+
+// Fixed set of HTTP clients for one server, lent out to one request at a
+// time since a client cannot be shared. The most recently returned client is
+// lent first, so light traffic keeps reusing one warm connection.
+// Thread-safe.
+class LlmClientPool {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stats {
+    std::size_t size = 0;
+    std::size_t in_use = 0;
+    std::size_t peak_in_use = 0;
+    std::size_t acquisitions = 0;
+    // Acquisitions that found every client busy, and how long they waited.
+    std::size_t waits = 0;
+    std::chrono::microseconds wait_time{0};
+    // Acquisitions given up at their deadline.
+    std::size_t timeouts = 0;
+    // Average share of the clients in use since the pool was made.
+    double utilization = 0.0;
+  };
+
+  // A client on loan, returned to the pool on destruction.
+  class Lease {
+  public:
+    Lease(Lease &&other) noexcept;
+    Lease &operator=(Lease &&other) noexcept;
+    ~Lease();
+
+    httplib::Client &client() const { return *client_; }
+
+  private:
+    friend class LlmClientPool;
+    Lease(LlmClientPool *pool, httplib::Client *client)
+        : pool_(pool), client_(client) {}
+
+    LlmClientPool *pool_;
+    httplib::Client *client_;
+  };
+
+  LlmClientPool(const std::string &base_url, LlmClientPoolOptions options);
+  ~LlmClientPool();
+
+  LlmClientPool(const LlmClientPool &) = delete;
+  LlmClientPool &operator=(const LlmClientPool &) = delete;
+
+  // Waits for a free client, or nothing once deadline passes.
+  std::optional<Lease> acquire(Clock::time_point deadline);
+  // A free client if there is one right now.
+  std::optional<Lease> tryAcquire();
+
+  Stats getStats() const;
+
+private:
+  // Lends the most recently returned client. Caller holds mutex_.
+  Lease lend(Clock::time_point now);
+  void release(httplib::Client *client);
+  // Accounts for the clients in use since the last change. Caller holds
+  // mutex_.
+  void accrueBusyTime(Clock::time_point now);
+
+  std::vector<std::unique_ptr<httplib::Client>> clients_;
+  mutable std::mutex mutex_;
+  std::condition_variable released_;
+  std::vector<httplib::Client *> idle_; // Most recently returned last.
+  Stats stats_;
+  const Clock::time_point created_at_;
+  Clock::time_point last_change_;
+  // Sum over time of the clients in use, up to last_change_.
+  std::chrono::duration<double> busy_time_{0};
+};
+
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "DomainEvent.h"
+#include "GameStateDTO.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+
+// What LlmAdapter sends: the prompt for one or several events, the key its
+// answer is cached under, and the serialized request body.
+namespace LlmPrompt {
+
+constexpr const char *kModel = "llama-3.3-70b-versatile";
+
+// Everything the prompt is built from. Two calls with equal inputs send the
+// same prompt, so the inputs, rather than the prompt text, key the cache.
+struct PromptInputs {
+  Domain::Event::DomainEvent::Type event_type;
+  std::string event_text;
+  int level;
+  int xp;
+  int hp;
+  int max_hp;
+  std::vector<std::string> inventory;
+  int x;
+  int y;
+  std::vector<std::string> nearby_elements;
+};
+
+PromptInputs collectPromptInputs(const Port::Out::GameStateDTO &game_state,
+                                 const Domain::Event::DomainEvent &event);
+
+// A hash of the inputs and of the model, which shapes the answer too.
+std::uint64_t promptKey(const PromptInputs &inputs);
+
+std::string buildPrompt(const PromptInputs &inputs);
+// Asks for a JSON object, {"descriptions": [...]}, holding one description
+// per event in order. Events are numbered "[이벤트 k]".
+std::string buildBatchPrompt(const std::vector<const PromptInputs *> &inputs);
+
+// The chat completions request for the events: the plain prompt for a
+// single one, the batch prompt in JSON mode for several. With stream set,
+// the answer is requested as server-sent events.
+std::string buildRequestBody(const std::vector<const PromptInputs *> &inputs,
+                             bool stream);
+
+} // namespace LlmPrompt
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+
+struct MockLlmServerOptions {
+  // Delay before the answer, or before its first chunk when streaming.
+  std::chrono::milliseconds latency{0};
+  // Up to this much is added to latency, uniformly at random.
+  std::chrono::milliseconds jitter{0};
+  // The next this many requests to arrive wait stall instead, as if the
+  // upstream had hung. Counted from when the options are set.
+  std::size_t stall_next = 0;
+  std::chrono::milliseconds stall{0};
+  // Share of requests answered with a 500 instead.
+  double error_rate = 0.0;
+  // Text of every description. JSON mode (batch) requests get it once per
+  // event, counting the "[이벤트 k]" headings of their prompt.
+  std::string answer = "희미한 횃불 아래로 좁은 복도가 이어집니다.";
+  // If not empty, the content sent instead of one built from answer: streamed
+  // in exactly these pieces, or joined when not streaming.
+  std::vector<std::string> chunks;
+  // Streamed content is otherwise cut into pieces of about this many bytes,
+  // never splitting a UTF-8 character.
+  std::size_t chunk_bytes = 16;
+  // Delay between streamed pieces.
+  std::chrono::milliseconds chunk_interval{0};
+  // If unset, streams end without their [DONE] marker, as if cut off.
+  bool finish_stream = true;
+  std::uint64_t seed = 1;
+};
+
+// A stand-in for the OpenAI-compatible chat completions endpoint LlmAdapter
+// talks to, served by httplib on a free localhost port for as long as the
+// object lives. Answers plain and streamed requests alike, so tests and
+// benchmarks can exercise the description path offline and reproducibly.
+class MockLlmServer {
+public:
+  struct Stats {
+    std::size_t requests = 0;
+    std::size_t streamed = 0;
+    std::size_t errors = 0;
+    // Distinct client connections the requests arrived on.
+    std::size_t connections = 0;
+  };
+
+  explicit MockLlmServer(MockLlmServerOptions options = {});
+  ~MockLlmServer();
+
+  MockLlmServer(const MockLlmServer &) = delete;
+  MockLlmServer &operator=(const MockLlmServer &) = delete;
+
+  // Where to point LlmAdapter::Options::base_url.
+  const std::string &getBaseUrl() const;
+  // Applies to requests arriving from now on.
+  void setOptions(MockLlmServerOptions options);
+  // Bodies of the requests received so far, oldest first.
+  std::vector<std::string> getRequestBodies() const;
+  Stats getStats() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,221 @@
+#include "MockLlmServer.h"
+#include <algorithm>
+#include <httplib.h>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <set>
+#include <spdlog/spdlog.h>
+#include <thread>
+#include <utility>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+
+namespace {
+
+constexpr const char *kCompletionsPath = "/openai/v1/chat/completions";
+
+std::size_t countOccurrences(const std::string &text,
+                             const std::string &pattern) {
+  std::size_t count = 0;
+  for (std::size_t pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + pattern.size())) {
+    ++count;
+  }
+  return count;
+}
+
+std::vector<std::string> splitUtf8(const std::string &text,
+                                   std::size_t piece_bytes) {
+  piece_bytes = std::max<std::size_t>(piece_bytes, 1);
+  std::vector<std::string> pieces;
+  std::size_t start = 0;
+  while (start < text.size()) {
+    std::size_t end = std::min(text.size(), start + piece_bytes);
+    while (end < text.size() &&
+           (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) {
+      ++end; // Continuation byte; keep the character whole.
+    }
+    pieces.push_back(text.substr(start, end - start));
+    start = end;
+  }
+  return pieces;
+}
+
+std::string sseEvent(const std::string &data) {
+  return "data: " + data + "\n\n";
+}
+
+} // namespace
+
+struct MockLlmServer::Impl {
+  httplib::Server server_;
+  std::thread thread_;
+  std::string base_url_;
+
+  mutable std::mutex mutex_;
+  MockLlmServerOptions options_;
+  std::mt19937_64 rng_;
+  std::size_t stalls_left_ = 0;
+  std::vector<std::string> bodies_;
+  std::set<std::pair<std::string, int>> connections_;
+  Stats stats_;
+
+  void handle(const httplib::Request &req, httplib::Response &res);
+};
+
+void MockLlmServer::Impl::handle(const httplib::Request &req,
+                                 httplib::Response &res) {
+  const nlohmann::json request =
+      nlohmann::json::parse(req.body, nullptr, false);
+  const bool stream = request.is_object() && request.value("stream", false);
+
+  MockLlmServerOptions options;
+  bool fail = false;
+  std::chrono::milliseconds delay{0};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options = options_;
+    bodies_.push_back(req.body);
+    connections_.emplace(req.remote_addr, req.remote_port);
+    stats_.connections = connections_.size();
+    ++stats_.requests;
+
+    delay = options.latency;
+    if (stalls_left_ > 0) {
+      --stalls_left_;
+      delay = options.stall;
+    } else if (options.jitter.count() > 0) {
+      std::uniform_int_distribution<std::int64_t> jitter(
+          0, options.jitter.count());
+      delay += std::chrono::milliseconds(jitter(rng_));
+    }
+    fail = std::uniform_real_distribution<double>(0.0, 1.0)(rng_) <
+           options.error_rate;
+    if (fail) {
+      ++stats_.errors;
+    } else if (stream) {
+      ++stats_.streamed;
+    }
+  }
+  std::this_thread::sleep_for(delay);
+
+  if (!request.is_object() || !request.contains("messages")) {
+    res.status = 400;
+    res.set_content(R"({"error":{"message":"malformed request"}})",
+                    "application/json");
+    return;
+  }
+  if (fail) {
+    res.status = 500;
+    res.set_content(R"({"error":{"message":"mock failure"}})",
+                    "application/json");
+    return;
+  }
+
+  std::vector<std::string> pieces = options.chunks;
+  if (pieces.empty()) {
+    std::string content = options.answer;
+    if (request.contains("response_format")) {
+      const std::string prompt =
+          request["messages"].back().value("content", std::string());
+      const std::size_t events =
+          std::max<std::size_t>(countOccurrences(prompt, "[이벤트 "), 1);
+      const nlohmann::json answer = {
+          {"descriptions", std::vector<std::string>(events, options.answer)}};
+      content = answer.dump();
+    }
+    pieces = stream ? splitUtf8(content, options.chunk_bytes)
+                    : std::vector<std::string>{content};
+  }
+
+  if (!stream) {
+    std::string content;
+    for (const auto &piece : pieces) {
+      content += piece;
+    }
+    const nlohmann::json response = {
+        {"object", "chat.completion"},
+        {"choices",
+         {{{"index", 0},
+           {"message", {{"role", "assistant"}, {"content", content}}},
+           {"finish_reason", "stop"}}}}};
+    res.set_content(response.dump(), "application/json");
+    return;
+  }
+
+  res.set_chunked_content_provider(
+      "text/event-stream",
+      [pieces = std::move(pieces), interval = options.chunk_interval,
+       finish = options.finish_stream](std::size_t, httplib::DataSink &sink) {
+        for (std::size_t i = 0; i < pieces.size(); ++i) {
+          if (i > 0 && interval.count() > 0) {
+            std::this_thread::sleep_for(interval);
+          }
+          const nlohmann::json chunk = {
+              {"object", "chat.completion.chunk"},
+              {"choices",
+               {{{"index", 0}, {"delta", {{"content", pieces[i]}}}}}}};
+          const std::string event = sseEvent(chunk.dump());
+          if (!sink.write(event.data(), event.size())) {
+            return false; // The client went away.
+          }
+        }
+        if (finish) {
+          const std::string done = sseEvent("[DONE]");
+          sink.write(done.data(), done.size());
+        }
+        sink.done();
+        return true;
+      });
+}
+
+MockLlmServer::MockLlmServer(MockLlmServerOptions options)
+    : impl_(std::make_unique<Impl>()) {
+  impl_->options_ = std::move(options);
+  impl_->rng_.seed(impl_->options_.seed);
+  impl_->stalls_left_ = impl_->options_.stall_next;
+  impl_->server_.Post(kCompletionsPath, [this](const httplib::Request &req,
+                                               httplib::Response &res) {
+    impl_->handle(req, res);
+  });
+
+  const int port = impl_->server_.bind_to_any_port("127.0.0.1");
+  impl_->base_url_ = "http://127.0.0.1:" + std::to_string(port);
+  impl_->thread_ = std::thread([this] { impl_->server_.listen_after_bind(); });
+  impl_->server_.wait_until_ready();
+  spdlog::debug("MockLlmServer: Listening on {}.", impl_->base_url_);
+}
+
+MockLlmServer::~MockLlmServer() {
+  impl_->server_.stop();
+  impl_->thread_.join();
+}
+
+const std::string &MockLlmServer::getBaseUrl() const {
+  return impl_->base_url_;
+}
+
+void MockLlmServer::setOptions(MockLlmServerOptions options) {
+  std::lock_guard<std::mutex> lock(impl_->mutex_);
+  impl_->options_ = std::move(options);
+  impl_->stalls_left_ = impl_->options_.stall_next;
+}
+
+std::vector<std::string> MockLlmServer::getRequestBodies() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex_);
+  return impl_->bodies_;
+}
+
+MockLlmServer::Stats MockLlmServer::getStats() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex_);
+  return impl_->stats_;
+}
+
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,177 @@
+#include "DescriptionCache.h"
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+
+namespace {
+
+constexpr int kFileVersion = 1;
+
+std::int64_t toMillis(DescriptionCache::Clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+DescriptionCache::DescriptionCache(DescriptionCacheOptions options)
+    : options_(std::move(options)) {
+  if (options_.capacity > 0 && !options_.persist_path.empty()) {
+    load();
+  }
+}
+
+DescriptionCache::~DescriptionCache() { flush(); }
+
+bool DescriptionCache::expired(const Entry &entry,
+                               Clock::time_point now) const {
+  return now - entry.created_at >= options_.ttl;
+}
+
+std::optional<std::string> DescriptionCache::get(std::uint64_t key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return std::nullopt;
+  }
+  if (expired(*it->second, Clock::now())) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    ++stats_.expirations;
+    ++stats_.misses;
+    return std::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  ++stats_.hits;
+  stats_.saved_latency += it->second->latency;
+  return it->second->description;
+}
+
+void DescriptionCache::put(std::uint64_t key, std::string description,
+                           std::chrono::microseconds latency) {
+  if (options_.capacity == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  insert(Entry{key, std::move(description), latency, Clock::now()});
+}
+
+void DescriptionCache::insert(Entry entry) {
+  auto it = index_.find(entry.key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().key, entries_.begin());
+  while (entries_.size() > options_.capacity) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+std::size_t DescriptionCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+DescriptionCache::Stats DescriptionCache::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+bool DescriptionCache::flush() const {
+  if (options_.capacity == 0 || options_.persist_path.empty()) {
+    return true;
+  }
+
+  nlohmann::json entries = nlohmann::json::array();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Clock::time_point now = Clock::now();
+    for (const Entry &entry : entries_) {
+      if (!expired(entry, now)) {
+        entries.push_back({{"key", entry.key},
+                           {"description", entry.description},
+                           {"latency_us", entry.latency.count()},
+                           {"created_at_ms", toMillis(entry.created_at)}});
+      }
+    }
+  }
+  const nlohmann::json document = {{"version", kFileVersion},
+                                   {"entries", std::move(entries)}};
+
+  // Written aside and renamed over the old file, so a crash mid-write leaves
+  // the previous cache intact.
+  const std::string temp_path = options_.persist_path + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::trunc);
+    out << document.dump();
+    if (!out) {
+      spdlog::error("DescriptionCache: Failed to write '{}'.", temp_path);
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, options_.persist_path, ec);
+  if (ec) {
+    spdlog::error("DescriptionCache: Failed to replace '{}': {}",
+                  options_.persist_path, ec.message());
+    return false;
+  }
+  return true;
+}
+
+void DescriptionCache::load() {
+  std::ifstream in(options_.persist_path);
+  if (!in) {
+    return; // Nothing saved yet.
+  }
+  try {
+    const nlohmann::json document = nlohmann::json::parse(in);
+    if (document.value("version", 0) != kFileVersion) {
+      spdlog::warn("DescriptionCache: Ignoring '{}' with unknown version.",
+                   options_.persist_path);
+      return;
+    }
+    const auto &entries = document.at("entries");
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Stored most recently used first; inserting oldest first restores that
+    // order.
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+      Entry entry{it->at("key").get<std::uint64_t>(),
+                  it->at("description").get<std::string>(),
+                  std::chrono::microseconds(
+                      it->at("latency_us").get<std::int64_t>()),
+                  Clock::time_point(std::chrono::milliseconds(
+                      it->at("created_at_ms").get<std::int64_t>()))};
+      if (!expired(entry, now)) {
+        insert(std::move(entry));
+      }
+    }
+    stats_.evictions = 0;
+    spdlog::info("DescriptionCache: Loaded {} entries from '{}'.",
+                 entries_.size(), options_.persist_path);
+  } catch (const nlohmann::json::exception &e) {
+    spdlog::error("DescriptionCache: Failed to read '{}': {}",
+                  options_.persist_path, e.what());
+  }
+}
+
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -1,15 +1,5 @@
 #include "HardcodedDescAdapter.h"
-#include "CombatStartedEvent.h"
-#include "EnemyAttackedEvent.h"
-#include "EnemyDefeatedEvent.h"
-#include "GameLoadedEvent.h"
-#include "ItemFoundEvent.h"
-#include "ItemUsedEvent.h"
-#include "MapChangedEvent.h"
-#include "PlayerAttackedEvent.h"
-#include "PlayerDiedEvent.h"
-#include "PlayerLeveledUpEvent.h"
-#include "PlayerMovedEvent.h"
+#include "EventVisitor.h"
 #include <string>
 #include <vector>
 
@@ -28,54 +18,54 @@ std::string HardcodedDescAdapter::generateDescription(
   std::vector<std::string> nearby_elements; // Moved declaration here
 
   // Event-specific descriptions
-  if (auto gameLoadedEvent =
-          dynamic_cast<const Domain::Event::GameLoadedEvent *>(&event)) {
-    description += "게임이 로드되었습니다. 당신은 던전 깊은 곳에 서 있습니다. ";
-  } else if (auto playerMovedEvent =
-                 dynamic_cast<const Domain::Event::PlayerMovedEvent *>(
-                     &event)) {
-    description += "새로운 지역으로 이동했습니다. ";
-  } else if (auto combatStartedEvent =
-                 dynamic_cast<const Domain::Event::CombatStartedEvent *>(
-                     &event)) {
-    description +=
-        combatStartedEvent->getEnemyName() + "와(과) 전투가 시작되었습니다! ";
-  } else if (auto enemyDefeatedEvent =
-                 dynamic_cast<const Domain::Event::EnemyDefeatedEvent *>(
-                     &event)) {
-    description += enemyDefeatedEvent->getEnemyName() + "를(을) 물리쳤습니다! ";
-  } else if (auto itemFoundEvent =
-                 dynamic_cast<const Domain::Event::ItemFoundEvent *>(&event)) {
-    description += itemFoundEvent->getItemName() + "을(를) 발견했습니다! ";
-  } else if (auto mapChangedEvent =
-                 dynamic_cast<const Domain::Event::MapChangedEvent *>(&event)) {
-    description += "새로운 층으로 내려왔습니다. ";
-  } else if (auto playerLeveledUpEvent =
-                 dynamic_cast<const Domain::Event::PlayerLeveledUpEvent *>(
-                     &event)) {
-    description += "레벨업했습니다! 현재 레벨: " +
-                   std::to_string(playerLeveledUpEvent->getNewLevel()) + ". ";
-  } else if (auto playerDiedEvent =
-                 dynamic_cast<const Domain::Event::PlayerDiedEvent *>(&event)) {
-    description += "마술같은 은혜로 부활했습니다. ";
-  } else if (auto playerAttackedEvent =
-                 dynamic_cast<const Domain::Event::PlayerAttackedEvent *>(
-                     &event)) {
-    description += playerAttackedEvent->getEnemyName() + "에게 " +
-                   std::to_string(playerAttackedEvent->getDamageDealt()) +
+  using namespace Domain::Event;
+  description += visitExhaustive(
+      event,
+      Overloaded{
+          [](const GameLoadedEvent &) -> std::string {
+            return "게임이 로드되었습니다. 당신은 던전 깊은 곳에 서 있습니다. ";
+          },
+          [](const PlayerMovedEvent &) -> std::string {
+            return "새로운 지역으로 이동했습니다. ";
+          },
+          [](const CombatStartedEvent &e) -> std::string {
+            return e.getEnemyName() + "와(과) 전투가 시작되었습니다! ";
+          },
+          [](const EnemyDefeatedEvent &e) -> std::string {
+            return e.getEnemyName() + "를(을) 물리쳤습니다! ";
+          },
+          [](const ItemFoundEvent &e) -> std::string {
+            return e.getItemName() + "을(를) 발견했습니다! ";
+          },
+          [](const MapChangedEvent &) -> std::string {
+            return "새로운 층으로 내려왔습니다. ";
+          },
+          [](const PlayerLeveledUpEvent &e) -> std::string {
+            return "레벨업했습니다! 현재 레벨: " +
+                   std::to_string(e.getNewLevel()) + ". ";
+          },
+          [](const PlayerDiedEvent &) -> std::string {
+            return "마술같은 은혜로 부활했습니다. ";
+          },
+          [](const PlayerAttackedEvent &e) -> std::string {
+            return e.getEnemyName() + "에게 " +
+                   std::to_string(e.getDamageDealt()) +
                    "의 피해를 입혔습니다. ";
-  } else if (auto enemyAttackedEvent =
-                 dynamic_cast<const Domain::Event::EnemyAttackedEvent *>(
-                     &event)) {
-    description += enemyAttackedEvent->getEnemyName() + "에게 " +
-                   std::to_string(enemyAttackedEvent->getDamageDealt()) +
+          },
+          [](const EnemyAttackedEvent &e) -> std::string {
+            return e.getEnemyName() + "에게 " +
+                   std::to_string(e.getDamageDealt()) +
                    "의 피해를 입었습니다. ";
-  } else if (auto itemUsedEvent =
-                 dynamic_cast<const Domain::Event::ItemUsedEvent *>(&event)) {
-    description += itemUsedEvent->getItemName() + "을(를) 사용했습니다. ";
-  } else {
-    description += "알 수 없는 이벤트가 발생했습니다. ";
-  }
+          },
+          [](const ItemUsedEvent &e) -> std::string {
+            return e.getItemName() + "을(를) 사용했습니다. ";
+          },
+          [](const DescriptionGeneratedEvent &) -> std::string {
+            return "";
+          },
+          [](const UntypedEvent &) -> std::string {
+            return "알 수 없는 이벤트가 발생했습니다. ";
+          }});
 
   // Generic location description (can be refined or removed if event-specific
   // is enough)
@@ -1,181 +1,897 @@
 #include "LlmAdapter.h"
+#include "DomainEvent.h"
 #include "IGenerateDescriptionPort.h"
-#include "PlayerDiedEvent.h"
+#include "LlmPrompt.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <httplib.h>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <spdlog/spdlog.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace TuiRogGame {
 namespace Adapter {
 namespace Out {
 namespace Description {
 
-struct LlmAdapter::Impl {
-  std::unique_ptr<httplib::Client> cli_;
-};
+namespace {
+
+using LlmPrompt::PromptInputs;
 
-LlmAdapter::LlmAdapter() : impl_(std::make_unique<Impl>()) {
-  impl_->cli_ = std::make_unique<httplib::Client>("https://api.groq.com");
-  impl_->cli_->set_keep_alive(true);
-  impl_->cli_->set_connection_timeout(3, 0);
-  impl_->cli_->set_read_timeout(5, 0);
-  impl_->cli_->set_write_timeout(3, 0);
+// Descriptions from a batch answer, or nothing unless it holds exactly one
+// string per requested event.
+std::optional<std::vector<std::string>>
+parseBatchDescriptions(const std::string &content, std::size_t expected) {
+  const nlohmann::json answer = nlohmann::json::parse(content, nullptr, false);
+  if (!answer.is_object() || !answer.contains("descriptions") ||
+      !answer["descriptions"].is_array() ||
+      answer["descriptions"].size() != expected) {
+    return std::nullopt;
+  }
+  std::vector<std::string> descriptions;
+  descriptions.reserve(expected);
+  for (const auto &description : answer["descriptions"]) {
+    if (!description.is_string() || description.empty()) {
+      return std::nullopt;
+    }
+    descriptions.push_back(description.get<std::string>());
+  }
+  return descriptions;
 }
 
-LlmAdapter::~LlmAdapter() = default;
+const std::string kFailedDescription =
+    "An ancient, echoing chamber, but the magic seems to have failed. ";
+
+using TextHandler = std::function<void(const std::string &text)>;
+
+// Follows a server-sent event stream of chat completion chunks, handing on
+// the content each one adds and collecting the whole of it.
+class CompletionStreamParser {
+public:
+  explicit CompletionStreamParser(TextHandler on_delta)
+      : on_delta_(std::move(on_delta)) {}
+
+  void feed(const char *data, std::size_t size) {
+    buffer_.append(data, size);
+    std::size_t line_start = 0;
+    for (std::size_t newline = buffer_.find('\n');
+         newline != std::string::npos;
+         newline = buffer_.find('\n', line_start)) {
+      std::string_view line(buffer_.data() + line_start,
+                            newline - line_start);
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      handleLine(line);
+      line_start = newline + 1;
+    }
+    buffer_.erase(0, line_start);
+  }
 
-std::string
+  // Whether the stream ended with its [DONE] marker, rather than being cut.
+  bool done() const { return done_; }
+  bool malformed() const { return malformed_; }
+  const std::string &content() const { return content_; }
 
-LlmAdapter::generateDescription(const Port::Out::GameStateDTO &game_state,
-                                const Domain::Event::DomainEvent &event) {
-  const auto &player = game_state.player;
-  const auto &map = game_state.map;
-  const auto &player_position = player.getPosition();
+private:
+  void handleLine(std::string_view line) {
+    constexpr std::string_view kData = "data:";
+    if (line.substr(0, kData.size()) != kData) {
+      return; // Blank separators, comments and other fields.
+    }
+    line.remove_prefix(kData.size());
+    while (!line.empty() && line.front() == ' ') {
+      line.remove_prefix(1);
+    }
+    if (line == "[DONE]") {
+      done_ = true;
+      return;
+    }
+    const nlohmann::json chunk =
+        nlohmann::json::parse(line.begin(), line.end(), nullptr, false);
+    if (chunk.is_discarded()) {
+      malformed_ = true;
+      return;
+    }
+    if (!chunk.contains("choices") || !chunk["choices"].is_array() ||
+        chunk["choices"].empty()) {
+      return;
+    }
+    const auto &delta = chunk["choices"][0].value("delta", nlohmann::json());
+    if (delta.contains("content") && delta["content"].is_string()) {
+      const std::string text = delta["content"].get<std::string>();
+      if (!text.empty()) {
+        content_ += text;
+        on_delta_(text);
+      }
+    }
+  }
 
-  spdlog::info(
-      "AI Adapter: Generating description for player at ({}, {}) for event: {}",
-      player_position.x, player_position.y, event.toString());
+  TextHandler on_delta_;
+  std::string buffer_;
+  std::string content_;
+  bool done_ = false;
+  bool malformed_ = false;
+};
 
-  const char *groq_api_key = std::getenv("GROQ_API_KEY");
+void appendUtf8(std::string &out, std::uint32_t code_point) {
+  if (code_point < 0x80) {
+    out += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    out += static_cast<char>(0xC0 | (code_point >> 6));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    out += static_cast<char>(0xE0 | (code_point >> 12));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code_point >> 18));
+    out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
 
-  if (!groq_api_key) {
-    spdlog::error("AI Adapter: GROQ_API_KEY environment variable not set.");
-    return "An ancient, echoing chamber, but the magic seems to have failed. "
-           "(API Key Missing)";
+// Follows a batch answer, {"descriptions": ["...", ...]}, while it streams
+// in and reports the text of each array element as it arrives, long before
+// the whole answer can be parsed. Only as strict as it needs to be; the
+// complete answer is still parsed and validated afterwards.
+class BatchStreamScanner {
+public:
+  using Handler = std::function<void(std::size_t index, const std::string &)>;
+
+  explicit BatchStreamScanner(Handler on_text) : on_text_(std::move(on_text)) {}
+
+  void feed(const std::string &delta) {
+    std::string text;
+    for (char c : delta) {
+      switch (state_) {
+      case State::BeforeArray:
+        if (c == '"') {
+          state_ = State::InKey;
+        } else if (c == '[') {
+          state_ = State::InArray;
+        }
+        break;
+      case State::InKey:
+        if (c == '\\') {
+          state_ = State::KeyEscape;
+        } else if (c == '"') {
+          state_ = State::BeforeArray;
+        }
+        break;
+      case State::KeyEscape:
+        state_ = State::InKey;
+        break;
+      case State::InArray:
+        if (c == '"') {
+          state_ = State::InString;
+        } else if (c == ']') {
+          state_ = State::Done;
+        }
+        break;
+      case State::InString:
+        if (c == '\\') {
+          state_ = State::Escape;
+        } else if (c == '"') {
+          flush(text);
+          ++index_;
+          state_ = State::InArray;
+        } else {
+          text += c;
+        }
+        break;
+      case State::Escape:
+        state_ = State::InString;
+        switch (c) {
+        case 'n':
+          text += '\n';
+          break;
+        case 't':
+          text += '\t';
+          break;
+        case 'r':
+        case 'b':
+        case 'f':
+          break;
+        case 'u':
+          hex_.clear();
+          state_ = State::Unicode;
+          break;
+        default: // '"', '\\' and '/' stand for themselves.
+          text += c;
+          break;
+        }
+        break;
+      case State::Unicode:
+        hex_ += c;
+        if (hex_.size() == 4) {
+          appendCodeUnit(text,
+                         static_cast<std::uint32_t>(
+                             std::strtoul(hex_.c_str(), nullptr, 16)));
+          state_ = State::InString;
+        }
+        break;
+      case State::Done:
+        break;
+      }
+    }
+    flush(text);
   }
 
-  std::string path = "/openai/v1/chat/completions";
-  nlohmann::json request_body;
-  std::string prompt =
-      "당신은 던전 마스터입니다. 다음 게임 상태 정보와 발생한 이벤트를 "
-      "바탕으로 플레이어 주변 "
-      "상황을 한국어로 간결하고 생생하게 묘사해주세요. 묘사는 50단어 이내로 "
-      "해주세요.\n\n";
+private:
+  enum class State {
+    BeforeArray,
+    InKey,
+    KeyEscape,
+    InArray,
+    InString,
+    Escape,
+    Unicode,
+    Done
+  };
+
+  void appendCodeUnit(std::string &text, std::uint32_t unit) {
+    if (unit >= 0xD800 && unit < 0xDC00) {
+      high_surrogate_ = unit; // Completed by the next escape.
+      return;
+    }
+    if (unit >= 0xDC00 && unit < 0xE000 && high_surrogate_) {
+      unit = 0x10000 + ((high_surrogate_ - 0xD800) << 10) + (unit - 0xDC00);
+    }
+    high_surrogate_ = 0;
+    appendUtf8(text, unit);
+  }
 
-  if (dynamic_cast<const Domain::Event::PlayerDiedEvent*>(&event)) {
-      prompt += "플레이어가 방금 죽었지만, 신비한 힘으로 즉시 부활했습니다. "
-          "이 기적적인 부활의 순간을 묘사해주세요.\n";
+  void flush(std::string &text) {
+    if (!text.empty()) {
+      on_text_(index_, text);
+      text.clear();
+    }
   }
 
-  prompt += "발생한 이벤트: " + event.toString() + ".\n";
-  prompt += "플레이어 정보: 레벨 " + std::to_string(player.getLevel()) +
-            ", 경험치 " + std::to_string(player.getXp()) + ", 체력 " +
-            std::to_string(player.getHp()) + "/" +
-            std::to_string(player.getMaxHp()) + ".\n";
+  Handler on_text_;
+  State state_ = State::BeforeArray;
+  std::size_t index_ = 0;
+  std::string hex_;
+  std::uint32_t high_surrogate_ = 0;
+};
 
-  prompt += "인벤토리: ";
+constexpr const char *kCompletionsPath = "/openai/v1/chat/completions";
 
-  if (player.getInventory().empty()) {
-    prompt += "비어있음.\n";
-  } else {
-    for (size_t i = 0; i < player.getInventory().size(); ++i) {
-      prompt += player.getInventory()[i]->getName();
+// Outcome of one chat completion request. On failure, content is the
+// fallback description naming what went wrong.
+struct Completion {
+  bool ok = false;
+  std::string content;
+  std::chrono::microseconds latency{0};
+};
 
-      if (i < player.getInventory().size() - 1) {
-        prompt += ", ";
+Completion parseCompletion(const std::string &body,
+                           std::chrono::microseconds latency) {
+  try {
+    nlohmann::json response_json = nlohmann::json::parse(body);
+    if (response_json.contains("choices") &&
+        !response_json["choices"].empty()) {
+
+      const auto &choice = response_json["choices"][0];
+      if (choice.contains("message") && choice["message"].contains("content")) {
+        return {true, choice["message"]["content"].get<std::string>(),
+                latency};
       }
     }
 
-    prompt += ".\n";
+    spdlog::error("AI Adapter: LLM response missing expected fields.");
+    return {false, kFailedDescription + "(Invalid LLM Response)", latency};
+
+  } catch (const nlohmann::json::exception &e) {
+    spdlog::error("AI Adapter: Failed to parse LLM response JSON: {}",
+                  e.what());
+    return {false, kFailedDescription + "(JSON Parse Error)", latency};
   }
+}
 
-  std::vector<std::string> nearby_elements;
-  int px = player_position.x;
-  int py = player_position.y;
-  for (int dy = -1; dy <= 1; ++dy) {
-    for (int dx = -1; dx <= 1; ++dx) {
-      if (dx == 0 && dy == 0)
-        continue; // 플레이어 자신 위치 제외
+// Latencies kept for percentiles.
+constexpr std::size_t kLatencyWindow = 256;
+// Responses timed before hedging starts, so that their 95th percentile
+// means something.
+constexpr std::size_t kMinHedgeSamples = 20;
+
+// The most recent latencies, oldest overwritten first.
+class LatencyWindow {
+public:
+  void add(std::chrono::microseconds latency) {
+    if (samples_.size() < kLatencyWindow) {
+      samples_.push_back(latency);
+    } else {
+      samples_[next_] = latency;
+    }
+    next_ = (next_ + 1) % kLatencyWindow;
+  }
 
-      int nx = px + dx;
-      int ny = py + dy;
+  std::size_t size() const { return samples_.size(); }
 
-      if (nx >= 0 && nx < map.getWidth() && ny >= 0 && ny < map.getHeight()) {
-        Domain::Model::Tile tile = map.getTile(nx, ny);
+  // Nearest-rank percentile, p in (0, 1]; zero while empty.
+  std::chrono::microseconds percentile(double p) const {
+    if (samples_.empty()) {
+      return std::chrono::microseconds(0);
+    }
+    std::vector<std::chrono::microseconds> sorted = samples_;
+    const auto rank = static_cast<std::size_t>(
+        std::ceil(p * static_cast<double>(sorted.size())));
+    const std::size_t index = std::clamp<std::size_t>(rank, 1, sorted.size());
+    std::nth_element(sorted.begin(), sorted.begin() + (index - 1),
+                     sorted.end());
+    return sorted[index - 1];
+  }
 
-        if (tile == Domain::Model::Tile::ENEMY) {
-          nearby_elements.push_back("몬스터");
-        } else if (tile == Domain::Model::Tile::ITEM) {
-          nearby_elements.push_back("아이템");
-        } else if (tile == Domain::Model::Tile::EXIT) {
-          nearby_elements.push_back("출구");
-        }
+private:
+  std::vector<std::chrono::microseconds> samples_;
+  std::size_t next_ = 0;
+};
+
+// Requests racing to answer one completion: the one sent first and, if it
+// is slow to respond, a hedge on another client. The first to get a
+// successful response is read to the end; the other is cancelled.
+struct Race {
+  static constexpr int kNoWinner = -1;
+
+  struct Entry {
+    // Held until the request has finished and the caller has stopped the
+    // ones it no longer waits for, so that it never stops a client already
+    // lent to another request.
+    std::optional<LlmClientPool::Lease> lease;
+    bool finished = false;
+    Completion completion;
+    // Until the response started to arrive, if it was successful.
+    std::optional<std::chrono::microseconds> response_time;
+  };
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::array<Entry, 2> entries;
+  std::size_t launched = 0;
+  int winner = kNoWinner;
+  // Set once the caller has given up waiting.
+  bool abandoned = false;
+  // Set once the caller has stopped the unfinished requests; requests that
+  // finish afterwards return their own lease.
+  bool stopped = false;
+
+  // Caller holds mutex.
+  bool settled() const {
+    if (winner != kNoWinner) {
+      return entries[winner].finished;
+    }
+    return std::all_of(entries.begin(), entries.begin() + launched,
+                       [](const Entry &entry) { return entry.finished; });
+  }
+
+  // Caller holds mutex.
+  bool cancelled(std::size_t index) const {
+    return abandoned ||
+           (winner != kNoWinner && winner != static_cast<int>(index));
+  }
+};
+
+// Runs one request of a race on a pool thread, reading the answer as a
+// stream if on_delta is set, which the request body must have asked for.
+void runAttempt(const std::shared_ptr<Race> &race, std::size_t index,
+                const std::string &api_key,
+                const std::shared_ptr<const std::string> &request_body,
+                const TextHandler &on_delta) {
+  const auto request_start = std::chrono::steady_clock::now();
+  const auto elapsed = [&request_start] {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - request_start);
+  };
+
+  Race::Entry &entry = race->entries[index];
+  int status = 0;
+  std::string body;
+  bool first_chunk = true;
+  CompletionStreamParser parser(on_delta);
+
+  httplib::Request req;
+  req.method = "POST";
+  req.path = kCompletionsPath;
+  req.headers = {{"Authorization", "Bearer " + api_key},
+                 {"Content-Type", "application/json"}};
+  req.body = *request_body;
+  req.response_handler = [&](const httplib::Response &response) {
+    std::lock_guard<std::mutex> lock(race->mutex);
+    status = response.status;
+    if (race->cancelled(index)) {
+      return false;
+    }
+    if (status == 200) {
+      entry.response_time = elapsed();
+      if (race->winner == Race::kNoWinner) {
+        race->winner = static_cast<int>(index);
+        race->changed.notify_all();
       }
     }
+    return true;
+  };
+  req.content_receiver = [&](const char *data, std::size_t size,
+                             std::uint64_t, std::uint64_t) {
+    // Held while handing text on, so none reaches a caller that gave up.
+    std::lock_guard<std::mutex> lock(race->mutex);
+    if (race->cancelled(index)) {
+      return false;
+    }
+    if (status != 200 || !on_delta) {
+      body.append(data, size);
+      return true;
+    }
+    if (first_chunk) {
+      first_chunk = false;
+      spdlog::debug(
+          "AI Adapter: First chunk after {} ms.",
+          std::chrono::duration_cast<std::chrono::milliseconds>(elapsed())
+              .count());
+    }
+    parser.feed(data, size);
+    return true;
+  };
+
+  // Set before the request was submitted, and not moved until it finishes.
+  auto res = entry.lease->client().send(req);
+  const auto request_latency = elapsed();
+
+  bool cancelled;
+  {
+    std::lock_guard<std::mutex> lock(race->mutex);
+    cancelled = race->cancelled(index);
+  }
+  Completion completion{false, kFailedDescription + "(API Request Failed)",
+                        request_latency};
+  if (cancelled) {
+    // Lost the race or given up on; nobody reads the outcome.
+  } else if (!res || res->status != 200) {
+    spdlog::error("AI Adapter: Failed to get response from LLM API. "
+                  "Status: {}, Error: {}",
+                  res ? res->status : 0,
+                  res ? body : httplib::to_string(res.error()));
+  } else if (on_delta) {
+    if (parser.malformed() || !parser.done()) {
+      spdlog::error("AI Adapter: LLM response stream was {}.",
+                    parser.malformed() ? "malformed" : "cut short");
+      completion.content = kFailedDescription + "(Invalid LLM Response)";
+    } else {
+      completion = {true, parser.content(), request_latency};
+    }
+  } else {
+    completion = parseCompletion(body, request_latency);
   }
 
-  if (!nearby_elements.empty()) {
-    prompt += "현재 위치 (" + std::to_string(px) + ", " + std::to_string(py) +
-              ") 주변에는 ";
+  std::optional<LlmClientPool::Lease> returned;
+  {
+    std::lock_guard<std::mutex> lock(race->mutex);
+    entry.completion = std::move(completion);
+    entry.finished = true;
+    if (race->stopped) {
+      returned = std::move(entry.lease);
+    }
+  }
+  race->changed.notify_all();
+}
 
-    for (size_t i = 0; i < nearby_elements.size(); ++i) {
-      prompt += nearby_elements[i];
+} // namespace
 
-      if (i < nearby_elements.size() - 1) {
-        prompt += ", ";
+struct LlmAdapter::Impl {
+  LlmClientPool pool_;
+  DescriptionCache cache_;
+  const bool stream_;
+  const std::chrono::milliseconds timeout_;
+  const bool hedge_;
+
+  mutable std::mutex stats_mutex_;
+  RequestStats stats_;
+  // Until the response started to arrive, which is what hedging waits on.
+  LatencyWindow response_times_;
+  // Whole successful requests, for the tail latency reported in stats_.
+  LatencyWindow latencies_;
+
+  // Runs the requests of every race. Each holds a client while it runs, so
+  // one thread per client never leaves a request waiting for a thread.
+  // Declared after pool_ so that its requests finish, and return their
+  // clients, before the clients are destroyed.
+  Common::ThreadPool attempts_;
+
+  explicit Impl(const Options &options)
+      : pool_(options.base_url, options.pool), cache_(options.cache),
+        stream_(options.stream), timeout_(options.timeout),
+        hedge_(options.hedge),
+        attempts_(std::max<std::size_t>(options.pool.size, 1)) {}
+
+  // Reads the answer as a stream if on_delta is set, which the request body
+  // must have asked for, handing on each piece of content. Gives up once
+  // timeout_ has passed.
+  Completion complete(const char *api_key, const std::string &request_body,
+                      const TextHandler &on_delta);
+  // When to send a hedge for a request sent at sent_at, if at all.
+  std::optional<LlmClientPool::Clock::time_point>
+  hedgeTime(LlmClientPool::Clock::time_point sent_at) const;
+  void record(const Completion &completion,
+              std::optional<std::chrono::microseconds> response_time,
+              bool timed_out, bool hedged, bool hedge_won);
+  // Requests the description of a single event, caching it on success.
+  std::string describe(const char *api_key, const PromptInputs &inputs,
+                       std::uint64_t cache_key, const TextHandler &on_delta);
+  // Streams to on_chunk if it is set.
+  std::vector<std::string>
+  describeAll(const std::vector<Port::Out::DescriptionSubject> &subjects,
+              const Port::Out::DescriptionChunkHandler &on_chunk);
+};
+
+Completion LlmAdapter::Impl::complete(const char *api_key,
+                                      const std::string &request_body,
+                                      const TextHandler &on_delta) {
+  using Clock = LlmClientPool::Clock;
+
+  const Clock::time_point start = Clock::now();
+  const Clock::time_point deadline = start + timeout_;
+  const auto elapsed = [&start] {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - start);
+  };
+
+  std::optional<LlmClientPool::Lease> lease = pool_.acquire(deadline);
+  if (!lease) {
+    spdlog::error("AI Adapter: No free connection within {} ms.",
+                  timeout_.count());
+    Completion completion{
+        false, kFailedDescription + "(API Request Timed Out)", elapsed()};
+    record(completion, std::nullopt, true, false, false);
+    return completion;
+  }
+
+  auto race = std::make_shared<Race>();
+  const auto body = std::make_shared<const std::string>(request_body);
+  const std::string key(api_key);
+
+  std::unique_lock<std::mutex> lock(race->mutex);
+  const auto launch = [&](LlmClientPool::Lease attempt_lease) {
+    const std::size_t index = race->launched++;
+    race->entries[index].lease = std::move(attempt_lease);
+    attempts_.submit([race, index, key, body, on_delta] {
+      runAttempt(race, index, key, body, on_delta);
+    });
+  };
+  launch(std::move(*lease));
+
+  std::optional<Clock::time_point> hedge_at = hedgeTime(Clock::now());
+  const auto settled = [&race] { return race->settled(); };
+  while (!race->changed.wait_until(
+      lock, hedge_at ? std::min(*hedge_at, deadline) : deadline, settled)) {
+    if (!hedge_at || Clock::now() >= deadline) {
+      break;
+    }
+    hedge_at.reset();
+    if (race->winner == Race::kNoWinner) {
+      // Only on an idle client; a hedge never waits for one.
+      if (auto hedge_lease = pool_.tryAcquire()) {
+        spdlog::debug("AI Adapter: No response after {} ms, hedging.",
+                      std::chrono::duration_cast<std::chrono::milliseconds>(
+                          elapsed())
+                          .count());
+        launch(std::move(*hedge_lease));
       }
     }
+  }
 
-    prompt += "이(가) 있습니다.\n";
-    prompt += "몬스터가 가까이 있다면 위협적인 분위기를, 아이템이 가까이 "
-              "있다면 흥미로운 발견을, 출구가 가까이 있다면 탈출 또는 다음 "
-              "단계로의 기회를 암시하는 묘사를 포함해주세요.\n";
+  const bool timed_out = !race->settled();
+  if (timed_out) {
+    race->abandoned = true;
+  }
+  // Whatever still runs has lost the race or run out of time. Stopped once
+  // the lock is released: stop() can block while the request holds its
+  // socket, and the request needs the lock to notice it was cancelled.
+  std::vector<httplib::Client *> unfinished;
+  for (std::size_t i = 0; i < race->launched; ++i) {
+    if (!race->entries[i].finished) {
+      unfinished.push_back(&race->entries[i].lease->client());
+    }
+  }
 
+  Completion completion;
+  std::optional<std::chrono::microseconds> response_time;
+  if (timed_out) {
+    spdlog::error("AI Adapter: LLM request timed out after {} ms.",
+                  timeout_.count());
+    completion = {false, kFailedDescription + "(API Request Timed Out)",
+                  elapsed()};
+  } else if (race->winner != Race::kNoWinner) {
+    Race::Entry &winner = race->entries[race->winner];
+    completion = std::move(winner.completion);
+    completion.latency = elapsed();
+    response_time = winner.response_time;
   } else {
-    prompt += "현재 위치 (" + std::to_string(px) + ", " + std::to_string(py) +
-              ") 주변에는 특별한 것이 없습니다.\n";
+    // Every request failed; report the first.
+    completion = std::move(race->entries[0].completion);
   }
+  const bool hedged = race->launched > 1;
+  const bool hedge_won = race->winner == 1;
+  lock.unlock();
 
-  request_body["model"] = "llama-3.3-70b-versatile";
-  request_body["max_tokens"] = 150;
-  request_body["temperature"] = 0.7;
-  request_body["messages"] = {{{"role", "user"}, {"content", prompt}}};
+  for (httplib::Client *client : unfinished) {
+    client->stop();
+  }
+  // Clients of the finished requests go back to the pool; the others go
+  // back when their requests finish.
+  std::vector<LlmClientPool::Lease> returned;
+  lock.lock();
+  race->stopped = true;
+  for (std::size_t i = 0; i < race->launched; ++i) {
+    if (race->entries[i].finished && race->entries[i].lease) {
+      returned.push_back(std::move(*race->entries[i].lease));
+      race->entries[i].lease.reset();
+    }
+  }
+  lock.unlock();
+  returned.clear();
 
-  httplib::Headers headers = {
-      {"Authorization", "Bearer " + std::string(groq_api_key)},
-      {"Content-Type", "application/json"}};
+  record(completion, response_time, timed_out, hedged, hedge_won);
+  return completion;
+}
 
-  auto res = impl_->cli_->Post(path.c_str(), headers, request_body.dump(),
-                               "application/json");
+std::optional<LlmClientPool::Clock::time_point>
+LlmAdapter::Impl::hedgeTime(LlmClientPool::Clock::time_point sent_at) const {
+  if (!hedge_) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  if (response_times_.size() < kMinHedgeSamples) {
+    return std::nullopt;
+  }
+  return sent_at + response_times_.percentile(0.95);
+}
 
-  if (res && res->status == 200) {
-    try {
-      nlohmann::json response_json = nlohmann::json::parse(res->body);
-      if (response_json.contains("choices") &&
-          !response_json["choices"].empty()) {
+void LlmAdapter::Impl::record(
+    const Completion &completion,
+    std::optional<std::chrono::microseconds> response_time, bool timed_out,
+    bool hedged, bool hedge_won) {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  ++stats_.requests;
+  if (!completion.ok) {
+    ++stats_.failures;
+  } else {
+    latencies_.add(completion.latency);
+  }
+  if (timed_out) {
+    ++stats_.timeouts;
+  }
+  if (hedged) {
+    ++stats_.hedged;
+  }
+  if (hedge_won) {
+    ++stats_.hedge_wins;
+  }
+  if (response_time) {
+    response_times_.add(*response_time);
+  }
+}
 
-        const auto &choice = response_json["choices"][0];
-        if (choice.contains("message") &&
-            choice["message"].contains("content")) {
-          spdlog::info("AI Adapter: Successfully generated description.");
-          return choice["message"]["content"].get<std::string>();
-        }
-      }
+std::string LlmAdapter::Impl::describe(const char *api_key,
+                                       const PromptInputs &inputs,
+                                       std::uint64_t cache_key,
+                                       const TextHandler &on_delta) {
+  Completion completion = complete(
+      api_key,
+      LlmPrompt::buildRequestBody({&inputs}, static_cast<bool>(on_delta)),
+      on_delta);
+  if (completion.ok) {
+    spdlog::info("AI Adapter: Successfully generated description.");
+    cache_.put(cache_key, completion.content, completion.latency);
+  }
+  return completion.content;
+}
+
+LlmAdapter::LlmAdapter() : LlmAdapter(Options()) {}
+
+LlmAdapter::LlmAdapter(Options options)
+    : impl_(std::make_unique<Impl>(options)) {}
+
+LlmAdapter::~LlmAdapter() {
+  const DescriptionCache::Stats stats = impl_->cache_.getStats();
+  spdlog::info("AI Adapter: Description cache hit rate {:.1f}% ({} hits, {} "
+               "misses), {} ms of requests saved.",
+               stats.hitRate() * 100.0, stats.hits, stats.misses,
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                   stats.saved_latency)
+                   .count());
+  const RequestStats requests = getRequestStats();
+  spdlog::info("AI Adapter: {} requests ({} failed, {} timed out, {} hedged), "
+               "p95 {} ms, p99 {} ms, connection pool {:.1f}% utilized.",
+               requests.requests, requests.failures, requests.timeouts,
+               requests.hedged,
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                   requests.p95)
+                   .count(),
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                   requests.p99)
+                   .count(),
+               requests.pool.utilization * 100.0);
+}
+
+DescriptionCache::Stats LlmAdapter::getCacheStats() const {
+  return impl_->cache_.getStats();
+}
 
-      spdlog::error("AI Adapter: LLM response missing expected fields.");
-      return "An ancient, echoing chamber, but the magic seems to have failed. "
-             "(Invalid LLM Response)";
+LlmAdapter::RequestStats LlmAdapter::getRequestStats() const {
+  RequestStats stats;
+  {
+    std::lock_guard<std::mutex> lock(impl_->stats_mutex_);
+    stats = impl_->stats_;
+    stats.p50 = impl_->latencies_.percentile(0.50);
+    stats.p95 = impl_->latencies_.percentile(0.95);
+    stats.p99 = impl_->latencies_.percentile(0.99);
+  }
+  stats.pool = impl_->pool_.getStats();
+  return stats;
+}
 
-    } catch (const nlohmann::json::parse_error &e) {
-      spdlog::error("AI Adapter: Failed to parse LLM response JSON: {}",
-                    e.what());
+std::string
+
+LlmAdapter::generateDescription(const Port::Out::GameStateDTO &game_state,
+                                const Domain::Event::DomainEvent &event) {
+  const PromptInputs inputs =
+      LlmPrompt::collectPromptInputs(game_state, event);
+
+  spdlog::info(
+      "AI Adapter: Generating description for player at ({}, {}) for event: {}",
+      inputs.x, inputs.y, inputs.event_text);
 
-      return "An ancient, echoing chamber, but the magic seems to have failed. "
-             "(JSON Parse Error)";
+  const std::uint64_t cache_key = LlmPrompt::promptKey(inputs);
+  if (auto cached = impl_->cache_.get(cache_key)) {
+    spdlog::info("AI Adapter: Reused cached description.");
+    return *cached;
+  }
+
+  const char *groq_api_key = std::getenv("GROQ_API_KEY");
+
+  if (!groq_api_key) {
+    spdlog::error("AI Adapter: GROQ_API_KEY environment variable not set.");
+    return kFailedDescription + "(API Key Missing)";
+  }
+
+  return impl_->describe(groq_api_key, inputs, cache_key, nullptr);
+}
+
+std::vector<std::string> LlmAdapter::generateDescriptions(
+    const std::vector<Port::Out::DescriptionSubject> &subjects) {
+  return impl_->describeAll(subjects, nullptr);
+}
+
+std::vector<std::string> LlmAdapter::streamDescriptions(
+    const std::vector<Port::Out::DescriptionSubject> &subjects,
+    const Port::Out::DescriptionChunkHandler &on_chunk) {
+  if (!impl_->stream_) {
+    return impl_->describeAll(subjects, nullptr);
+  }
+  return impl_->describeAll(subjects, on_chunk);
+}
+
+std::vector<std::string> LlmAdapter::Impl::describeAll(
+    const std::vector<Port::Out::DescriptionSubject> &subjects,
+    const Port::Out::DescriptionChunkHandler &on_chunk) {
+  std::vector<std::string> descriptions(subjects.size());
+  std::vector<PromptInputs> inputs;
+  inputs.reserve(subjects.size());
+  std::vector<std::uint64_t> cache_keys;
+  cache_keys.reserve(subjects.size());
+  // Indices of the subjects the cache could not answer.
+  std::vector<std::size_t> missing;
+  for (std::size_t i = 0; i < subjects.size(); ++i) {
+    inputs.push_back(LlmPrompt::collectPromptInputs(subjects[i].game_state,
+                                                    subjects[i].event));
+    cache_keys.push_back(LlmPrompt::promptKey(inputs.back()));
+    if (auto cached = cache_.get(cache_keys.back())) {
+      descriptions[i] = std::move(*cached);
+    } else {
+      missing.push_back(i);
+    }
+  }
+  if (missing.empty()) {
+    return descriptions;
+  }
+
+  const char *groq_api_key = std::getenv("GROQ_API_KEY");
+  if (!groq_api_key) {
+    spdlog::error("AI Adapter: GROQ_API_KEY environment variable not set.");
+    for (std::size_t i : missing) {
+      descriptions[i] = kFailedDescription + "(API Key Missing)";
     }
+    return descriptions;
+  }
 
+  if (missing.size() == 1) {
+    // Nothing to batch; a single event takes the plain prompt.
+    const std::size_t i = missing.front();
+    TextHandler on_delta;
+    if (on_chunk) {
+      on_delta = [&on_chunk, i](const std::string &text) {
+        on_chunk(i, text);
+      };
+    }
+    descriptions[i] =
+        describe(groq_api_key, inputs[i], cache_keys[i], on_delta);
+    return descriptions;
   }
 
-  else {
-    spdlog::error("AI Adapter: Failed to get response from LLM API. Status: "
-                  "{}, Error: {}",
-                  res ? res->status : 0,
-                  res ? res->body : "(no response body)");
+  spdlog::info("AI Adapter: Generating {} descriptions in one request.",
+               missing.size());
+
+  std::vector<const PromptInputs *> batch_inputs;
+  batch_inputs.reserve(missing.size());
+  for (std::size_t i : missing) {
+    batch_inputs.push_back(&inputs[i]);
+  }
 
-    return "An ancient, echoing chamber, but the magic seems to have failed. "
-           "(API Request Failed)";
+  TextHandler on_delta;
+  BatchStreamScanner scanner(
+      [&on_chunk, &missing](std::size_t j, const std::string &text) {
+        if (j < missing.size()) {
+          on_chunk(missing[j], text);
+        }
+      });
+  if (on_chunk) {
+    on_delta = [&scanner](const std::string &text) { scanner.feed(text); };
+  }
+  Completion completion = complete(
+      groq_api_key,
+      LlmPrompt::buildRequestBody(batch_inputs, static_cast<bool>(on_delta)),
+      on_delta);
+  if (!completion.ok) {
+    // The service itself failed; asking again per event would not help.
+    for (std::size_t i : missing) {
+      descriptions[i] = completion.content;
+    }
+    return descriptions;
   }
+
+  auto batch = parseBatchDescriptions(completion.content, missing.size());
+  if (!batch) {
+    // Not streamed again: the retried descriptions replace whatever the
+    // malformed answer streamed.
+    spdlog::warn("AI Adapter: Malformed batch response, describing {} events "
+                 "one by one.",
+                 missing.size());
+    for (std::size_t i : missing) {
+      descriptions[i] =
+          describe(groq_api_key, inputs[i], cache_keys[i], nullptr);
+    }
+    return descriptions;
+  }
+
+  spdlog::info("AI Adapter: Successfully generated {} descriptions.",
+               missing.size());
+  // Each entry is credited its share of the request it came from.
+  const auto latency_share =
+      completion.latency / static_cast<std::int64_t>(missing.size());
+  for (std::size_t j = 0; j < missing.size(); ++j) {
+    const std::size_t i = missing[j];
+    cache_.put(cache_keys[i], (*batch)[j], latency_share);
+    descriptions[i] = std::move((*batch)[j]);
+  }
+  return descriptions;
 }
+
 } // namespace Description
 } // namespace Out
 } // namespace Adapter
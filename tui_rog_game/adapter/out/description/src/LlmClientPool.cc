@@ -0,0 +1,127 @@
+#include "LlmClientPool.h"
+#include <algorithm>
+#include <httplib.h>
+#include <utility>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+
+LlmClientPool::Lease::Lease(Lease &&other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)),
+      client_(std::exchange(other.client_, nullptr)) {}
+
+LlmClientPool::Lease &LlmClientPool::Lease::operator=(Lease &&other) noexcept {
+  if (this != &other) {
+    if (pool_) {
+      pool_->release(client_);
+    }
+    pool_ = std::exchange(other.pool_, nullptr);
+    client_ = std::exchange(other.client_, nullptr);
+  }
+  return *this;
+}
+
+LlmClientPool::Lease::~Lease() {
+  if (pool_) {
+    pool_->release(client_);
+  }
+}
+
+LlmClientPool::LlmClientPool(const std::string &base_url,
+                             LlmClientPoolOptions options)
+    : created_at_(Clock::now()), last_change_(created_at_) {
+  const std::size_t size = std::max<std::size_t>(options.size, 1);
+  clients_.reserve(size);
+  idle_.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    auto client = std::make_unique<httplib::Client>(base_url);
+    client->set_keep_alive(options.keep_alive);
+    client->set_connection_timeout(3, 0);
+    client->set_read_timeout(5, 0);
+    client->set_write_timeout(3, 0);
+    clients_.push_back(std::move(client));
+  }
+  // Reversed, so the first client is lent first.
+  for (auto it = clients_.rbegin(); it != clients_.rend(); ++it) {
+    idle_.push_back(it->get());
+  }
+  stats_.size = size;
+}
+
+LlmClientPool::~LlmClientPool() = default;
+
+std::optional<LlmClientPool::Lease>
+LlmClientPool::acquire(Clock::time_point deadline) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (idle_.empty()) {
+    const Clock::time_point wait_start = Clock::now();
+    ++stats_.waits;
+    const bool freed = released_.wait_until(lock, deadline,
+                                            [this] { return !idle_.empty(); });
+    const Clock::time_point now = Clock::now();
+    stats_.wait_time += std::chrono::duration_cast<std::chrono::microseconds>(
+        now - wait_start);
+    if (!freed) {
+      ++stats_.timeouts;
+      return std::nullopt;
+    }
+    return lend(now);
+  }
+  return lend(Clock::now());
+}
+
+std::optional<LlmClientPool::Lease> LlmClientPool::tryAcquire() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (idle_.empty()) {
+    return std::nullopt;
+  }
+  return lend(Clock::now());
+}
+
+LlmClientPool::Lease LlmClientPool::lend(Clock::time_point now) {
+  accrueBusyTime(now);
+  httplib::Client *client = idle_.back();
+  idle_.pop_back();
+  ++stats_.acquisitions;
+  ++stats_.in_use;
+  stats_.peak_in_use = std::max(stats_.peak_in_use, stats_.in_use);
+  return Lease(this, client);
+}
+
+void LlmClientPool::release(httplib::Client *client) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    accrueBusyTime(Clock::now());
+    idle_.push_back(client);
+    --stats_.in_use;
+  }
+  released_.notify_one();
+}
+
+void LlmClientPool::accrueBusyTime(Clock::time_point now) {
+  busy_time_ += std::chrono::duration<double>(now - last_change_) *
+                static_cast<double>(stats_.in_use);
+  last_change_ = now;
+}
+
+LlmClientPool::Stats LlmClientPool::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  const Clock::time_point now = Clock::now();
+  const std::chrono::duration<double> busy =
+      busy_time_ + std::chrono::duration<double>(now - last_change_) *
+                       static_cast<double>(stats_.in_use);
+  const std::chrono::duration<double> lifetime = now - created_at_;
+  if (lifetime.count() > 0) {
+    stats.utilization =
+        busy.count() / (lifetime.count() * static_cast<double>(stats_.size));
+  }
+  return stats;
+}
+
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,203 @@
+#include "LlmPrompt.h"
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Description {
+namespace LlmPrompt {
+
+namespace {
+
+// FNV-1a. Strings are length-prefixed so field boundaries cannot shift.
+class PromptHasher {
+public:
+  void add(const void *data, std::size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      hash_ = (hash_ ^ bytes[i]) * 0x100000001B3ULL;
+    }
+  }
+  void add(int value) { add(&value, sizeof(value)); }
+  void add(const std::string &value) {
+    add(static_cast<int>(value.size()));
+    add(value.data(), value.size());
+  }
+  std::uint64_t value() const { return hash_; }
+
+private:
+  std::uint64_t hash_ = 0xCBF29CE484222325ULL;
+};
+
+// The event and the state it happened in, shared by single and batch
+// prompts.
+std::string buildEventContext(const PromptInputs &inputs) {
+  std::string prompt;
+
+  if (inputs.event_type == Domain::Event::DomainEvent::Type::PlayerDied) {
+      prompt += "플레이어가 방금 죽었지만, 신비한 힘으로 즉시 부활했습니다. "
+          "이 기적적인 부활의 순간을 묘사해주세요.\n";
+  }
+
+  prompt += "발생한 이벤트: " + inputs.event_text + ".\n";
+  prompt += "플레이어 정보: 레벨 " + std::to_string(inputs.level) +
+            ", 경험치 " + std::to_string(inputs.xp) + ", 체력 " +
+            std::to_string(inputs.hp) + "/" +
+            std::to_string(inputs.max_hp) + ".\n";
+
+  prompt += "인벤토리: ";
+
+  if (inputs.inventory.empty()) {
+    prompt += "비어있음.\n";
+  } else {
+    for (size_t i = 0; i < inputs.inventory.size(); ++i) {
+      prompt += inputs.inventory[i];
+
+      if (i < inputs.inventory.size() - 1) {
+        prompt += ", ";
+      }
+    }
+
+    prompt += ".\n";
+  }
+
+  const auto &nearby_elements = inputs.nearby_elements;
+  if (!nearby_elements.empty()) {
+    prompt += "현재 위치 (" + std::to_string(inputs.x) + ", " +
+              std::to_string(inputs.y) + ") 주변에는 ";
+
+    for (size_t i = 0; i < nearby_elements.size(); ++i) {
+      prompt += nearby_elements[i];
+
+      if (i < nearby_elements.size() - 1) {
+        prompt += ", ";
+      }
+    }
+
+    prompt += "이(가) 있습니다.\n";
+    prompt += "몬스터가 가까이 있다면 위협적인 분위기를, 아이템이 가까이 "
+              "있다면 흥미로운 발견을, 출구가 가까이 있다면 탈출 또는 다음 "
+              "단계로의 기회를 암시하는 묘사를 포함해주세요.\n";
+
+  } else {
+    prompt += "현재 위치 (" + std::to_string(inputs.x) + ", " +
+              std::to_string(inputs.y) + ") 주변에는 특별한 것이 없습니다.\n";
+  }
+  return prompt;
+}
+
+} // namespace
+
+PromptInputs collectPromptInputs(const Port::Out::GameStateDTO &game_state,
+                                 const Domain::Event::DomainEvent &event) {
+  const auto &player = game_state.player;
+  const auto &map = game_state.map;
+
+  PromptInputs inputs;
+  inputs.event_type = event.getType();
+  inputs.event_text = event.toString();
+  inputs.level = player.getLevel();
+  inputs.xp = player.getXp();
+  inputs.hp = player.getHp();
+  inputs.max_hp = player.getMaxHp();
+  for (const auto &item : player.getInventory()) {
+    inputs.inventory.push_back(item->getName());
+  }
+  inputs.x = player.getPosition().x;
+  inputs.y = player.getPosition().y;
+
+  for (int dy = -1; dy <= 1; ++dy) {
+    for (int dx = -1; dx <= 1; ++dx) {
+      if (dx == 0 && dy == 0)
+        continue; // 플레이어 자신 위치 제외
+
+      int nx = inputs.x + dx;
+      int ny = inputs.y + dy;
+
+      if (nx >= 0 && nx < map.getWidth() && ny >= 0 && ny < map.getHeight()) {
+        Domain::Model::Tile tile = map.getTile(nx, ny);
+
+        if (tile == Domain::Model::Tile::ENEMY) {
+          inputs.nearby_elements.push_back("몬스터");
+        } else if (tile == Domain::Model::Tile::ITEM) {
+          inputs.nearby_elements.push_back("아이템");
+        } else if (tile == Domain::Model::Tile::EXIT) {
+          inputs.nearby_elements.push_back("출구");
+        }
+      }
+    }
+  }
+  return inputs;
+}
+
+std::uint64_t promptKey(const PromptInputs &inputs) {
+  PromptHasher hasher;
+  hasher.add(std::string(kModel));
+  hasher.add(static_cast<int>(inputs.event_type));
+  hasher.add(inputs.event_text);
+  for (int value : {inputs.level, inputs.xp, inputs.hp, inputs.max_hp,
+                    inputs.x, inputs.y}) {
+    hasher.add(value);
+  }
+  hasher.add(static_cast<int>(inputs.inventory.size()));
+  for (const auto &name : inputs.inventory) {
+    hasher.add(name);
+  }
+  hasher.add(static_cast<int>(inputs.nearby_elements.size()));
+  for (const auto &element : inputs.nearby_elements) {
+    hasher.add(element);
+  }
+  return hasher.value();
+}
+
+std::string buildPrompt(const PromptInputs &inputs) {
+  return "당신은 던전 마스터입니다. 다음 게임 상태 정보와 발생한 이벤트를 "
+         "바탕으로 플레이어 주변 "
+         "상황을 한국어로 간결하고 생생하게 묘사해주세요. 묘사는 50단어 이내로 "
+         "해주세요.\n\n" +
+         buildEventContext(inputs);
+}
+
+std::string buildBatchPrompt(const std::vector<const PromptInputs *> &inputs) {
+  std::string prompt =
+      "당신은 던전 마스터입니다. 한 턴 동안 아래 " +
+      std::to_string(inputs.size()) +
+      "개의 이벤트가 순서대로 발생했습니다. 각 이벤트와 그 시점의 게임 상태 "
+      "정보를 바탕으로 플레이어 주변 상황을 한국어로 간결하고 생생하게 "
+      "묘사해주세요. 각 묘사는 50단어 이내로 해주세요.\n"
+      "응답은 {\"descriptions\": [\"...\"]} 형식의 JSON 객체 하나로만 "
+      "하고, descriptions 배열에는 이벤트 순서대로 정확히 " +
+      std::to_string(inputs.size()) + "개의 묘사를 넣어주세요.\n";
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    prompt += "\n[이벤트 " + std::to_string(i + 1) + "]\n";
+    prompt += buildEventContext(*inputs[i]);
+  }
+  return prompt;
+}
+
+std::string buildRequestBody(const std::vector<const PromptInputs *> &inputs,
+                             bool stream) {
+  nlohmann::json request_body;
+  request_body["model"] = kModel;
+  request_body["max_tokens"] = 150 * static_cast<int>(inputs.size());
+  request_body["temperature"] = 0.7;
+  if (inputs.size() == 1) {
+    request_body["messages"] = {
+        {{"role", "user"}, {"content", buildPrompt(*inputs.front())}}};
+  } else {
+    request_body["response_format"] = {{"type", "json_object"}};
+    request_body["messages"] = {
+        {{"role", "user"}, {"content", buildBatchPrompt(inputs)}}};
+  }
+  if (stream) {
+    request_body["stream"] = true;
+  }
+  return request_body.dump();
+}
+
+} // namespace LlmPrompt
+} // namespace Description
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,78 @@
+#include "DescriptionCache.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+using namespace TuiRogGame::Adapter::Out::Description;
+using namespace std::chrono_literals;
+
+namespace {
+
+DescriptionCacheOptions makeOptions(std::size_t capacity) {
+  DescriptionCacheOptions options;
+  options.capacity = capacity;
+  return options;
+}
+
+} // namespace
+
+TEST(DescriptionCacheTest, HitsCountSavedLatency) {
+  DescriptionCache cache(makeOptions(4));
+  ASSERT_FALSE(cache.get(1));
+  cache.put(1, "a dark corridor", 800ms);
+
+  ASSERT_EQ(cache.get(1), "a dark corridor");
+  ASSERT_EQ(cache.get(1), "a dark corridor");
+
+  const DescriptionCache::Stats stats = cache.getStats();
+  ASSERT_EQ(stats.hits, 2u);
+  ASSERT_EQ(stats.misses, 1u);
+  ASSERT_EQ(stats.saved_latency, 1600ms);
+  ASSERT_DOUBLE_EQ(stats.hitRate(), 2.0 / 3.0);
+}
+
+TEST(DescriptionCacheTest, EvictsLeastRecentlyUsed) {
+  DescriptionCache cache(makeOptions(2));
+  cache.put(1, "one", 1ms);
+  cache.put(2, "two", 1ms);
+  ASSERT_TRUE(cache.get(1)); // 2 is now the least recently used.
+  cache.put(3, "three", 1ms);
+
+  ASSERT_EQ(cache.size(), 2u);
+  ASSERT_TRUE(cache.get(1));
+  ASSERT_FALSE(cache.get(2));
+  ASSERT_TRUE(cache.get(3));
+  ASSERT_EQ(cache.getStats().evictions, 1u);
+}
+
+TEST(DescriptionCacheTest, ExpiresEntriesAfterTtl) {
+  DescriptionCacheOptions options = makeOptions(4);
+  options.ttl = std::chrono::seconds(0);
+  DescriptionCache cache(options);
+  cache.put(1, "stale", 1ms);
+
+  ASSERT_FALSE(cache.get(1));
+  ASSERT_EQ(cache.getStats().expirations, 1u);
+  ASSERT_EQ(cache.size(), 0u);
+}
+
+TEST(DescriptionCacheTest, PersistsEntriesAcrossInstances) {
+  const auto path =
+      std::filesystem::temp_directory_path() / "description_cache_test.json";
+  std::filesystem::remove(path);
+  DescriptionCacheOptions options = makeOptions(4);
+  options.persist_path = path.string();
+
+  {
+    DescriptionCache cache(options);
+    cache.put(1, "one", 5ms);
+    cache.put(2, "two", 7ms);
+  } // Written on destruction.
+
+  DescriptionCache reloaded(options);
+  ASSERT_EQ(reloaded.size(), 2u);
+  ASSERT_EQ(reloaded.get(2), "two");
+  ASSERT_EQ(reloaded.getStats().saved_latency, 7ms);
+  std::filesystem::remove(path);
+}
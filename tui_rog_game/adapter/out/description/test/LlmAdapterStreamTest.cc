@@ -0,0 +1,131 @@
+#include "LlmAdapter.h"
+#include "GameStateDTO.h"
+#include "Map.h"
+#include "MockLlmServer.h"
+#include "Player.h"
+#include "PlayerMovedEvent.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::Out::Description;
+using namespace TuiRogGame::Domain::Event;
+using namespace TuiRogGame::Domain::Model;
+using namespace TuiRogGame::Port::Out;
+
+// Streams from a local mock server, which hands out the configured chunks
+// verbatim.
+class LlmAdapterStreamTest : public ::testing::Test {
+protected:
+  void SetUp() override { setenv("GROQ_API_KEY", "test-key", 0); }
+
+  void respondWith(std::vector<std::string> chunks, bool finish = true) {
+    MockLlmServerOptions options;
+    options.chunks = std::move(chunks);
+    options.finish_stream = finish;
+    server_.setOptions(options);
+  }
+
+  std::vector<nlohmann::json> requests() const {
+    std::vector<nlohmann::json> requests;
+    for (const auto &body : server_.getRequestBodies()) {
+      requests.push_back(nlohmann::json::parse(body));
+    }
+    return requests;
+  }
+
+  LlmAdapter::Options streamingOptions() const {
+    LlmAdapter::Options options;
+    options.base_url = server_.getBaseUrl();
+    options.stream = true;
+    return options;
+  }
+
+  GameStateDTO game_state_{Map(10, 10), Player("p", Stats{}, {5, 5})};
+
+private:
+  MockLlmServer server_;
+};
+
+TEST_F(LlmAdapterStreamTest, StreamsASingleDescriptionChunkByChunk) {
+  respondWith({"어두운 ", "복도가 ", "이어집니다."});
+  LlmAdapter adapter(streamingOptions());
+  PlayerMovedEvent event({5, 5});
+
+  std::vector<std::string> chunks;
+  auto descriptions = adapter.streamDescriptions(
+      {{game_state_, event}},
+      [&chunks](std::size_t index, const std::string &chunk) {
+        EXPECT_EQ(index, 0u);
+        chunks.push_back(chunk);
+      });
+
+  ASSERT_EQ(descriptions,
+            (std::vector<std::string>{"어두운 복도가 이어집니다."}));
+  ASSERT_EQ(chunks,
+            (std::vector<std::string>{"어두운 ", "복도가 ", "이어집니다."}));
+  ASSERT_EQ(requests().size(), 1u);
+  ASSERT_TRUE(requests()[0].value("stream", false));
+}
+
+TEST_F(LlmAdapterStreamTest, StreamsEachBatchElementToItsEvent) {
+  // Chunk boundaries fall inside keys, strings and escapes alike.
+  respondWith({"{\"descr", "iptions\": [\"Fir", "st\\", "n one\", \"\\u00e9",
+               "t\\u00e9\"]}"});
+  LlmAdapter adapter(streamingOptions());
+  PlayerMovedEvent first({5, 5});
+  PlayerMovedEvent second({5, 6});
+
+  std::vector<std::string> streamed(2);
+  auto descriptions = adapter.streamDescriptions(
+      {{game_state_, first}, {game_state_, second}},
+      [&streamed](std::size_t index, const std::string &chunk) {
+        ASSERT_LT(index, streamed.size());
+        streamed[index] += chunk;
+      });
+
+  const std::vector<std::string> expected = {"First\n one", "été"};
+  ASSERT_EQ(descriptions, expected);
+  ASSERT_EQ(streamed, expected);
+  ASSERT_EQ(requests().size(), 1u);
+}
+
+TEST_F(LlmAdapterStreamTest, RejectsAStreamThatIsCutShort) {
+  respondWith({"The door "}, false);
+  LlmAdapter adapter(streamingOptions());
+  PlayerMovedEvent event({5, 5});
+
+  auto descriptions = adapter.streamDescriptions(
+      {{game_state_, event}}, [](std::size_t, const std::string &) {});
+
+  ASSERT_EQ(descriptions.size(), 1u);
+  ASSERT_NE(descriptions[0].find("(Invalid LLM Response)"), std::string::npos);
+
+  // Nothing incomplete was cached, so asking again makes a new request.
+  respondWith({"The door ", "creaks."});
+  descriptions = adapter.streamDescriptions(
+      {{game_state_, event}}, [](std::size_t, const std::string &) {});
+  ASSERT_EQ(descriptions, (std::vector<std::string>{"The door creaks."}));
+  ASSERT_EQ(requests().size(), 2u);
+}
+
+TEST_F(LlmAdapterStreamTest, DoesNotStreamUnlessEnabled) {
+  LlmAdapter::Options options = streamingOptions();
+  options.stream = false;
+  LlmAdapter adapter(options);
+  PlayerMovedEvent event({5, 5});
+
+  respondWith({"The door ", "creaks."});
+  std::size_t chunk_count = 0;
+  auto descriptions = adapter.streamDescriptions(
+      {{game_state_, event}},
+      [&chunk_count](std::size_t, const std::string &) { ++chunk_count; });
+
+  ASSERT_EQ(descriptions, (std::vector<std::string>{"The door creaks."}));
+  ASSERT_EQ(chunk_count, 0u);
+  ASSERT_EQ(requests().size(), 1u);
+  ASSERT_FALSE(requests()[0].contains("stream"));
+}
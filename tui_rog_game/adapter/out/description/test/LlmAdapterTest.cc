@@ -2,23 +2,40 @@
 #include "DomainEvent.h"
 #include "GameStateDTO.h"
 #include "Map.h"
+#include "MockLlmServer.h"
 #include "Player.h"
 #include "PlayerMovedEvent.h"
 #include "gtest/gtest.h"
+#include <chrono>
 #include <cstdlib>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <thread>
+#include <vector>
 
+using TuiRogGame::Adapter::Out::Description::LlmAdapter;
+using TuiRogGame::Adapter::Out::Description::MockLlmServer;
+using TuiRogGame::Adapter::Out::Description::MockLlmServerOptions;
+
+namespace {
+
+LlmAdapter::Options mockOptions(const MockLlmServer &server) {
+  LlmAdapter::Options options;
+  options.base_url = server.getBaseUrl();
+  options.cache.capacity = 0; // Every call reaches the server.
+  return options;
+}
+
+} // namespace
+
+// Runs against a local mock of the chat completions endpoint, so no network
+// access or real API key is needed.
 class LlmAdapterTest : public ::testing::Test {
 protected:
-  TuiRogGame::Adapter::Out::Description::LlmAdapter adapter;
-
-  void SetUp() override {
+  MockLlmServer server;
+  LlmAdapter adapter{mockOptions(server)};
 
-    if (std::getenv("GROQ_API_KEY") == nullptr) {
-      spdlog::warn("GROQ_API_KEY not set. Gemini API tests might fail.");
-    }
-  }
+  void SetUp() override { setenv("GROQ_API_KEY", "test-key", 0); }
 };
 
 TEST_F(LlmAdapterTest, GeneratesNonEmptyDescription) {
@@ -50,3 +67,124 @@ TEST_F(LlmAdapterTest, GeneratesNonEmptyDescription) {
   ASSERT_EQ(description.find("(API Request Failed)"), std::string::npos)
       << "Description indicates API Request Failed, but it should not.";
 }
+
+TEST_F(LlmAdapterTest, ReportsFailedRequests) {
+  MockLlmServerOptions options;
+  options.error_rate = 1.0;
+  server.setOptions(options);
+
+  TuiRogGame::Domain::Model::Player player(
+      "test_player", TuiRogGame::Domain::Model::Stats{},
+      TuiRogGame::Domain::Model::Position{5, 5});
+  TuiRogGame::Port::Out::GameStateDTO game_state(
+      TuiRogGame::Domain::Model::Map(10, 10), player);
+  TuiRogGame::Domain::Event::PlayerMovedEvent event(player.getPosition());
+
+  std::string description = adapter.generateDescription(game_state, event);
+  ASSERT_NE(description.find("(API Request Failed)"), std::string::npos);
+  ASSERT_EQ(server.getStats().errors, 1u);
+}
+
+TEST_F(LlmAdapterTest, ReusesOneConnectionAcrossRequests) {
+  TuiRogGame::Domain::Model::Player player(
+      "test_player", TuiRogGame::Domain::Model::Stats{},
+      TuiRogGame::Domain::Model::Position{5, 5});
+  TuiRogGame::Port::Out::GameStateDTO game_state(
+      TuiRogGame::Domain::Model::Map(10, 10), player);
+  TuiRogGame::Domain::Event::PlayerMovedEvent event(player.getPosition());
+
+  for (int i = 0; i < 3; ++i) {
+    adapter.generateDescription(game_state, event);
+  }
+  ASSERT_EQ(server.getStats().requests, 3u);
+  ASSERT_EQ(server.getStats().connections, 1u);
+}
+
+TEST_F(LlmAdapterTest, ServesConcurrentRequestsOnSeparateConnections) {
+  MockLlmServerOptions options;
+  options.latency = std::chrono::milliseconds(100);
+  server.setOptions(options);
+
+  TuiRogGame::Domain::Model::Player player(
+      "test_player", TuiRogGame::Domain::Model::Stats{},
+      TuiRogGame::Domain::Model::Position{5, 5});
+  TuiRogGame::Port::Out::GameStateDTO game_state(
+      TuiRogGame::Domain::Model::Map(10, 10), player);
+  TuiRogGame::Domain::Event::PlayerMovedEvent event(player.getPosition());
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(
+        [&] { adapter.generateDescription(game_state, event); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(server.getStats().requests, 4u);
+  ASSERT_EQ(server.getStats().connections, 4u);
+  const LlmAdapter::RequestStats stats = adapter.getRequestStats();
+  ASSERT_EQ(stats.requests, 4u);
+  ASSERT_EQ(stats.failures, 0u);
+  ASSERT_EQ(stats.pool.peak_in_use, 4u);
+  ASSERT_EQ(stats.pool.in_use, 0u);
+}
+
+TEST_F(LlmAdapterTest, HedgesARequestThatStalls) {
+  TuiRogGame::Domain::Model::Player player(
+      "test_player", TuiRogGame::Domain::Model::Stats{},
+      TuiRogGame::Domain::Model::Position{5, 5});
+  TuiRogGame::Port::Out::GameStateDTO game_state(
+      TuiRogGame::Domain::Model::Map(10, 10), player);
+  TuiRogGame::Domain::Event::PlayerMovedEvent event(player.getPosition());
+
+  // Enough quick answers to know what a slow one is.
+  for (int i = 0; i < 20; ++i) {
+    adapter.generateDescription(game_state, event);
+  }
+  ASSERT_EQ(adapter.getRequestStats().hedged, 0u);
+
+  MockLlmServerOptions options;
+  options.stall_next = 1;
+  options.stall = std::chrono::milliseconds(500);
+  server.setOptions(options);
+
+  const auto start = std::chrono::steady_clock::now();
+  std::string description = adapter.generateDescription(game_state, event);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_EQ(description, options.answer);
+  ASSERT_LT(elapsed, std::chrono::milliseconds(400));
+  ASSERT_EQ(server.getStats().requests, 22u);
+  const LlmAdapter::RequestStats stats = adapter.getRequestStats();
+  ASSERT_EQ(stats.hedged, 1u);
+  ASSERT_EQ(stats.hedge_wins, 1u);
+}
+
+TEST_F(LlmAdapterTest, GivesUpWhenTheTimeoutRunsOut) {
+  MockLlmServerOptions server_options;
+  server_options.latency = std::chrono::milliseconds(500);
+  server.setOptions(server_options);
+
+  LlmAdapter::Options options = mockOptions(server);
+  options.timeout = std::chrono::milliseconds(100);
+  LlmAdapter impatient_adapter(options);
+
+  TuiRogGame::Domain::Model::Player player(
+      "test_player", TuiRogGame::Domain::Model::Stats{},
+      TuiRogGame::Domain::Model::Position{5, 5});
+  TuiRogGame::Port::Out::GameStateDTO game_state(
+      TuiRogGame::Domain::Model::Map(10, 10), player);
+  TuiRogGame::Domain::Event::PlayerMovedEvent event(player.getPosition());
+
+  const auto start = std::chrono::steady_clock::now();
+  std::string description =
+      impatient_adapter.generateDescription(game_state, event);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_NE(description.find("(API Request Timed Out)"), std::string::npos);
+  ASSERT_LT(elapsed, std::chrono::milliseconds(400));
+  const LlmAdapter::RequestStats stats = impatient_adapter.getRequestStats();
+  ASSERT_EQ(stats.timeouts, 1u);
+  ASSERT_EQ(stats.failures, 1u);
+}
@@ -0,0 +1,92 @@
+#include "GameStateDTO.h"
+#include "Goblin.h"
+#include "InMemoryAdapter.h"
+#include "Item.h"
+#include "Map.h"
+#include "Player.h"
+#include "Rng.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <utility>
+#include <vector>
+
+namespace {
+void addCounters(benchmark::State &state, uint64_t cnt) {
+  state.counters["OPS"] = benchmark::Counter(cnt, benchmark::Counter::kIsRate);
+  state.counters["Latency"] = benchmark::Counter(
+      cnt, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+} // namespace
+
+namespace TuiRogGame {
+namespace Benchmark {
+
+struct BenchmarkInitializer {
+  BenchmarkInitializer() { spdlog::set_level(spdlog::level::off); }
+};
+static BenchmarkInitializer benchmark_initializer;
+
+// A generated side x side map with an enemy and an item on every 16th floor
+// tile, so entity tables grow with the map.
+Port::Out::GameStateDTO createGameState(int side) {
+  Domain::Model::Map map(side, side);
+  Domain::Model::Rng rng(static_cast<std::uint64_t>(side));
+  map.generate(rng);
+  int floor_tiles = 0;
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      if (!map.isWalkable(x, y) || floor_tiles++ % 16 != 0) {
+        continue;
+      }
+      const Domain::Model::Position position{x, y};
+      if (floor_tiles % 32 == 1) {
+        map.addEnemy(position,
+                     std::make_unique<Domain::Model::Goblin>(position));
+      } else {
+        map.addItem(position, std::make_unique<Domain::Model::Item>(
+                                  Domain::Model::Item::ItemType::HealthPotion,
+                                  "Small Health Potion"));
+      }
+    }
+  }
+  Domain::Model::Player player("player1", Domain::Model::Stats{},
+                               map.getStartPlayerPosition());
+  map.clearChanges();
+  player.clearChanges();
+  return Port::Out::GameStateDTO(std::move(map), std::move(player));
+}
+
+// One save and one load per iteration, the persistence work of a simulated
+// turn. Snapshots share the map, so the cost should not grow with its size.
+static void BM_InMemoryAdapter_SaveLoad(benchmark::State &state) {
+  const Port::Out::GameStateDTO game_state =
+      createGameState(static_cast<int>(state.range(0)));
+  Adapter::Out::Persistence::InMemoryAdapter adapter;
+  for (auto _ : state) {
+    adapter.saveGameState(game_state);
+    auto loaded_state = adapter.loadGameState();
+    benchmark::DoNotOptimize(loaded_state);
+  }
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_InMemoryAdapter_SaveLoad)->RangeMultiplier(4)->Range(32, 512);
+
+// Saving a full history, then rolling all of it back.
+static void BM_InMemoryAdapter_Rollback(benchmark::State &state) {
+  const Port::Out::GameStateDTO game_state = createGameState(128);
+  const auto history = static_cast<std::size_t>(state.range(0));
+  Adapter::Out::Persistence::InMemoryAdapter adapter(history);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < history; ++i) {
+      adapter.saveGameState(game_state);
+    }
+    adapter.rollback(history - 1);
+  }
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_InMemoryAdapter_Rollback)->Arg(4)->Arg(16)->Arg(64);
+
+} // namespace Benchmark
+} // namespace TuiRogGame
@@ -1,27 +1,50 @@
 #pragma once
 
+#include "GameStateDTO.h"
 #include "ILoadGameStatePort.h"
 #include "ISaveGameStatePort.h"
+#include <cstddef>
+#include <deque>
 #include <memory>
-#include <optional>
+#include <mutex>
 
 namespace TuiRogGame {
 namespace Adapter {
 namespace Out {
 namespace Persistence {
 
+// Keeps saved games as immutable snapshots. A snapshot's map shares its tiles
+// and entities with the map it was saved from (see Map), so saving and
+// loading copy no grid or entity table; only the player's inventory is
+// copied. The last history_limit saves are kept for rollback.
 class InMemoryAdapter : public Port::Out::ISaveGameStatePort,
                         public Port::Out::ILoadGameStatePort {
 public:
-  InMemoryAdapter() = default;
+  static constexpr std::size_t kDefaultHistoryLimit = 16;
+
+  // A limit of 0 is treated as 1: the latest save is always kept.
+  explicit InMemoryAdapter(std::size_t history_limit = kDefaultHistoryLimit);
   ~InMemoryAdapter() override = default;
 
   void
   saveGameState(const TuiRogGame::Port::Out::GameStateDTO &gameState) override;
   std::unique_ptr<TuiRogGame::Port::Out::GameStateDTO> loadGameState() override;
 
+  // The save `saves_back` saves before the latest (0 is the latest), or
+  // nullptr if the history does not reach that far.
+  std::shared_ptr<const Port::Out::GameStateDTO>
+  getSnapshot(std::size_t saves_back = 0) const;
+  std::size_t getHistorySize() const;
+
+  // Discards the latest `saves` saves, so loads return the one before them.
+  // Returns false, discarding nothing, unless an older save remains.
+  bool rollback(std::size_t saves = 1);
+
 private:
-  std::optional<TuiRogGame::Port::Out::GameStateDTO> stored_game_state_;
+  const std::size_t history_limit_;
+  mutable std::mutex mutex_;
+  // Oldest first.
+  std::deque<std::shared_ptr<const Port::Out::GameStateDTO>> history_;
 };
 
 } // namespace Persistence
@@ -1,31 +1,84 @@
 #include "InMemoryAdapter.h"
-#include "GameStateDTO.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <spdlog/spdlog.h>
+#include <utility>
 
 namespace TuiRogGame {
 namespace Adapter {
 namespace Out {
 namespace Persistence {
 
+InMemoryAdapter::InMemoryAdapter(std::size_t history_limit)
+    : history_limit_(std::max<std::size_t>(history_limit, 1)) {}
+
 void InMemoryAdapter::saveGameState(
     const TuiRogGame::Port::Out::GameStateDTO &gameState) {
-  stored_game_state_.emplace(gameState);
+  auto snapshot = std::make_shared<TuiRogGame::Port::Out::GameStateDTO>(
+      gameState);
+  // Change sets describe the save interval that just ended; a snapshot loads
+  // as a whole game, like one read back from storage.
+  snapshot->map.markFullyChanged();
+  snapshot->player.markFullyChanged();
+
+  std::shared_ptr<const TuiRogGame::Port::Out::GameStateDTO> evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    history_.push_back(std::move(snapshot));
+    if (history_.size() > history_limit_) {
+      // Released outside the lock: the last reference frees the tiles and
+      // entities no newer snapshot shares.
+      evicted = std::move(history_.front());
+      history_.pop_front();
+    }
+  }
   spdlog::info("[InMemoryAdapter] Game saved.");
 }
 
 std::unique_ptr<TuiRogGame::Port::Out::GameStateDTO>
 InMemoryAdapter::loadGameState() {
-  if (stored_game_state_) {
+  auto snapshot = getSnapshot();
+  if (snapshot) {
 
     spdlog::info("[InMemoryAdapter] Game loaded.");
-    return std::make_unique<TuiRogGame::Port::Out::GameStateDTO>(
-        *stored_game_state_);
+    return std::make_unique<TuiRogGame::Port::Out::GameStateDTO>(*snapshot);
   } else {
     spdlog::info("[InMemoryAdapter] No game found to load.");
     return nullptr;
   }
 }
 
+std::shared_ptr<const Port::Out::GameStateDTO>
+InMemoryAdapter::getSnapshot(std::size_t saves_back) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (saves_back >= history_.size()) {
+    return nullptr;
+  }
+  return history_[history_.size() - 1 - saves_back];
+}
+
+std::size_t InMemoryAdapter::getHistorySize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return history_.size();
+}
+
+bool InMemoryAdapter::rollback(std::size_t saves) {
+  std::deque<std::shared_ptr<const Port::Out::GameStateDTO>> discarded;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (saves >= history_.size()) {
+      return false;
+    }
+    const auto first = history_.end() - static_cast<std::ptrdiff_t>(saves);
+    discarded.assign(std::make_move_iterator(first),
+                     std::make_move_iterator(history_.end()));
+    history_.erase(first, history_.end());
+  }
+  spdlog::info("[InMemoryAdapter] Rolled back {} save(s).", saves);
+  return true;
+}
+
 } // namespace Persistence
 } // namespace Out
 } // namespace Adapter
@@ -0,0 +1,77 @@
+#include "InMemoryAdapter.h"
+#include "GameStateDTO.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+using namespace TuiRogGame::Port::Out;
+
+namespace {
+
+GameStateDTO makeState() {
+  Map map(10, 10, {0, 0}, std::vector<Tile>(100, Tile::FLOOR), {}, {});
+  Player player("p", Stats{}, {0, 0});
+  map.clearChanges();
+  player.clearChanges();
+  return GameStateDTO(std::move(map), std::move(player));
+}
+
+} // namespace
+
+TEST(InMemoryAdapterTest, LoadsNothingBeforeFirstSave) {
+  InMemoryAdapter adapter;
+  ASSERT_EQ(adapter.loadGameState(), nullptr);
+  ASSERT_EQ(adapter.getHistorySize(), 0u);
+}
+
+TEST(InMemoryAdapterTest, SaveAndLoadShareTheTileGrid) {
+  InMemoryAdapter adapter;
+  GameStateDTO state = makeState();
+  state.player.moveTo({3, 4});
+  adapter.saveGameState(state);
+
+  auto loaded = adapter.loadGameState();
+  ASSERT_NE(loaded, nullptr);
+  ASSERT_EQ(loaded->player.getPosition(), (Position{3, 4}));
+  ASSERT_EQ(loaded->map.getTiles().data(), state.map.getTiles().data());
+  // Loaded as a whole game, whatever the saved change sets were.
+  ASSERT_TRUE(loaded->map.getChanges().full);
+  ASSERT_TRUE(loaded->player.getChanges().full);
+
+  // Changing the loaded map leaves the snapshot untouched.
+  loaded->map.setTile(1, 1, Tile::WALL);
+  ASSERT_EQ(adapter.getSnapshot()->map.getTile(1, 1), Tile::FLOOR);
+}
+
+TEST(InMemoryAdapterTest, KeepsOnlyTheLastSavesUpToTheLimit) {
+  InMemoryAdapter adapter(3);
+  GameStateDTO state = makeState();
+  for (int x = 1; x <= 5; ++x) {
+    state.player.moveTo({x, 0});
+    adapter.saveGameState(state);
+  }
+
+  ASSERT_EQ(adapter.getHistorySize(), 3u);
+  ASSERT_EQ(adapter.getSnapshot(0)->player.getPosition(), (Position{5, 0}));
+  ASSERT_EQ(adapter.getSnapshot(2)->player.getPosition(), (Position{3, 0}));
+  ASSERT_EQ(adapter.getSnapshot(3), nullptr);
+}
+
+TEST(InMemoryAdapterTest, RollbackRestoresAnEarlierSave) {
+  InMemoryAdapter adapter;
+  GameStateDTO state = makeState();
+  for (int x = 1; x <= 3; ++x) {
+    state.player.moveTo({x, 0});
+    adapter.saveGameState(state);
+  }
+
+  ASSERT_TRUE(adapter.rollback(2));
+  ASSERT_EQ(adapter.getHistorySize(), 1u);
+  ASSERT_EQ(adapter.loadGameState()->player.getPosition(), (Position{1, 0}));
+
+  // The only remaining save cannot be rolled back.
+  ASSERT_FALSE(adapter.rollback());
+  ASSERT_EQ(adapter.getHistorySize(), 1u);
+}
@@ -1,21 +1,34 @@
 #include "Enemy.h"
+#include "EnemyRepository.h"
+#include "EntityCodec.h"
 #include "GameStateDTO.h"
 #include "Goblin.h"
 #include "ILoadGameStatePort.h"
 #include "ISaveGameStatePort.h"
 #include "Item.h"
+#include "ItemRepository.h"
 #include "LevelDbAdapter.h"
+#include "LevelDbProvider.h"
 #include "Map.h"
+#include "MapCodec.h"
+#include "MapDimensions.h"
+#include "MapRepository.h"
 #include "Orc.h"
 #include "Player.h"
 #include "PlayerCoreStats.h"
 #include "Position.h"
+#include "Rng.h"
+#include "StandardLayoutCrudRepository.h"
 #include "Stats.h"
+#include <algorithm>
 #include <benchmark/benchmark.h>
+#include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -34,7 +47,8 @@ struct BenchmarkInitializer {
 };
 static BenchmarkInitializer benchmark_initializer;
 
-Port::Out::GameStateDTO createDummyGameState() {
+Port::Out::GameStateDTO createDummyGameState(int mapWidth = 50,
+                                             int mapHeight = 50) {
 
   Domain::Model::Stats playerStats{20, 15, 10, 25};
   Domain::Model::Position playerPos{5, 5};
@@ -49,35 +63,38 @@ Port::Out::GameStateDTO createDummyGameState() {
   Domain::Model::Player player("player1", playerCoreStats, playerStats,
                                playerPos, std::move(playerInventory));
 
-  int mapWidth = 50;
-  int mapHeight = 50;
   Domain::Model::Position startPlayerPos{0, 0};
-  std::vector<std::vector<Domain::Model::Tile>> tiles(
-      mapHeight,
-      std::vector<Domain::Model::Tile>(mapWidth, Domain::Model::Tile::FLOOR));
+  std::vector<Domain::Model::Tile> tiles(mapWidth * mapHeight,
+                                         Domain::Model::Tile::FLOOR);
+  auto tileAt = [&](int x, int y) -> Domain::Model::Tile & {
+    return tiles[y * mapWidth + x];
+  };
 
   for (int i = 0; i < mapWidth; ++i) {
-    tiles[0][i] = Domain::Model::Tile::WALL;
-    tiles[mapHeight - 1][i] = Domain::Model::Tile::WALL;
+    tileAt(i, 0) = Domain::Model::Tile::WALL;
+    tileAt(i, mapHeight - 1) = Domain::Model::Tile::WALL;
   }
   for (int i = 0; i < mapHeight; ++i) {
-    tiles[i][0] = Domain::Model::Tile::WALL;
-    tiles[i][mapWidth - 1] = Domain::Model::Tile::WALL;
+    tileAt(0, i) = Domain::Model::Tile::WALL;
+    tileAt(mapWidth - 1, i) = Domain::Model::Tile::WALL;
   }
-  tiles[10][10] = Domain::Model::Tile::EXIT;
+  tileAt(10, 10) = Domain::Model::Tile::EXIT;
 
-  std::map<Domain::Model::Position, std::unique_ptr<Domain::Model::Enemy>>
+  std::vector<std::pair<Domain::Model::Position,
+                        std::unique_ptr<Domain::Model::Enemy>>>
       enemies;
 
-  enemies.emplace(
+  enemies.emplace_back(
       Domain::Model::Position{1, 1},
       std::make_unique<Domain::Model::Goblin>(Domain::Model::Position{1, 1}));
-  enemies.emplace(Domain::Model::Position{2, 2},
-                  std::make_unique<Domain::Model::Orc>(
-                      Domain::Model::Position{2, 2})); // Example Orc
+  enemies.emplace_back(Domain::Model::Position{2, 2},
+                       std::make_unique<Domain::Model::Orc>(
+                           Domain::Model::Position{2, 2})); // Example Orc
 
-  std::map<Domain::Model::Position, std::unique_ptr<Domain::Model::Item>> items;
-  items.emplace(
+  std::vector<
+      std::pair<Domain::Model::Position, std::unique_ptr<Domain::Model::Item>>>
+      items;
+  items.emplace_back(
       Domain::Model::Position{3, 3},
       std::make_unique<Domain::Model::Item>(
           Domain::Model::Item::ItemType::HealthPotion, "Large Health Potion"));
@@ -94,18 +111,22 @@ public:
   void SetUp(const ::benchmark::State &state) override {
     db_path_ = std::filesystem::temp_directory_path() / "leveldb_benchmark_db";
     std::filesystem::remove_all(db_path_); // Clean up previous runs
-    adapter_ = std::make_unique<Adapter::Out::Persistence::LevelDbAdapter>(
+    provider_ = std::make_shared<Adapter::Out::Persistence::LevelDbProvider>(
         db_path_.string());
+    adapter_ =
+        std::make_unique<Adapter::Out::Persistence::LevelDbAdapter>(provider_);
     dummy_game_state_ =
         std::make_unique<Port::Out::GameStateDTO>(createDummyGameState());
   }
 
   void TearDown(const ::benchmark::State &state) override {
     adapter_.reset(); // Close DB before removing directory
+    provider_.reset();
     std::filesystem::remove_all(db_path_);
   }
 
 protected:
+  std::shared_ptr<Adapter::Out::Persistence::LevelDbProvider> provider_;
   std::unique_ptr<Adapter::Out::Persistence::LevelDbAdapter> adapter_;
   std::filesystem::path db_path_;
   std::unique_ptr<Port::Out::GameStateDTO> dummy_game_state_;
@@ -161,6 +182,621 @@ BENCHMARK_F(LevelDbAdapterFixture, BM_LevelDbAdapter_LoadGame_Port)
   addCounters(state, state.iterations());
 }
 
+// A side x side room holding entity_count enemies (Goblins and Orcs in turn)
+// and as many items, each on its own floor tile.
+Port::Out::GameStateDTO createPopulatedGameState(int side, int entity_count) {
+  Port::Out::GameStateDTO game_state = createDummyGameState(side, side);
+  const int interior = side - 2;
+
+  std::vector<Domain::Model::Tile> tiles(game_state.map.getTiles().begin(),
+                                         game_state.map.getTiles().end());
+  std::vector<std::pair<Domain::Model::Position,
+                        std::unique_ptr<Domain::Model::Enemy>>>
+      enemies;
+  std::vector<
+      std::pair<Domain::Model::Position, std::unique_ptr<Domain::Model::Item>>>
+      items;
+  for (int i = 0; i < 2 * entity_count; ++i) {
+    Domain::Model::Position position{1 + i % interior, 1 + i / interior};
+    tiles[position.y * side + position.x] = Domain::Model::Tile::FLOOR;
+    if (i < entity_count) {
+      if (i % 2 == 0) {
+        enemies.emplace_back(
+            position, std::make_unique<Domain::Model::Goblin>(position));
+      } else {
+        enemies.emplace_back(position,
+                             std::make_unique<Domain::Model::Orc>(position));
+      }
+    } else {
+      items.emplace_back(position,
+                         std::make_unique<Domain::Model::Item>(
+                             Domain::Model::Item::ItemType::HealthPotion,
+                             "Small Health Potion"));
+    }
+  }
+
+  Domain::Model::Map map(side, side, {side - 2, side - 2}, std::move(tiles),
+                         std::move(enemies), std::move(items));
+  return Port::Out::GameStateDTO(std::move(map),
+                                 std::move(game_state.player));
+}
+
+// Loading a 128x128 map whose enemy and item counts are the argument; the
+// whole map is read by one prefix scan whatever the count. Each load uses a
+// new adapter, so it reads and validates every record rather than returning
+// the state the writing adapter cached.
+BENCHMARK_DEFINE_F(LevelDbAdapterFixture, BM_LevelDbAdapter_LoadGame_Entities)
+(benchmark::State &state) {
+  const int entity_count = static_cast<int>(state.range(0));
+  adapter_->saveGameState(createPopulatedGameState(128, entity_count));
+
+  for (auto _ : state) {
+    std::unique_ptr<Port::Out::GameStateDTO> loaded_state =
+        Adapter::Out::Persistence::LevelDbAdapter(provider_).loadGameState();
+    benchmark::DoNotOptimize(loaded_state);
+  }
+
+  addCounters(state, state.iterations());
+  state.counters["EntitiesPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * 2 * entity_count,
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK_REGISTER_F(LevelDbAdapterFixture,
+                     BM_LevelDbAdapter_LoadGame_Entities)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
+// Loading again the game the adapter last loaded, with no save in between:
+// only the manifest is read, and the cached state is copied instead of
+// parsing the records.
+BENCHMARK_DEFINE_F(LevelDbAdapterFixture, BM_LevelDbAdapter_LoadGame_Resume)
+(benchmark::State &state) {
+  const int entity_count = static_cast<int>(state.range(0));
+  adapter_->saveGameState(createPopulatedGameState(128, entity_count));
+  benchmark::DoNotOptimize(adapter_->loadGameState());
+
+  for (auto _ : state) {
+    std::unique_ptr<Port::Out::GameStateDTO> loaded_state =
+        adapter_->loadGameState();
+    benchmark::DoNotOptimize(loaded_state);
+  }
+
+  addCounters(state, state.iterations());
+  state.counters["EntitiesPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * 2 * entity_count,
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK_REGISTER_F(LevelDbAdapterFixture, BM_LevelDbAdapter_LoadGame_Resume)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
+// One simulated turn: the player steps and a tile near them changes, which is
+// the typical footprint of a move or an item pickup.
+void mutateForTurn(Port::Out::GameStateDTO &game_state, int64_t turn) {
+  int x = 1 + static_cast<int>(turn % (game_state.map.getWidth() - 2));
+  game_state.player.moveTo({x, 5});
+  game_state.map.setTile(x, 6,
+                         turn % 2 == 0 ? Domain::Model::Tile::FLOOR
+                                       : Domain::Model::Tile::WALL);
+}
+
+BENCHMARK_DEFINE_F(LevelDbAdapterFixture, BM_LevelDbAdapter_SaveGame_Full)
+(benchmark::State &state) {
+  const int side = static_cast<int>(state.range(0));
+  Port::Out::GameStateDTO game_state = createDummyGameState(side, side);
+  int64_t turn = 0;
+  for (auto _ : state) {
+    mutateForTurn(game_state, turn++);
+    game_state.map.markFullyChanged();
+    game_state.player.markFullyChanged();
+    adapter_->saveGameState(game_state);
+  }
+
+  addCounters(state, state.iterations());
+}
+BENCHMARK_REGISTER_F(LevelDbAdapterFixture, BM_LevelDbAdapter_SaveGame_Full)
+    ->Arg(32)
+    ->Arg(128)
+    ->Arg(512);
+
+BENCHMARK_DEFINE_F(LevelDbAdapterFixture,
+                   BM_LevelDbAdapter_SaveGame_Incremental)
+(benchmark::State &state) {
+  const int side = static_cast<int>(state.range(0));
+  Port::Out::GameStateDTO game_state = createDummyGameState(side, side);
+  adapter_->saveGameState(game_state); // Baseline full save
+  game_state.map.clearChanges();
+  game_state.player.clearChanges();
+
+  int64_t turn = 0;
+  for (auto _ : state) {
+    mutateForTurn(game_state, turn++);
+    adapter_->saveGameState(game_state);
+    game_state.map.clearChanges();
+    game_state.player.clearChanges();
+  }
+
+  addCounters(state, state.iterations());
+}
+BENCHMARK_REGISTER_F(LevelDbAdapterFixture,
+                     BM_LevelDbAdapter_SaveGame_Incremental)
+    ->Arg(32)
+    ->Arg(128)
+    ->Arg(512);
+
+// A database directory that is removed before and after use.
+class ScratchDbPath {
+public:
+  explicit ScratchDbPath(const std::string &name)
+      : path_(std::filesystem::temp_directory_path() / name) {
+    std::filesystem::remove_all(path_);
+  }
+  ~ScratchDbPath() { std::filesystem::remove_all(path_); }
+
+  std::string string() const { return path_.string(); }
+
+private:
+  std::filesystem::path path_;
+};
+
+constexpr std::size_t kMiB = 1024 * 1024;
+
+// The per-turn save pattern of a game on a 128x128 map under different
+// write-side options.
+// Args: write buffer MiB, Snappy compression on/off, sync on/off.
+static void BM_LevelDbOptions_SaveTurns(benchmark::State &state) {
+  Adapter::Out::Persistence::LevelDbOptions options;
+  options.write_buffer_bytes = static_cast<std::size_t>(state.range(0)) * kMiB;
+  options.compression = state.range(1) != 0;
+  options.sync = state.range(2) != 0;
+
+  ScratchDbPath db_path("leveldb_options_save_db");
+  Adapter::Out::Persistence::LevelDbAdapter adapter(db_path.string(), "main",
+                                                    options);
+  Port::Out::GameStateDTO game_state = createDummyGameState(128, 128);
+  adapter.saveGameState(game_state); // Baseline full save
+  game_state.map.clearChanges();
+  game_state.player.clearChanges();
+
+  int64_t turn = 0;
+  for (auto _ : state) {
+    mutateForTurn(game_state, turn++);
+    adapter.saveGameState(game_state);
+    game_state.map.clearChanges();
+    game_state.player.clearChanges();
+  }
+
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_LevelDbOptions_SaveTurns)
+    ->ArgsProduct({{4, 32}, {0, 1}, {0, 1}})
+    ->ArgNames({"write_buffer_mib", "snappy", "sync"});
+
+// Loading games from a database that was written and reopened, so reads go
+// through table files rather than the memtable. Every load also probes for
+// legacy records that do not exist.
+// Args: block cache MiB, bloom filter bits per key, Snappy compression.
+static void BM_LevelDbOptions_LoadGame(benchmark::State &state) {
+  constexpr int kSessions = 64;
+  Adapter::Out::Persistence::LevelDbOptions options;
+  options.block_cache_bytes = static_cast<std::size_t>(state.range(0)) * kMiB;
+  options.bloom_bits_per_key = static_cast<int>(state.range(1));
+  options.compression = state.range(2) != 0;
+
+  ScratchDbPath db_path("leveldb_options_load_db");
+  {
+    auto writer = std::make_shared<Adapter::Out::Persistence::LevelDbProvider>(
+        db_path.string(), options);
+    Port::Out::GameStateDTO game_state = createDummyGameState(128, 128);
+    for (int session = 0; session < kSessions; ++session) {
+      Adapter::Out::Persistence::LevelDbAdapter(
+          writer, "session" + std::to_string(session))
+          .saveGameState(game_state);
+    }
+  }
+
+  auto reader = std::make_shared<Adapter::Out::Persistence::LevelDbProvider>(
+      db_path.string(), options);
+  std::vector<std::string> sessions;
+  for (int session = 0; session < kSessions; ++session) {
+    sessions.push_back("session" + std::to_string(session));
+  }
+
+  // A new adapter per load, so none is answered from an adapter's cache.
+  std::size_t next = 0;
+  for (auto _ : state) {
+    auto loaded_state = Adapter::Out::Persistence::LevelDbAdapter(
+                            reader, sessions[next++ % kSessions])
+                            .loadGameState();
+    benchmark::DoNotOptimize(loaded_state);
+  }
+
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_LevelDbOptions_LoadGame)
+    ->ArgsProduct({{1, 8, 64}, {0, 10}, {0, 1}})
+    ->ArgNames({"cache_mib", "bloom_bits", "snappy"});
+
+// One database shared by every thread of the parallel save benchmark; it lives
+// until the process exits so all runs append to the same tables.
+struct SharedSaveDb {
+  ScratchDbPath path{"leveldb_parallel_save_db"};
+  std::shared_ptr<Adapter::Out::Persistence::LevelDbProvider> provider =
+      std::make_shared<Adapter::Out::Persistence::LevelDbProvider>(
+          path.string());
+};
+
+// Independent sessions saving per-turn changes from their own threads into
+// one database, the way server mode saves. Each thread owns its adapter, and
+// so its batches; LevelDB merges the concurrent commits.
+static void BM_LevelDbProvider_ParallelSaves(benchmark::State &state) {
+  static SharedSaveDb db;
+  Adapter::Out::Persistence::LevelDbAdapter adapter(
+      db.provider, "writer" + std::to_string(state.thread_index()));
+  Port::Out::GameStateDTO game_state = createDummyGameState(64, 64);
+  adapter.saveGameState(game_state); // Baseline full save
+  game_state.map.clearChanges();
+  game_state.player.clearChanges();
+
+  int64_t turn = 0;
+  for (auto _ : state) {
+    mutateForTurn(game_state, turn++);
+    adapter.saveGameState(game_state);
+    game_state.map.clearChanges();
+    game_state.player.clearChanges();
+  }
+
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_LevelDbProvider_ParallelSaves)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Tile plane of a generated 256x256 map, encoded the way MapRepository stored
+// it before the binary format (nested JSON rows) versus the chunked codec.
+static void BM_MapTiles_LegacyJson_RoundTrip(benchmark::State &state) {
+  Domain::Model::Map map(256, 256);
+  Domain::Model::Rng rng(256); // Same map, and byte counts, on every run.
+  map.generate(rng);
+  std::size_t encoded_bytes = 0;
+  for (auto _ : state) {
+    nlohmann::json rows = nlohmann::json::array();
+    for (int y = 0; y < map.getHeight(); ++y) {
+      nlohmann::json row = nlohmann::json::array();
+      for (int x = 0; x < map.getWidth(); ++x) {
+        row.push_back(static_cast<int>(map.getTile(x, y)));
+      }
+      rows.push_back(row);
+    }
+    std::string encoded = nlohmann::json{{"tiles", rows}}.dump();
+    encoded_bytes = encoded.size();
+
+    nlohmann::json parsed = nlohmann::json::parse(encoded);
+    std::vector<Domain::Model::Tile> tiles;
+    for (const auto &row_json : parsed["tiles"]) {
+      for (const auto &tile_json : row_json) {
+        tiles.push_back(static_cast<Domain::Model::Tile>(tile_json.get<int>()));
+      }
+    }
+    benchmark::DoNotOptimize(tiles.data());
+  }
+  state.counters["Bytes"] = static_cast<double>(encoded_bytes);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_MapTiles_LegacyJson_RoundTrip);
+
+static void BM_MapTiles_Binary_RoundTrip(benchmark::State &state) {
+  constexpr std::size_t kChunk =
+      Adapter::Out::Persistence::MapRepository::kTileChunkSize;
+  Domain::Model::Map map(256, 256);
+  Domain::Model::Rng rng(256); // Same map, and byte counts, on every run.
+  map.generate(rng);
+  const Domain::Model::TileGridView view = map.getTiles();
+  std::size_t encoded_bytes = 0;
+  for (auto _ : state) {
+    std::vector<std::string> chunks;
+    encoded_bytes = 0;
+    for (std::size_t begin = 0; begin < view.size(); begin += kChunk) {
+      chunks.push_back(Adapter::Out::Persistence::MapCodec::encodeTileChunk(
+          view.data() + begin, std::min(kChunk, view.size() - begin)));
+      encoded_bytes += chunks.back().size();
+    }
+
+    std::vector<Domain::Model::Tile> tiles(view.size());
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+      const std::size_t begin = i * kChunk;
+      Adapter::Out::Persistence::MapCodec::decodeTileChunk(
+          chunks[i], tiles.data() + begin,
+          std::min(kChunk, view.size() - begin));
+    }
+    benchmark::DoNotOptimize(tiles.data());
+  }
+  state.counters["Bytes"] = static_cast<double>(encoded_bytes);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_MapTiles_Binary_RoundTrip);
+
+// Per-entity record cost: the JSON objects the repositories wrote before
+// EntityCodec versus the binary records. Decoding goes through the
+// repositories, which still read both, so it includes building the entity.
+constexpr int kRecordBatch = 256;
+
+std::vector<std::unique_ptr<Domain::Model::Enemy>> createEnemies() {
+  std::vector<std::unique_ptr<Domain::Model::Enemy>> enemies;
+  for (int i = 0; i < kRecordBatch; ++i) {
+    Domain::Model::Position position{i % 64, i / 64};
+    if (i % 2 == 0) {
+      enemies.push_back(std::make_unique<Domain::Model::Goblin>(position));
+    } else {
+      enemies.push_back(std::make_unique<Domain::Model::Orc>(position));
+    }
+    enemies.back()->takeDamage(i % 7);
+  }
+  return enemies;
+}
+
+std::string encodeLegacyEnemy(const Domain::Model::Enemy &enemy) {
+  nlohmann::json j;
+  j["type_name"] = enemy.getTypeName();
+  j["name"] = enemy.getName();
+  j["health"] = enemy.getHealth();
+  j["stats"]["strength"] = enemy.getStats().strength;
+  j["stats"]["dexterity"] = enemy.getStats().dexterity;
+  j["stats"]["intelligence"] = enemy.getStats().intelligence;
+  j["stats"]["vitality"] = enemy.getStats().vitality;
+  j["position"]["x"] = enemy.getPosition().x;
+  j["position"]["y"] = enemy.getPosition().y;
+  return j.dump();
+}
+
+std::string encodeBinaryEnemy(const Domain::Model::Enemy &enemy) {
+  const auto *type =
+      Adapter::Out::Persistence::EnemyRepository::builtinTypes().findByKey(
+          enemy.getTypeName());
+  return Adapter::Out::Persistence::EntityCodec::encodeEnemy(type->tag, enemy);
+}
+
+std::string encodeLegacyItem(const Domain::Model::Item &item) {
+  nlohmann::json j;
+  j["type"] = static_cast<int>(item.getType());
+  j["name"] = item.getName();
+  return j.dump();
+}
+
+std::string encodeBinaryItem(const Domain::Model::Item &item) {
+  const auto *type =
+      Adapter::Out::Persistence::ItemRepository::builtinTypes().findByKey(
+          item.getType());
+  return Adapter::Out::Persistence::EntityCodec::encodeItem(type->tag, item);
+}
+
+// Argument 0 is the legacy JSON encoding, 1 the binary one.
+static void BM_EnemyRecord_Encode(benchmark::State &state) {
+  const bool binary = state.range(0) != 0;
+  const auto enemies = createEnemies();
+  std::size_t encoded_bytes = 0;
+  for (auto _ : state) {
+    encoded_bytes = 0;
+    for (const auto &enemy : enemies) {
+      std::string encoded =
+          binary ? encodeBinaryEnemy(*enemy) : encodeLegacyEnemy(*enemy);
+      encoded_bytes += encoded.size();
+      benchmark::DoNotOptimize(encoded.data());
+    }
+  }
+  state.counters["BytesPerRecord"] =
+      static_cast<double>(encoded_bytes) / kRecordBatch;
+  state.counters["RecordsPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * kRecordBatch),
+      benchmark::Counter::kIsRate);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_EnemyRecord_Encode)->ArgName("binary")->Arg(0)->Arg(1);
+
+static void BM_EnemyRecord_Decode(benchmark::State &state) {
+  const bool binary = state.range(0) != 0;
+  ScratchDbPath path("trg_bench_enemy_records");
+  Adapter::Out::Persistence::LevelDbProvider provider(path.string());
+  Adapter::Out::Persistence::EnemyRepository repo(provider);
+  std::vector<std::string> records;
+  for (const auto &enemy : createEnemies()) {
+    records.push_back(binary ? encodeBinaryEnemy(*enemy)
+                             : encodeLegacyEnemy(*enemy));
+  }
+  const std::string key = "bench:enemies:0";
+  for (auto _ : state) {
+    for (const auto &record : records) {
+      auto enemy = repo.decode(key, record);
+      benchmark::DoNotOptimize(enemy.get());
+    }
+  }
+  state.counters["RecordsPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * kRecordBatch),
+      benchmark::Counter::kIsRate);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_EnemyRecord_Decode)->ArgName("binary")->Arg(0)->Arg(1);
+
+static void BM_ItemRecord_Encode(benchmark::State &state) {
+  const bool binary = state.range(0) != 0;
+  const Domain::Model::Item item(Domain::Model::Item::ItemType::HealthPotion,
+                                 "Small Health Potion");
+  std::size_t encoded_bytes = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kRecordBatch; ++i) {
+      std::string encoded =
+          binary ? encodeBinaryItem(item) : encodeLegacyItem(item);
+      encoded_bytes = encoded.size();
+      benchmark::DoNotOptimize(encoded.data());
+    }
+  }
+  state.counters["BytesPerRecord"] = static_cast<double>(encoded_bytes);
+  state.counters["RecordsPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * kRecordBatch),
+      benchmark::Counter::kIsRate);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_ItemRecord_Encode)->ArgName("binary")->Arg(0)->Arg(1);
+
+static void BM_ItemRecord_Decode(benchmark::State &state) {
+  const bool binary = state.range(0) != 0;
+  ScratchDbPath path("trg_bench_item_records");
+  Adapter::Out::Persistence::LevelDbProvider provider(path.string());
+  Adapter::Out::Persistence::ItemRepository repo(provider);
+  const Domain::Model::Item item(Domain::Model::Item::ItemType::HealthPotion,
+                                 "Small Health Potion");
+  const std::string record =
+      binary ? encodeBinaryItem(item) : encodeLegacyItem(item);
+  const std::string key = "bench:items:0";
+  for (auto _ : state) {
+    for (int i = 0; i < kRecordBatch; ++i) {
+      auto decoded = repo.decode(key, record);
+      benchmark::DoNotOptimize(decoded);
+    }
+  }
+  state.counters["RecordsPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * kRecordBatch),
+      benchmark::Counter::kIsRate);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_ItemRecord_Decode)->ArgName("binary")->Arg(0)->Arg(1);
+
+// A whole generated 256x256 map saved through MapRepository into LevelDB and
+// loaded back, rather than just its tile plane: the records MapRepository
+// wrote before the binary format (dimensions, JSON tile rows and entity list,
+// JSON entity records) versus the ones it writes now (dimensions, tile
+// chunks, binary layout and entity records). Loading goes through findById
+// either way, which still reads both. "Bytes" counts the keys and values
+// stored under the map's prefix.
+// Argument 0 is the legacy JSON records, 1 the binary ones.
+const std::string kBenchMapKey = "bench_map";
+
+Domain::Model::Map createGeneratedMap() {
+  Domain::Model::Map map(256, 256);
+  Domain::Model::Rng rng(256); // Same map, and byte counts, on every run.
+  map.generate(rng);
+  return map;
+}
+
+// Entity ids are positions, as the legacy entity list must be keyed by
+// something unique; names repeat across a generated map.
+void saveLegacyMapForBatch(Adapter::Out::Persistence::LevelDbProvider &provider,
+                           Adapter::Out::Persistence::LevelDbBatch &batch,
+                           const Domain::Model::Map &map) {
+  Adapter::Out::Persistence::StandardLayoutCrudRepository<
+      Domain::Model::MapDimensions>(provider)
+      .saveForBatch(batch, kBenchMapKey + ":dimensions",
+                    Domain::Model::MapDimensions{map.getWidth(),
+                                                 map.getHeight()});
+  Adapter::Out::Persistence::StandardLayoutCrudRepository<
+      Domain::Model::Position>(provider)
+      .saveForBatch(batch, kBenchMapKey + ":start_position",
+                    map.getStartPlayerPosition());
+
+  nlohmann::json rows = nlohmann::json::array();
+  for (int y = 0; y < map.getHeight(); ++y) {
+    nlohmann::json row = nlohmann::json::array();
+    for (int x = 0; x < map.getWidth(); ++x) {
+      row.push_back(static_cast<int>(map.getTile(x, y)));
+    }
+    rows.push_back(row);
+  }
+  const auto entityRef = [](const Domain::Model::Position &position,
+                            const std::string &id) {
+    return nlohmann::json{{"position", {{"x", position.x}, {"y", position.y}}},
+                          {"id", id}};
+  };
+  nlohmann::json enemies = nlohmann::json::array();
+  for (const auto &entry : map.getEnemies()) {
+    const std::string id = std::to_string(entry.position.x) + "_" +
+                           std::to_string(entry.position.y);
+    enemies.push_back(entityRef(entry.position, id));
+    batch.Put(kBenchMapKey + ":enemies:" + id,
+              encodeLegacyEnemy(*entry.value));
+  }
+  nlohmann::json items = nlohmann::json::array();
+  for (const auto &entry : map.getItems()) {
+    const std::string id = std::to_string(entry.position.x) + "_" +
+                           std::to_string(entry.position.y);
+    items.push_back(entityRef(entry.position, id));
+    batch.Put(kBenchMapKey + ":items:" + id, encodeLegacyItem(*entry.value));
+  }
+  const nlohmann::json non_standard = {
+      {"tiles", rows}, {"enemies", enemies}, {"items", items}};
+  batch.Put(kBenchMapKey + ":non_standard", non_standard.dump());
+}
+
+std::size_t
+storedMapBytes(Adapter::Out::Persistence::LevelDbProvider &provider) {
+  std::size_t bytes = 0;
+  if (auto records = provider.scanPrefix(kBenchMapKey + ":")) {
+    for (const auto &record : *records) {
+      bytes += record.first.size() + record.second.size();
+    }
+  }
+  return bytes;
+}
+
+// Repositories over one scratch database.
+struct MapRepositoryBench {
+  explicit MapRepositoryBench(const std::string &name)
+      : path(name), provider(path.string()), enemy_repo(provider),
+        item_repo(provider), map_repo(provider, enemy_repo, item_repo) {}
+
+  bool save(const Domain::Model::Map &map, bool binary) {
+    Adapter::Out::Persistence::LevelDbBatch batch;
+    if (binary) {
+      map_repo.saveForBatch(batch, kBenchMapKey, map);
+    } else {
+      saveLegacyMapForBatch(provider, batch, map);
+    }
+    return provider.commitBatch(batch);
+  }
+
+  ScratchDbPath path;
+  Adapter::Out::Persistence::LevelDbProvider provider;
+  Adapter::Out::Persistence::EnemyRepository enemy_repo;
+  Adapter::Out::Persistence::ItemRepository item_repo;
+  Adapter::Out::Persistence::MapRepository map_repo;
+};
+
+static void BM_MapRepository_Save256(benchmark::State &state) {
+  const bool binary = state.range(0) != 0;
+  MapRepositoryBench bench("trg_bench_map_repository_save");
+  const Domain::Model::Map map = createGeneratedMap();
+  for (auto _ : state) {
+    if (!bench.save(map, binary)) {
+      state.SkipWithError("Saving the map failed.");
+      return;
+    }
+  }
+  state.counters["Bytes"] =
+      static_cast<double>(storedMapBytes(bench.provider));
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_MapRepository_Save256)->ArgName("binary")->Arg(0)->Arg(1);
+
+static void BM_MapRepository_Load256(benchmark::State &state) {
+  const bool binary = state.range(0) != 0;
+  MapRepositoryBench bench("trg_bench_map_repository_load");
+  if (!bench.save(createGeneratedMap(), binary)) {
+    state.SkipWithError("Saving the map failed.");
+    return;
+  }
+  for (auto _ : state) {
+    auto map = bench.map_repo.findById(kBenchMapKey);
+    if (!map) {
+      state.SkipWithError("Loading the map failed.");
+      return;
+    }
+    benchmark::DoNotOptimize(map->getTiles().data());
+  }
+  state.counters["Bytes"] =
+      static_cast<double>(storedMapBytes(bench.provider));
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_MapRepository_Load256)->ArgName("binary")->Arg(0)->Arg(1);
+
 } // namespace Benchmark
 } // namespace TuiRogGame
 
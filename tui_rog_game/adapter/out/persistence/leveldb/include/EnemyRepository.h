@@ -1,9 +1,11 @@
 #pragma once
 #include "Enemy.h"
+#include "EntityCodec.h"
 #include "Goblin.h"
 #include "Orc.h"
 #include "Position.h"
 #include "Stats.h"
+#include <functional>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -13,18 +15,44 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
+class LevelDbBatch;
+class LevelDbProvider;
+class LevelDbSnapshot;
+
+// Builds an enemy of one registered type at the given position; the stored
+// name and stats are applied afterwards. Keyed by Enemy::getTypeName().
+using EnemyTypeRegistry = EntityCodec::TypeTagRegistry<
+    std::string, std::function<std::unique_ptr<Domain::Model::Enemy>(
+                     Domain::Model::Position)>>;
+
 class EnemyRepository {
 public:
-  explicit EnemyRepository();
+  explicit EnemyRepository(LevelDbProvider &provider,
+                           const EnemyTypeRegistry &types = builtinTypes());
+
+  // Goblin (tag 1) and Orc (tag 2).
+  static const EnemyTypeRegistry &builtinTypes();
 
-  void saveForBatch(const std::string &key, const Domain::Model::Enemy &enemy);
-  std::unique_ptr<Domain::Model::Enemy> findById(const std::string &key);
+  void saveForBatch(LevelDbBatch &batch, const std::string &key,
+                    const Domain::Model::Enemy &enemy);
+  std::unique_ptr<Domain::Model::Enemy>
+  findById(const std::string &key, const LevelDbSnapshot *snapshot = nullptr);
+  // Decodes a stored record already read (e.g. by a prefix scan); key is
+  // only used for logging.
+  std::unique_ptr<Domain::Model::Enemy> decode(const std::string &key,
+                                               const std::string &value) const;
   void deleteById(const std::string &key);
+  void deleteForBatch(LevelDbBatch &batch, const std::string &key);
 
 private:
+  LevelDbProvider &provider_;
+  const EnemyTypeRegistry &types_;
+
   std::string toLower(std::string s) const;
 
-  nlohmann::json serializeEnemy(const Domain::Model::Enemy &enemy) const;
+  std::unique_ptr<Domain::Model::Enemy>
+  fromRecord(EntityCodec::EnemyRecord record) const;
+  // Records written before EntityCodec, as JSON objects.
   std::unique_ptr<Domain::Model::Enemy>
   deserializeEnemy(const nlohmann::json &j) const;
 };
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Enemy.h"
+#include "Item.h"
+#include "Position.h"
+#include "Stats.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+
+// Versioned binary encodings of the enemy and item records written by
+// EnemyRepository and ItemRepository. Like MapCodec, multi-byte fields are
+// stored in host byte order.
+namespace EntityCodec {
+
+// Records start with this byte, which also tells them apart from the JSON
+// objects ('{') written by earlier versions.
+constexpr std::uint8_t kEntityRecordMagic = 0xE1;
+
+// Stored right after the magic byte. Records of any other version are
+// rejected.
+constexpr std::uint8_t kEntityRecordVersion = 1;
+
+// Maps the one-byte type tags stored in records to the factory that rebuilds
+// that type, and the in-memory type key back to its tag. Tags are part of the
+// on-disk format: never renumber or reuse one. Lookups are linear since a
+// registry only ever holds a handful of types.
+template <typename Key, typename Factory> class TypeTagRegistry {
+public:
+  struct Entry {
+    std::uint8_t tag;
+    Key key;
+    Factory factory;
+  };
+
+  // Returns false, leaving the registry unchanged, if tag or key is taken.
+  bool add(std::uint8_t tag, Key key, Factory factory) {
+    if (findByTag(tag) || findByKey(key)) {
+      return false;
+    }
+    entries_.push_back(Entry{tag, std::move(key), std::move(factory)});
+    return true;
+  }
+
+  const Entry *findByTag(std::uint8_t tag) const {
+    for (const Entry &entry : entries_) {
+      if (entry.tag == tag) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename K> const Entry *findByKey(const K &key) const {
+    for (const Entry &entry : entries_) {
+      if (entry.key == key) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  std::vector<Entry> entries_;
+};
+
+// Enemy: a fixed 40-byte header (magic, version, type tag, three reserved
+// bytes, name length, stats, position) followed by the name.
+struct EnemyRecord {
+  std::uint8_t type_tag = 0;
+  std::string name;
+  Domain::Model::Stats stats;
+  Domain::Model::Position position;
+};
+
+std::string encodeEnemy(std::uint8_t type_tag,
+                        const Domain::Model::Enemy &enemy);
+std::optional<EnemyRecord> decodeEnemy(const std::string &blob);
+
+// Item: a fixed 8-byte header (magic, version, type tag, three reserved
+// bytes, name length) followed by the name.
+struct ItemRecord {
+  std::uint8_t type_tag = 0;
+  std::string name;
+};
+
+std::string encodeItem(std::uint8_t type_tag, const Domain::Model::Item &item);
+std::optional<ItemRecord> decodeItem(const std::string &blob);
+
+// True if blob starts like a record of this codec rather than legacy JSON.
+bool isEncodedRecord(const std::string &blob);
+
+} // namespace EntityCodec
+
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
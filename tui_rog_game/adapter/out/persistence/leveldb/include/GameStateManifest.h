@@ -0,0 +1,78 @@
+#pragma once
+
+#include "GameStateDTO.h"
+#include "Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+
+// Summary of one saved game, written by LevelDbAdapter in the same batch as
+// the records it describes. Checksums are taken over the game state rather
+// than the stored bytes, so an incremental save can describe the whole game
+// without reading back what it did not rewrite. The tile and entity
+// checksums are sums of per-chunk and per-entity checksums, so they neither
+// depend on iteration order nor need the whole map to be updated.
+struct GameStateManifest {
+  std::uint64_t player_checksum = 0;
+  std::uint64_t tiles_checksum = 0;
+  std::uint64_t enemies_checksum = 0;
+  std::uint64_t items_checksum = 0;
+  std::uint32_t inventory_count = 0;
+  std::uint32_t enemy_count = 0;
+  std::uint32_t item_count = 0;
+
+  bool operator==(const GameStateManifest &other) const;
+  bool operator!=(const GameStateManifest &other) const {
+    return !(*this == other);
+  }
+};
+
+GameStateManifest describeGameState(const Port::Out::GameStateDTO &game_state);
+
+// Keeps the manifest of one game current across saves. update() only rehashes
+// what the change sets of the saved state report, so a save costs time in
+// what changed rather than in the size of the map.
+class GameStateDigest {
+public:
+  // Tiles are hashed in chunks of this many.
+  static constexpr std::size_t kTileChunkSize = 1024;
+
+  // Describes game_state from scratch.
+  void reset(const Port::Out::GameStateDTO &game_state);
+  // Folds in the changes game_state reports since the state last given to
+  // reset or update. Falls back to reset when the map is marked as fully
+  // changed or nothing was described yet.
+  void update(const Port::Out::GameStateDTO &game_state);
+
+  const GameStateManifest &manifest() const { return manifest_; }
+
+private:
+  void resetMap(const Domain::Model::Map &map);
+  void describePlayer(const Domain::Model::Player &player);
+
+  bool described_ = false;
+  std::uint64_t tiles_header_ = 0;
+  std::vector<std::uint64_t> tile_chunks_;
+  // Checksum of the entity at each position.
+  std::map<Domain::Model::Position, std::uint64_t> enemies_;
+  std::map<Domain::Model::Position, std::uint64_t> items_;
+  GameStateManifest manifest_;
+};
+
+// Versioned binary record ending in a checksum of its own bytes, so a torn
+// or corrupted manifest is rejected rather than misread.
+std::string encodeManifest(const GameStateManifest &manifest);
+std::optional<GameStateManifest> decodeManifest(const std::string &blob);
+
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
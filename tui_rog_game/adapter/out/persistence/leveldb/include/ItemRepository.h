@@ -1,6 +1,8 @@
 #pragma once
 
+#include "EntityCodec.h"
 #include "Item.h"
+#include <functional>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
@@ -11,18 +13,42 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
+class LevelDbBatch;
+class LevelDbProvider;
+class LevelDbSnapshot;
+
+// Builds an item of one registered type from its stored name. Keyed by
+// Item::getType().
+using ItemTypeRegistry = EntityCodec::TypeTagRegistry<
+    Domain::Model::Item::ItemType,
+    std::function<Domain::Model::Item(std::string name)>>;
+
 class ItemRepository {
 public:
-  explicit ItemRepository();
+  explicit ItemRepository(LevelDbProvider &provider,
+                          const ItemTypeRegistry &types = builtinTypes());
+
+  // HealthPotion (tag 1) and StrengthScroll (tag 2).
+  static const ItemTypeRegistry &builtinTypes();
 
-  void saveForBatch(const std::string &key, const Domain::Model::Item &item);
-  std::optional<Domain::Model::Item> findById(const std::string &key);
+  void saveForBatch(LevelDbBatch &batch, const std::string &key,
+                    const Domain::Model::Item &item);
+  std::optional<Domain::Model::Item>
+  findById(const std::string &key, const LevelDbSnapshot *snapshot = nullptr);
+  // Decodes a stored record already read (e.g. by a prefix scan); key is
+  // only used for logging.
+  std::optional<Domain::Model::Item> decode(const std::string &key,
+                                            const std::string &value) const;
   void deleteById(const std::string &key);
+  void deleteForBatch(LevelDbBatch &batch, const std::string &key);
 
 private:
+  LevelDbProvider &provider_;
+  const ItemTypeRegistry &types_;
+
   std::string toLower(std::string s) const;
 
-  nlohmann::json serializeItem(const Domain::Model::Item &item) const;
+  // Records written before EntityCodec, as JSON objects.
   std::optional<Domain::Model::Item>
   deserializeItem(const nlohmann::json &j) const;
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include "ILoadGameStatePort.h"
 #include "ISaveGameStatePort.h"
+#include "LevelDbProvider.h"
 #include <memory>
 #include <string>
 
@@ -9,10 +10,19 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
+// Stores one game under keys derived from session_id ("<session>_player",
+// "<session>_map"), so adapters with different sessions share one database
+// without seeing each other's state.
 class LevelDbAdapter : public Port::Out::ISaveGameStatePort,
                        public Port::Out::ILoadGameStatePort {
 public:
-  explicit LevelDbAdapter(const std::string &db_path);
+  // Opens its own database at db_path.
+  explicit LevelDbAdapter(const std::string &db_path,
+                          const std::string &session_id = "main",
+                          const LevelDbOptions &options = LevelDbOptions());
+  // Uses an already open database, e.g. one shared by many sessions.
+  explicit LevelDbAdapter(std::shared_ptr<LevelDbProvider> provider,
+                          const std::string &session_id = "main");
   ~LevelDbAdapter() override;
 
   void saveGameState(const Port::Out::GameStateDTO &game_state) override;
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace leveldb {
+class Cache;
 class DB;
+class FilterPolicy;
+class Snapshot;
 class WriteBatch;
 } // namespace leveldb
 
@@ -14,18 +20,103 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
+// Tuning knobs for one database. The defaults suit the save pattern of a
+// game: small incremental batches every turn and point lookups on load.
+struct LevelDbOptions {
+  // LRU cache of uncompressed blocks. 0 keeps LevelDB's internal 8 MiB one.
+  std::size_t block_cache_bytes = 8 * 1024 * 1024;
+  // Bloom filter bits per key; 0 disables the filter. Loads probe for keys
+  // that usually do not exist (legacy records), which the filter answers
+  // without reading a block.
+  int bloom_bits_per_key = 10;
+  // Memtable size before it is flushed to a table file.
+  std::size_t write_buffer_bytes = 4 * 1024 * 1024;
+  // Snappy block compression.
+  bool compression = true;
+  // fsync every write. Without it a crash can lose the last saves, but never
+  // leaves the database inconsistent.
+  bool sync = false;
+};
+
+// Writes collected by one caller and applied atomically by
+// LevelDbProvider::commitBatch. Each saver owns its batch, so savers on
+// different threads never see each other's writes.
+class LevelDbBatch {
+public:
+  LevelDbBatch();
+  ~LevelDbBatch();
+  LevelDbBatch(LevelDbBatch &&) noexcept;
+  LevelDbBatch &operator=(LevelDbBatch &&) noexcept;
+
+  void Put(const std::string &key, const std::string &value);
+  void Delete(const std::string &key);
+  void clear();
+
+  std::size_t size() const { return operation_count_; }
+  bool empty() const { return operation_count_ == 0; }
+
+private:
+  friend class LevelDbProvider;
+
+  std::unique_ptr<leveldb::WriteBatch> batch_;
+  std::size_t operation_count_ = 0;
+};
+
+// A consistent point-in-time view of a database. Reads given the snapshot
+// ignore every write committed after it was taken. Released on destruction,
+// which must happen before the provider is destroyed.
+class LevelDbSnapshot {
+public:
+  ~LevelDbSnapshot();
+
+  LevelDbSnapshot(const LevelDbSnapshot &) = delete;
+  LevelDbSnapshot &operator=(const LevelDbSnapshot &) = delete;
+
+private:
+  friend class LevelDbProvider;
+
+  LevelDbSnapshot(leveldb::DB &db, const leveldb::Snapshot *snapshot)
+      : db_(db), snapshot_(snapshot) {}
+
+  leveldb::DB &db_;
+  const leveldb::Snapshot *snapshot_;
+};
+
+// One open LevelDB database. Instances are independent; adapters that should
+// share a database share the provider.
 class LevelDbProvider {
 public:
-  static LevelDbProvider &getInstance();
+  explicit LevelDbProvider(const std::string &db_path,
+                           const LevelDbOptions &options = LevelDbOptions());
+  ~LevelDbProvider();
+
+  // False if the database could not be opened; every operation then fails.
+  bool isOpen() const { return db_ != nullptr; }
+  const std::string &getPath() const { return db_path_; }
+
+  // Reads see the latest committed writes unless a snapshot is given.
+  std::optional<std::string> Get(const std::string &key,
+                                 const LevelDbSnapshot *snapshot = nullptr);
+  // Every record whose key starts with prefix, in key order, read with one
+  // seek and a sequential scan. nullopt if the scan failed.
+  std::optional<std::vector<std::pair<std::string, std::string>>>
+  scanPrefix(const std::string &prefix,
+             const LevelDbSnapshot *snapshot = nullptr);
+  // Like scanPrefix, but without copying the values.
+  std::optional<std::vector<std::string>>
+  scanKeys(const std::string &prefix,
+           const LevelDbSnapshot *snapshot = nullptr);
+  // nullptr if the database is not open.
+  std::unique_ptr<LevelDbSnapshot> snapshot();
 
-  std::optional<std::string> Get(const std::string &key);
   bool Put(const std::string &key, const std::string &value);
   bool Delete(const std::string &key);
 
-  void startBatch();
-  void addToBatch(const std::string &key, const std::string &value);
-  void deleteFromBatch(const std::string &key);
-  bool commitBatch();
+  // Applies the batch atomically and clears it, even on failure. Safe to
+  // call from many threads: LevelDB queues concurrent writers and lets the
+  // one at the head write the queued batches together (one log append, and
+  // one fsync when syncing), so parallel savers share the cost of a write.
+  bool commitBatch(LevelDbBatch &batch);
 
   LevelDbProvider(const LevelDbProvider &) = delete;
   LevelDbProvider &operator=(const LevelDbProvider &) = delete;
@@ -33,11 +124,13 @@ public:
   LevelDbProvider &operator=(LevelDbProvider &&) = delete;
 
 private:
-  LevelDbProvider();
-  ~LevelDbProvider();
-
-  std::shared_ptr<leveldb::DB> db_;
-  std::unique_ptr<leveldb::WriteBatch> current_batch_;
+  std::string db_path_;
+  bool sync_;
+  // The database refers to both, so they are declared (and outlive it)
+  // before it.
+  std::unique_ptr<leveldb::Cache> block_cache_;
+  std::unique_ptr<const leveldb::FilterPolicy> filter_policy_;
+  std::unique_ptr<leveldb::DB> db_;
 };
 
 } // namespace Persistence
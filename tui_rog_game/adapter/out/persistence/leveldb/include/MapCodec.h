@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Map.h"
+#include "Position.h"
+#include "Tile.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+
+// Versioned binary encodings used by MapRepository. Multi-byte fields are
+// stored in host byte order, like the StandardLayoutCrudRepository records.
+namespace MapCodec {
+
+// Tile chunk: [kTileChunkMagic][codec][payload]. Tile values are all below
+// 0x80, so the leading byte also tells encoded chunks apart from the raw,
+// header-less chunks written by earlier versions.
+constexpr std::uint8_t kTileChunkMagic = 0xB1;
+
+enum class TileCodec : std::uint8_t {
+  RAW = 0, // One byte per tile.
+  RLE = 1, // Runs of {uint8 tile, uint16 length}.
+};
+
+// Picks whichever of RAW and RLE is smaller for this chunk.
+std::string encodeTileChunk(const Domain::Model::Tile *tiles,
+                            std::size_t count);
+// Decodes exactly `count` tiles into out. Accepts legacy raw chunks.
+bool decodeTileChunk(const std::string &blob, Domain::Model::Tile *out,
+                     std::size_t count);
+
+// Entity layout: a fixed header followed by one fixed-size record per enemy,
+// then one per item. Entity records themselves are stored under their own
+// keys, derived from these positions.
+struct EntityLayout {
+  int width = 0;
+  int height = 0;
+  std::vector<Domain::Model::Position> enemies;
+  std::vector<Domain::Model::Position> items;
+};
+
+std::string encodeEntityLayout(const Domain::Model::Map &map);
+std::optional<EntityLayout> decodeEntityLayout(const std::string &blob);
+
+} // namespace MapCodec
+
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -6,10 +6,13 @@
 #include "MapDimensions.h"
 #include "Position.h"
 #include "StandardLayoutCrudRepository.h"
+#include <cstddef>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace TuiRogGame {
 namespace Adapter {
@@ -18,14 +21,30 @@ namespace Persistence {
 
 class MapRepository {
 public:
-  explicit MapRepository(EnemyRepository &enemy_repo,
-                         ItemRepository &item_repo);
+  MapRepository(LevelDbProvider &provider, EnemyRepository &enemy_repo,
+                ItemRepository &item_repo);
 
-  void saveForBatch(const std::string &key, const Domain::Model::Map &map);
-  std::optional<Domain::Model::Map> findById(const std::string &key);
+  // Replaces every record under "<key>:", so nothing of a map saved there
+  // before outlives it.
+  void saveForBatch(LevelDbBatch &batch, const std::string &key,
+                    const Domain::Model::Map &map);
+  // Adds only what map.getChanges() reports; falls back to saveForBatch when
+  // the map is marked as fully changed.
+  void saveChangesForBatch(LevelDbBatch &batch, const std::string &key,
+                           const Domain::Model::Map &map);
+  // Reads the map with one prefix scan over "<key>:" rather than a lookup
+  // per record. Full saves clear that prefix, so the scan reads only the
+  // records of the map saved last.
+  std::optional<Domain::Model::Map>
+  findById(const std::string &key, const LevelDbSnapshot *snapshot = nullptr);
   void deleteById(const std::string &key);
 
+  // Tiles are persisted in fixed-size chunks under "<map>:tiles:<n>" so a
+  // handful of changed tiles rewrites only the chunks containing them.
+  static constexpr std::size_t kTileChunkSize = 1024;
+
 private:
+  LevelDbProvider &provider_;
   EnemyRepository &enemy_repo_;
   ItemRepository &item_repo_;
 
@@ -35,10 +54,25 @@ private:
       map_start_position_crud_;
 
   std::string toLower(std::string s) const;
+  std::string entityId(const Domain::Model::Position &position) const;
+
+  void saveTileChunkForBatch(LevelDbBatch &batch,
+                             const std::string &base_key,
+                             const Domain::Model::Map &map,
+                             std::size_t chunk) const;
+  // chunk_records holds (chunk index, record) pairs in any order; fails
+  // unless every chunk a map of width x height has is among them.
+  std::optional<std::vector<Domain::Model::Tile>> decodeTileChunks(
+      const std::string &base_key,
+      const std::vector<std::pair<std::size_t, const std::string *>>
+          &chunk_records,
+      int width, int height) const;
 
-  nlohmann::json serializeMapNonStandard(const Domain::Model::Map &map) const;
-  std::optional<std::vector<std::vector<Domain::Model::Tile>>>
-  deserializeMapTiles(const nlohmann::json &j) const;
+  std::optional<std::vector<Domain::Model::Tile>>
+  deserializeMapTiles(const std::string &blob, int width, int height) const;
+  std::optional<std::vector<Domain::Model::Tile>>
+  deserializeLegacyMapTiles(const nlohmann::json &j, int width,
+                            int height) const;
   std::vector<std::pair<Domain::Model::Position, std::string>>
   deserializeMapEnemyIds(const nlohmann::json &j) const;
   std::vector<std::pair<Domain::Model::Position, std::string>>
@@ -18,14 +18,20 @@ namespace Persistence {
 
 class PlayerRepository {
 public:
-  explicit PlayerRepository(ItemRepository &item_repo);
+  PlayerRepository(LevelDbProvider &provider, ItemRepository &item_repo);
 
-  void saveForBatch(const std::string &key,
+  void saveForBatch(LevelDbBatch &batch, const std::string &key,
                     const Domain::Model::Player &player);
-  std::optional<Domain::Model::Player> findById(const std::string &key);
+  // Adds only what player.getChanges() reports; falls back to saveForBatch
+  // when the player is marked as fully changed.
+  void saveChangesForBatch(LevelDbBatch &batch, const std::string &key,
+                           const Domain::Model::Player &player);
+  std::optional<Domain::Model::Player>
+  findById(const std::string &key, const LevelDbSnapshot *snapshot = nullptr);
   void deleteById(const std::string &key);
 
 private:
+  LevelDbProvider &provider_;
   ItemRepository &item_repo_;
 
   StandardLayoutCrudRepository<Domain::Model::PlayerCoreStats>
@@ -30,13 +30,13 @@ public:
   static_assert(std::is_standard_layout_v<T>,
                 "CrudRepository can only be used with standard layout types.");
 
-  StandardLayoutCrudRepository() = default;
+  explicit StandardLayoutCrudRepository(LevelDbProvider &provider)
+      : provider_(provider) {}
 
   void save(const std::string &key, const T &entity) {
-    auto &provider = LevelDbProvider::getInstance();
     std::string lower_key = toLower(key);
     std::string value(reinterpret_cast<const char *>(&entity), sizeof(T));
-    if (!provider.Put(lower_key, value)) {
+    if (!provider_.Put(lower_key, value)) {
       spdlog::error("CrudRepository: Failed to save key '{}' immediately.",
                     lower_key);
     } else {
@@ -45,57 +45,62 @@ public:
     }
   }
 
-  void saveForBatch(const std::string &key, const T &entity) {
-    auto &provider = LevelDbProvider::getInstance();
+  void saveForBatch(LevelDbBatch &batch, const std::string &key,
+                    const T &entity) {
     std::string lower_key = toLower(key);
     std::string value(reinterpret_cast<const char *>(&entity), sizeof(T));
-    provider.addToBatch(lower_key, value);
+    batch.Put(lower_key, value);
     spdlog::debug("CrudRepository: Added Put for key '{}' to batch.",
                   lower_key);
   }
 
-  std::optional<T> findById(const std::string &key) {
-    auto &provider = LevelDbProvider::getInstance();
+  std::optional<T> findById(const std::string &key,
+                            const LevelDbSnapshot *snapshot = nullptr) {
     std::string lower_key = toLower(key);
-    auto value_str_opt = provider.Get(lower_key);
+    auto value_str_opt = provider_.Get(lower_key, snapshot);
 
     if (!value_str_opt) {
       return std::nullopt;
     }
+    return decode(lower_key, *value_str_opt);
+  }
 
-    if (value_str_opt->length() == sizeof(T)) {
+  // Decodes a stored value already read (e.g. by a prefix scan); key is only
+  // used for logging.
+  static std::optional<T> decode(const std::string &key,
+                                 const std::string &value) {
+    if (value.length() == sizeof(T)) {
       T result;
-      std::memcpy(&result, value_str_opt->data(), sizeof(T));
-      spdlog::debug("CrudRepository: Found key '{}' of size {}", lower_key,
+      std::memcpy(&result, value.data(), sizeof(T));
+      spdlog::debug("CrudRepository: Found key '{}' of size {}", key,
                     sizeof(T));
       return result;
     } else {
       spdlog::error("CrudRepository: Value length mismatch for key '{}'. "
                     "Expected {} bytes, got {} bytes.",
-                    lower_key, sizeof(T), value_str_opt->length());
+                    key, sizeof(T), value.length());
       return std::nullopt;
     }
   }
 
   void deleteById(const std::string &key) {
-    auto &provider = LevelDbProvider::getInstance();
     std::string lower_key = toLower(key);
-    if (!provider.Delete(lower_key)) {
+    if (!provider_.Delete(lower_key)) {
       spdlog::error("CrudRepository: Failed to delete key '{}'.", lower_key);
     } else {
       spdlog::debug("CrudRepository: Deleted key '{}'.", lower_key);
     }
   }
 
-  void deleteForBatch(const std::string &key) {
-    auto &provider = LevelDbProvider::getInstance();
+  void deleteForBatch(LevelDbBatch &batch, const std::string &key) {
     std::string lower_key = toLower(key);
-    provider.deleteFromBatch(lower_key);
+    batch.Delete(lower_key);
     spdlog::debug("CrudRepository: Added Delete for key '{}' to batch.",
                   lower_key);
   }
 
 private:
+  LevelDbProvider &provider_;
 };
 
 } // namespace Persistence
@@ -2,6 +2,7 @@
 #include "LevelDbProvider.h"
 #include <algorithm>
 #include <cctype>
+#include <utility>
 #include <spdlog/spdlog.h>
 
 namespace TuiRogGame {
@@ -9,7 +10,23 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
-EnemyRepository::EnemyRepository() = default;
+EnemyRepository::EnemyRepository(LevelDbProvider &provider,
+                                 const EnemyTypeRegistry &types)
+    : provider_(provider), types_(types) {}
+
+const EnemyTypeRegistry &EnemyRepository::builtinTypes() {
+  static const EnemyTypeRegistry types = [] {
+    EnemyTypeRegistry registry;
+    registry.add(1, "Goblin", [](Domain::Model::Position position) {
+      return std::make_unique<Domain::Model::Goblin>(position);
+    });
+    registry.add(2, "Orc", [](Domain::Model::Position position) {
+      return std::make_unique<Domain::Model::Orc>(position);
+    });
+    return registry;
+  }();
+  return types;
+}
 
 std::string EnemyRepository::toLower(std::string s) const {
   std::transform(s.begin(), s.end(), s.begin(),
@@ -17,19 +34,20 @@ std::string EnemyRepository::toLower(std::string s) const {
   return s;
 }
 
-nlohmann::json
-EnemyRepository::serializeEnemy(const Domain::Model::Enemy &enemy) const {
-  nlohmann::json j;
-  j["type_name"] = enemy.getTypeName();
-  j["name"] = enemy.getName();
-  j["health"] = enemy.getHealth();
-  j["stats"]["strength"] = enemy.getStats().strength;
-  j["stats"]["dexterity"] = enemy.getStats().dexterity;
-  j["stats"]["intelligence"] = enemy.getStats().intelligence;
-  j["stats"]["vitality"] = enemy.getStats().vitality;
-  j["position"]["x"] = enemy.getPosition().x;
-  j["position"]["y"] = enemy.getPosition().y;
-  return j;
+std::unique_ptr<Domain::Model::Enemy>
+EnemyRepository::fromRecord(EntityCodec::EnemyRecord record) const {
+  const auto *type = types_.findByTag(record.type_tag);
+  if (!type) {
+    spdlog::error("EnemyRepository: Unknown enemy type tag: {}",
+                  static_cast<int>(record.type_tag));
+    return nullptr;
+  }
+  auto enemy_ptr = type->factory(record.position);
+  if (enemy_ptr) {
+    enemy_ptr->name_ = std::move(record.name);
+    enemy_ptr->stats_ = record.stats;
+  }
+  return enemy_ptr;
 }
 
 std::unique_ptr<Domain::Model::Enemy>
@@ -51,17 +69,13 @@ EnemyRepository::deserializeEnemy(const nlohmann::json &j) const {
       position.x = j["position"]["x"].get<int>();
       position.y = j["position"]["y"].get<int>();
 
-      std::unique_ptr<Domain::Model::Enemy> enemy_ptr;
-
-      if (type_name == "Orc") {
-        enemy_ptr = std::make_unique<Domain::Model::Orc>(position);
-      } else if (type_name == "Goblin") {
-        enemy_ptr = std::make_unique<Domain::Model::Goblin>(position);
-      } else {
+      const auto *type = types_.findByKey(type_name);
+      if (!type) {
         spdlog::error("EnemyRepository: Unknown enemy type_name: {}",
                       type_name);
         return nullptr;
       }
+      auto enemy_ptr = type->factory(position);
 
       if (enemy_ptr) {
         enemy_ptr->stats_.health = health;
@@ -79,43 +93,69 @@ EnemyRepository::deserializeEnemy(const nlohmann::json &j) const {
   }
 }
 
-void EnemyRepository::saveForBatch(const std::string &key,
+void EnemyRepository::saveForBatch(LevelDbBatch &batch,
+                                   const std::string &key,
                                    const Domain::Model::Enemy &enemy) {
   std::string lower_key = toLower(key);
-  nlohmann::json j = serializeEnemy(enemy);
-  LevelDbProvider::getInstance().addToBatch(lower_key, j.dump());
+  const auto *type = types_.findByKey(enemy.getTypeName());
+  if (!type) {
+    spdlog::error("EnemyRepository: No type tag for '{}'; not saving key '{}'.",
+                  enemy.getTypeName(), lower_key);
+    return;
+  }
+  batch.Put(lower_key, EntityCodec::encodeEnemy(type->tag, enemy));
   spdlog::debug("EnemyRepository: Added Put for key '{}' to batch.", lower_key);
 }
 
 std::unique_ptr<Domain::Model::Enemy>
-EnemyRepository::findById(const std::string &key) {
-  auto &provider = LevelDbProvider::getInstance();
-
+EnemyRepository::findById(const std::string &key,
+                          const LevelDbSnapshot *snapshot) {
   std::string lower_key = toLower(key);
-  auto value_str_opt = provider.Get(lower_key);
+  auto value_str_opt = provider_.Get(lower_key, snapshot);
 
   if (!value_str_opt) {
     return nullptr;
   }
+  return decode(lower_key, *value_str_opt);
+}
 
+std::unique_ptr<Domain::Model::Enemy>
+EnemyRepository::decode(const std::string &key,
+                        const std::string &value) const {
+  if (EntityCodec::isEncodedRecord(value)) {
+    auto record = EntityCodec::decodeEnemy(value);
+    if (!record) {
+      spdlog::error("EnemyRepository: Malformed enemy record for key '{}'.",
+                    key);
+      return nullptr;
+    }
+    return fromRecord(std::move(*record));
+  }
   try {
-    nlohmann::json j = nlohmann::json::parse(*value_str_opt);
+    nlohmann::json j = nlohmann::json::parse(value);
     return deserializeEnemy(j);
   } catch (const nlohmann::json::exception &e) {
     spdlog::error("EnemyRepository: Failed to parse JSON for key '{}': {}",
-                  lower_key, e.what());
+                  key, e.what());
     return nullptr;
   }
 }
 
 void EnemyRepository::deleteById(const std::string &key) {
-  auto &provider = LevelDbProvider::getInstance();
   std::string lower_key = toLower(key);
-  if (provider.Delete(lower_key)) {
+  if (provider_.Delete(lower_key)) {
     spdlog::debug("EnemyRepository: Deleted key '{}'.", lower_key);
   }
 }
 
+void EnemyRepository::deleteForBatch(LevelDbBatch &batch,
+                                     const std::string &key) {
+  std::string lower_key = toLower(key);
+  batch.Delete(lower_key);
+  spdlog::debug("EnemyRepository: Added Delete for key '{}' to batch.",
+                lower_key);
+}
+
 } // namespace Persistence
 } // namespace Out
 } // namespace Adapter
@@ -0,0 +1,154 @@
+#include "EntityCodec.h"
+#include <cstring>
+#include <limits>
+#include <spdlog/spdlog.h>
+#include <type_traits>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+namespace EntityCodec {
+
+namespace {
+
+struct EnemyHeader {
+  std::uint8_t magic;
+  std::uint8_t version;
+  std::uint8_t type_tag;
+  std::uint8_t reserved[3];
+  std::uint16_t name_length;
+  std::int32_t strength;
+  std::int32_t dexterity;
+  std::int32_t intelligence;
+  std::int32_t vitality;
+  std::int32_t health;
+  std::int32_t max_health;
+  std::int32_t x;
+  std::int32_t y;
+};
+
+struct ItemHeader {
+  std::uint8_t magic;
+  std::uint8_t version;
+  std::uint8_t type_tag;
+  std::uint8_t reserved[3];
+  std::uint16_t name_length;
+};
+
+static_assert(std::is_standard_layout<EnemyHeader>::value &&
+                  std::is_trivially_copyable<EnemyHeader>::value &&
+                  sizeof(EnemyHeader) == 40,
+              "EnemyHeader must be a fixed 40-byte header.");
+static_assert(std::is_standard_layout<ItemHeader>::value &&
+                  std::is_trivially_copyable<ItemHeader>::value &&
+                  sizeof(ItemHeader) == 8,
+              "ItemHeader must be a fixed 8-byte header.");
+
+// Names longer than the length field can hold are cut short.
+std::uint16_t nameLength(const std::string &name) {
+  constexpr std::size_t kMax = std::numeric_limits<std::uint16_t>::max();
+  if (name.size() > kMax) {
+    spdlog::warn("EntityCodec: Truncating {}-byte name to {} bytes.",
+                 name.size(), kMax);
+    return static_cast<std::uint16_t>(kMax);
+  }
+  return static_cast<std::uint16_t>(name.size());
+}
+
+template <typename Header>
+std::string encodeRecord(const Header &header, const std::string &name) {
+  std::string out;
+  out.reserve(sizeof(header) + header.name_length);
+  out.append(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.append(name.data(), header.name_length);
+  return out;
+}
+
+// Reads the header of blob and checks its version and that the name fills
+// the rest of it.
+template <typename Header>
+bool decodeHeader(const std::string &blob, Header &header) {
+  if (blob.size() < sizeof(header)) {
+    return false;
+  }
+  std::memcpy(&header, blob.data(), sizeof(header));
+  if (header.magic != kEntityRecordMagic) {
+    return false;
+  }
+  if (header.version != kEntityRecordVersion) {
+    spdlog::error("EntityCodec: Unsupported record version {}.",
+                  header.version);
+    return false;
+  }
+  return blob.size() == sizeof(header) + header.name_length;
+}
+
+} // namespace
+
+std::string encodeEnemy(std::uint8_t type_tag,
+                        const Domain::Model::Enemy &enemy) {
+  const Domain::Model::Stats &stats = enemy.getStats();
+  EnemyHeader header{};
+  header.magic = kEntityRecordMagic;
+  header.version = kEntityRecordVersion;
+  header.type_tag = type_tag;
+  header.name_length = nameLength(enemy.getName());
+  header.strength = stats.strength;
+  header.dexterity = stats.dexterity;
+  header.intelligence = stats.intelligence;
+  header.vitality = stats.vitality;
+  header.health = stats.health;
+  header.max_health = stats.max_health;
+  header.x = enemy.getPosition().x;
+  header.y = enemy.getPosition().y;
+  return encodeRecord(header, enemy.getName());
+}
+
+std::optional<EnemyRecord> decodeEnemy(const std::string &blob) {
+  EnemyHeader header;
+  if (!decodeHeader(blob, header)) {
+    return std::nullopt;
+  }
+  EnemyRecord record;
+  record.type_tag = header.type_tag;
+  record.name.assign(blob, sizeof(header), header.name_length);
+  record.stats = Domain::Model::Stats(header.strength, header.dexterity,
+                                      header.intelligence, header.vitality);
+  record.stats.health = header.health;
+  record.stats.max_health = header.max_health;
+  record.position = {header.x, header.y};
+  return record;
+}
+
+std::string encodeItem(std::uint8_t type_tag,
+                       const Domain::Model::Item &item) {
+  ItemHeader header{};
+  header.magic = kEntityRecordMagic;
+  header.version = kEntityRecordVersion;
+  header.type_tag = type_tag;
+  header.name_length = nameLength(item.getName());
+  return encodeRecord(header, item.getName());
+}
+
+std::optional<ItemRecord> decodeItem(const std::string &blob) {
+  ItemHeader header;
+  if (!decodeHeader(blob, header)) {
+    return std::nullopt;
+  }
+  ItemRecord record;
+  record.type_tag = header.type_tag;
+  record.name.assign(blob, sizeof(header), header.name_length);
+  return record;
+}
+
+bool isEncodedRecord(const std::string &blob) {
+  return !blob.empty() &&
+         static_cast<std::uint8_t>(blob[0]) == kEntityRecordMagic;
+}
+
+} // namespace EntityCodec
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,335 @@
+#include "GameStateManifest.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <set>
+#include <spdlog/spdlog.h>
+#include <type_traits>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+
+namespace {
+
+constexpr char kManifestMagic[4] = {'T', 'R', 'G', 'M'};
+constexpr std::uint16_t kManifestVersion = 1;
+
+struct ManifestRecord {
+  char magic[4];
+  std::uint16_t version;
+  std::uint16_t reserved;
+  std::uint64_t player_checksum;
+  std::uint64_t tiles_checksum;
+  std::uint64_t enemies_checksum;
+  std::uint64_t items_checksum;
+  std::uint32_t inventory_count;
+  std::uint32_t enemy_count;
+  std::uint32_t item_count;
+  std::uint32_t reserved2;
+  // Over every byte above.
+  std::uint64_t record_checksum;
+};
+
+static_assert(std::is_standard_layout<ManifestRecord>::value &&
+                  std::is_trivially_copyable<ManifestRecord>::value &&
+                  sizeof(ManifestRecord) == 64,
+              "ManifestRecord must be a fixed 64-byte record.");
+
+// 64-bit non-cryptographic hash fed a word at a time, so the tile plane of a
+// large map costs a few microseconds per save.
+class Checksum {
+public:
+  void add(const void *data, std::size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    std::size_t offset = 0;
+    for (; offset + sizeof(std::uint64_t) <= size;
+         offset += sizeof(std::uint64_t)) {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + offset, sizeof(word));
+      mix(word);
+    }
+    std::uint64_t tail = size;
+    std::memcpy(&tail, bytes + offset, size - offset);
+    mix(tail ^ (static_cast<std::uint64_t>(size) << 56));
+  }
+
+  void add(const std::string &s) { add(s.data(), s.size()); }
+
+  template <typename T> void addValue(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "addValue hashes the object representation.");
+    add(&value, sizeof(value));
+  }
+
+  std::uint64_t value() const {
+    // Finaliser of MurmurHash3, so every input bit affects every output bit.
+    std::uint64_t h = state_;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+private:
+  void mix(std::uint64_t word) {
+    state_ ^= word * 0x9E3779B97F4A7C15ULL;
+    state_ = ((state_ << 31) | (state_ >> 33)) * 0x87C37B91114253D5ULL;
+  }
+
+  std::uint64_t state_ = 0x243F6A8885A308D3ULL;
+};
+
+void addStats(Checksum &checksum, const Domain::Model::Stats &stats) {
+  const int fields[] = {stats.strength, stats.dexterity, stats.intelligence,
+                        stats.vitality, stats.health,    stats.max_health};
+  checksum.addValue(fields);
+}
+
+void addPosition(Checksum &checksum, const Domain::Model::Position &position) {
+  const int fields[] = {position.x, position.y};
+  checksum.addValue(fields);
+}
+
+void addItem(Checksum &checksum, const Domain::Model::Item &item) {
+  checksum.addValue(item.getType());
+  checksum.add(item.getName());
+}
+
+std::uint64_t playerChecksum(const Domain::Model::Player &player) {
+  Checksum checksum;
+  checksum.add(player.getId());
+  const int core[] = {player.getLevel(), player.getXp(), player.getHp()};
+  checksum.addValue(core);
+  addStats(checksum, player.getStats());
+  addPosition(checksum, player.getPosition());
+  for (const auto &item : player.getInventory()) {
+    if (item) {
+      addItem(checksum, *item);
+    }
+  }
+  return checksum.value();
+}
+
+std::uint64_t enemyChecksum(const Domain::Model::Position &position,
+                            const Domain::Model::Enemy &enemy) {
+  Checksum checksum;
+  addPosition(checksum, position);
+  checksum.add(enemy.getTypeName());
+  checksum.add(enemy.getName());
+  addStats(checksum, enemy.getStats());
+  addPosition(checksum, enemy.getPosition());
+  return checksum.value();
+}
+
+std::uint64_t itemChecksum(const Domain::Model::Position &position,
+                           const Domain::Model::Item &item) {
+  Checksum checksum;
+  addPosition(checksum, position);
+  addItem(checksum, item);
+  return checksum.value();
+}
+
+std::uint64_t tilesHeaderChecksum(const Domain::Model::Map &map) {
+  Checksum checksum;
+  const int fields[] = {map.getWidth(), map.getHeight(),
+                        map.getStartPlayerPosition().x,
+                        map.getStartPlayerPosition().y};
+  checksum.addValue(fields);
+  return checksum.value();
+}
+
+// Includes the chunk's index, so equal chunks at different places differ.
+std::uint64_t tileChunkChecksum(const Domain::Model::Map &map,
+                                std::size_t chunk) {
+  const Domain::Model::TileGridView tiles = map.getTiles();
+  const std::size_t first = chunk * GameStateDigest::kTileChunkSize;
+  const std::size_t count =
+      std::min(GameStateDigest::kTileChunkSize, tiles.size() - first);
+  Checksum checksum;
+  checksum.addValue(static_cast<std::uint64_t>(chunk));
+  checksum.add(tiles.data() + first, count * sizeof(Domain::Model::Tile));
+  return checksum.value();
+}
+
+// Replaces the checksum recorded for position, and its share of sum, with
+// checksum (nothing if the position is now empty).
+void replaceEntity(std::map<Domain::Model::Position, std::uint64_t> &entities,
+                   std::uint64_t &sum, const Domain::Model::Position &position,
+                   std::optional<std::uint64_t> checksum) {
+  auto it = entities.find(position);
+  if (it != entities.end()) {
+    sum -= it->second;
+    if (checksum) {
+      it->second = *checksum;
+    } else {
+      entities.erase(it);
+    }
+  } else if (checksum) {
+    entities.emplace(position, *checksum);
+  }
+  if (checksum) {
+    sum += *checksum;
+  }
+}
+
+std::uint64_t recordChecksum(const ManifestRecord &record) {
+  Checksum checksum;
+  checksum.add(&record, offsetof(ManifestRecord, record_checksum));
+  return checksum.value();
+}
+
+} // namespace
+
+bool GameStateManifest::operator==(const GameStateManifest &other) const {
+  return player_checksum == other.player_checksum &&
+         tiles_checksum == other.tiles_checksum &&
+         enemies_checksum == other.enemies_checksum &&
+         items_checksum == other.items_checksum &&
+         inventory_count == other.inventory_count &&
+         enemy_count == other.enemy_count && item_count == other.item_count;
+}
+
+GameStateManifest
+describeGameState(const Port::Out::GameStateDTO &game_state) {
+  GameStateDigest digest;
+  digest.reset(game_state);
+  return digest.manifest();
+}
+
+void GameStateDigest::reset(const Port::Out::GameStateDTO &game_state) {
+  resetMap(game_state.map);
+  describePlayer(game_state.player);
+  described_ = true;
+}
+
+void GameStateDigest::update(const Port::Out::GameStateDTO &game_state) {
+  const Domain::Model::Map &map = game_state.map;
+  const Domain::Model::MapChangeSet &changes = map.getChanges();
+  if (!described_ || changes.full) {
+    reset(game_state);
+    return;
+  }
+
+  if (changes.start_position) {
+    const std::uint64_t header = tilesHeaderChecksum(map);
+    manifest_.tiles_checksum += header - tiles_header_;
+    tiles_header_ = header;
+  }
+  std::set<std::size_t> dirty_chunks;
+  for (std::uint32_t tile_index : changes.tiles) {
+    dirty_chunks.insert(tile_index / kTileChunkSize);
+  }
+  for (std::size_t chunk : dirty_chunks) {
+    const std::uint64_t checksum = tileChunkChecksum(map, chunk);
+    manifest_.tiles_checksum += checksum - tile_chunks_[chunk];
+    tile_chunks_[chunk] = checksum;
+  }
+
+  for (const auto &position : changes.enemies) {
+    std::optional<std::uint64_t> checksum;
+    if (auto enemy = map.getEnemyAt(position)) {
+      checksum = enemyChecksum(position, enemy->get());
+    }
+    replaceEntity(enemies_, manifest_.enemies_checksum, position, checksum);
+  }
+  for (const auto &position : changes.items) {
+    std::optional<std::uint64_t> checksum;
+    if (auto item = map.getItemAt(position)) {
+      checksum = itemChecksum(position, item->get());
+    }
+    replaceEntity(items_, manifest_.items_checksum, position, checksum);
+  }
+  manifest_.enemy_count =
+      static_cast<std::uint32_t>(map.getEnemies().size());
+  manifest_.item_count = static_cast<std::uint32_t>(map.getItems().size());
+
+  // Small, so rehashed on every save.
+  describePlayer(game_state.player);
+}
+
+void GameStateDigest::resetMap(const Domain::Model::Map &map) {
+  tiles_header_ = tilesHeaderChecksum(map);
+  manifest_.tiles_checksum = tiles_header_;
+  const std::size_t tile_count = map.getTiles().size();
+  tile_chunks_.assign((tile_count + kTileChunkSize - 1) / kTileChunkSize, 0);
+  for (std::size_t chunk = 0; chunk < tile_chunks_.size(); ++chunk) {
+    tile_chunks_[chunk] = tileChunkChecksum(map, chunk);
+    manifest_.tiles_checksum += tile_chunks_[chunk];
+  }
+
+  enemies_.clear();
+  manifest_.enemies_checksum = 0;
+  for (const auto &entry : map.getEnemies()) {
+    replaceEntity(enemies_, manifest_.enemies_checksum, entry.position,
+                  enemyChecksum(entry.position, *entry.value));
+  }
+  items_.clear();
+  manifest_.items_checksum = 0;
+  for (const auto &entry : map.getItems()) {
+    replaceEntity(items_, manifest_.items_checksum, entry.position,
+                  itemChecksum(entry.position, *entry.value));
+  }
+  manifest_.enemy_count =
+      static_cast<std::uint32_t>(map.getEnemies().size());
+  manifest_.item_count = static_cast<std::uint32_t>(map.getItems().size());
+}
+
+void GameStateDigest::describePlayer(const Domain::Model::Player &player) {
+  manifest_.player_checksum = playerChecksum(player);
+  manifest_.inventory_count =
+      static_cast<std::uint32_t>(player.getInventory().size());
+}
+
+std::string encodeManifest(const GameStateManifest &manifest) {
+  ManifestRecord record{};
+  std::memcpy(record.magic, kManifestMagic, sizeof(record.magic));
+  record.version = kManifestVersion;
+  record.player_checksum = manifest.player_checksum;
+  record.tiles_checksum = manifest.tiles_checksum;
+  record.enemies_checksum = manifest.enemies_checksum;
+  record.items_checksum = manifest.items_checksum;
+  record.inventory_count = manifest.inventory_count;
+  record.enemy_count = manifest.enemy_count;
+  record.item_count = manifest.item_count;
+  record.record_checksum = recordChecksum(record);
+  return std::string(reinterpret_cast<const char *>(&record), sizeof(record));
+}
+
+std::optional<GameStateManifest> decodeManifest(const std::string &blob) {
+  ManifestRecord record;
+  if (blob.size() != sizeof(record)) {
+    spdlog::error("GameStateManifest: Expected {} bytes, got {}.",
+                  sizeof(record), blob.size());
+    return std::nullopt;
+  }
+  std::memcpy(&record, blob.data(), sizeof(record));
+  if (std::memcmp(record.magic, kManifestMagic, sizeof(record.magic)) != 0 ||
+      record.record_checksum != recordChecksum(record)) {
+    spdlog::error("GameStateManifest: Manifest record is corrupt.");
+    return std::nullopt;
+  }
+  if (record.version != kManifestVersion) {
+    spdlog::error("GameStateManifest: Unsupported manifest version {}.",
+                  record.version);
+    return std::nullopt;
+  }
+
+  GameStateManifest manifest;
+  manifest.player_checksum = record.player_checksum;
+  manifest.tiles_checksum = record.tiles_checksum;
+  manifest.enemies_checksum = record.enemies_checksum;
+  manifest.items_checksum = record.items_checksum;
+  manifest.inventory_count = record.inventory_count;
+  manifest.enemy_count = record.enemy_count;
+  manifest.item_count = record.item_count;
+  return manifest;
+}
+
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
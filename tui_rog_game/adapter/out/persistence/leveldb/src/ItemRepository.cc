@@ -2,6 +2,7 @@
 #include "LevelDbProvider.h"
 #include <algorithm>
 #include <cctype>
+#include <utility>
 #include <spdlog/spdlog.h>
 
 namespace TuiRogGame {
@@ -9,7 +10,24 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
-ItemRepository::ItemRepository() = default;
+ItemRepository::ItemRepository(LevelDbProvider &provider,
+                               const ItemTypeRegistry &types)
+    : provider_(provider), types_(types) {}
+
+const ItemTypeRegistry &ItemRepository::builtinTypes() {
+  using ItemType = Domain::Model::Item::ItemType;
+  static const ItemTypeRegistry types = [] {
+    ItemTypeRegistry registry;
+    registry.add(1, ItemType::HealthPotion, [](std::string name) {
+      return Domain::Model::Item(ItemType::HealthPotion, std::move(name));
+    });
+    registry.add(2, ItemType::StrengthScroll, [](std::string name) {
+      return Domain::Model::Item(ItemType::StrengthScroll, std::move(name));
+    });
+    return registry;
+  }();
+  return types;
+}
 
 std::string ItemRepository::toLower(std::string s) const {
   std::transform(s.begin(), s.end(), s.begin(),
@@ -17,14 +35,6 @@ std::string ItemRepository::toLower(std::string s) const {
   return s;
 }
 
-nlohmann::json
-ItemRepository::serializeItem(const Domain::Model::Item &item) const {
-  nlohmann::json j;
-  j["type"] = static_cast<int>(item.getType());
-  j["name"] = item.getName();
-  return j;
-}
-
 std::optional<Domain::Model::Item>
 ItemRepository::deserializeItem(const nlohmann::json &j) const {
   try {
@@ -43,42 +53,76 @@ ItemRepository::deserializeItem(const nlohmann::json &j) const {
   }
 }
 
-void ItemRepository::saveForBatch(const std::string &key,
+void ItemRepository::saveForBatch(LevelDbBatch &batch,
+                                  const std::string &key,
                                   const Domain::Model::Item &item) {
   std::string lower_key = toLower(key);
-  nlohmann::json j = serializeItem(item);
-  LevelDbProvider::getInstance().addToBatch(lower_key, j.dump());
+  const auto *type = types_.findByKey(item.getType());
+  if (!type) {
+    spdlog::error("ItemRepository: No type tag for item type {}; not saving "
+                  "key '{}'.",
+                  static_cast<int>(item.getType()), lower_key);
+    return;
+  }
+  batch.Put(lower_key, EntityCodec::encodeItem(type->tag, item));
   spdlog::debug("ItemRepository: Added Put for key '{}' to batch.", lower_key);
 }
 
 std::optional<Domain::Model::Item>
-ItemRepository::findById(const std::string &key) {
-  auto &provider = LevelDbProvider::getInstance();
+ItemRepository::findById(const std::string &key,
+                         const LevelDbSnapshot *snapshot) {
   std::string lower_key = toLower(key);
-  auto value_str_opt = provider.Get(lower_key);
+  auto value_str_opt = provider_.Get(lower_key, snapshot);
 
   if (!value_str_opt) {
     return std::nullopt;
   }
+  return decode(lower_key, *value_str_opt);
+}
 
+std::optional<Domain::Model::Item>
+ItemRepository::decode(const std::string &key,
+                       const std::string &value) const {
+  if (EntityCodec::isEncodedRecord(value)) {
+    auto record = EntityCodec::decodeItem(value);
+    if (!record) {
+      spdlog::error("ItemRepository: Malformed item record for key '{}'.",
+                    key);
+      return std::nullopt;
+    }
+    const auto *type = types_.findByTag(record->type_tag);
+    if (!type) {
+      spdlog::error("ItemRepository: Unknown item type tag: {}",
+                    static_cast<int>(record->type_tag));
+      return std::nullopt;
+    }
+    return type->factory(std::move(record->name));
+  }
   try {
-    nlohmann::json j = nlohmann::json::parse(*value_str_opt);
+    nlohmann::json j = nlohmann::json::parse(value);
     return deserializeItem(j);
   } catch (const nlohmann::json::exception &e) {
     spdlog::error("ItemRepository: Failed to parse JSON for key '{}': {}",
-                  lower_key, e.what());
+                  key, e.what());
     return std::nullopt;
   }
 }
 
 void ItemRepository::deleteById(const std::string &key) {
-  auto &provider = LevelDbProvider::getInstance();
   std::string lower_key = toLower(key);
-  if (provider.Delete(lower_key)) {
+  if (provider_.Delete(lower_key)) {
     spdlog::debug("ItemRepository: Deleted key '{}'.", lower_key);
   }
 }
 
+void ItemRepository::deleteForBatch(LevelDbBatch &batch,
+                                    const std::string &key) {
+  std::string lower_key = toLower(key);
+  batch.Delete(lower_key);
+  spdlog::debug("ItemRepository: Added Delete for key '{}' to batch.",
+                lower_key);
+}
+
 } // namespace Persistence
 } // namespace Out
 } // namespace Adapter
@@ -1,10 +1,14 @@
 #include "LevelDbAdapter.h"
 #include "EnemyRepository.h"
+#include "GameStateManifest.h"
 #include "ItemRepository.h"
 #include "LevelDbProvider.h"
 #include "MapRepository.h"
 #include "PlayerRepository.h"
+#include <mutex>
+#include <optional>
 #include <spdlog/spdlog.h>
+#include <utility>
 
 namespace TuiRogGame {
 namespace Adapter {
@@ -12,49 +16,151 @@ namespace Out {
 namespace Persistence {
 
 struct LevelDbAdapter::Impl {
+  std::shared_ptr<LevelDbProvider> provider;
   ItemRepository itemRepo;
   EnemyRepository enemyRepo;
   PlayerRepository playerRepo;
   MapRepository mapRepo;
+  // Change sets are cleared by the engine once a save returns, so after a
+  // failed commit the stored state can only be repaired by a full rewrite.
+  bool needs_full_save = false;
+  std::string player_key;
+  std::string map_key;
+  std::string manifest_key;
 
-  Impl()
-      : itemRepo(), enemyRepo(), playerRepo(itemRepo),
-        mapRepo(enemyRepo, itemRepo) {}
+  // Manifest of the game as saved, kept up to date from each save's change
+  // sets. Only touched by saves.
+  GameStateDigest digest;
+
+  // The game as last loaded by this adapter, with its manifest. Loading it
+  // again while its stored manifest still matches returns a copy instead of
+  // reading and parsing every record. Saves drop it: it shares the map's
+  // storage with the live game, which would make each change copy that
+  // storage for as long as the cache held on to it. Guarded because a
+  // write-behind save may run while another thread loads.
+  std::mutex cache_mutex;
+  std::optional<GameStateManifest> cached_manifest;
+  std::unique_ptr<Port::Out::GameStateDTO> cached_state;
+
+  void cache(const Port::Out::GameStateDTO &game_state,
+             const GameStateManifest &manifest) {
+    auto copy = std::make_unique<Port::Out::GameStateDTO>(game_state);
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cached_manifest = manifest;
+    cached_state = std::move(copy);
+  }
+
+  void dropCache() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cached_manifest.reset();
+    cached_state.reset();
+  }
+
+  Impl(std::shared_ptr<LevelDbProvider> provider_in,
+       const std::string &session_id)
+      : provider(std::move(provider_in)), itemRepo(*provider),
+        enemyRepo(*provider), playerRepo(*provider, itemRepo),
+        mapRepo(*provider, enemyRepo, itemRepo),
+        player_key(session_id + "_player"), map_key(session_id + "_map"),
+        manifest_key(session_id + "_manifest") {}
 };
 
-LevelDbAdapter::LevelDbAdapter(const std::string &db_path)
-    : impl_(std::make_unique<Impl>()) {
-  (void)db_path; // Mark as unused for now
-}
+LevelDbAdapter::LevelDbAdapter(const std::string &db_path,
+                               const std::string &session_id,
+                               const LevelDbOptions &options)
+    : LevelDbAdapter(std::make_shared<LevelDbProvider>(db_path, options),
+                     session_id) {}
+
+LevelDbAdapter::LevelDbAdapter(std::shared_ptr<LevelDbProvider> provider,
+                               const std::string &session_id)
+    : impl_(std::make_unique<Impl>(std::move(provider), session_id)) {}
 
 LevelDbAdapter::~LevelDbAdapter() = default;
 
 void LevelDbAdapter::saveGameState(const Port::Out::GameStateDTO &game_state) {
-  auto &provider = LevelDbProvider::getInstance();
-  provider.startBatch();
+  impl_->dropCache();
 
-  impl_->playerRepo.saveForBatch("main_player", game_state.player);
-  impl_->mapRepo.saveForBatch("main_map", game_state.map);
+  LevelDbBatch batch;
+  if (impl_->needs_full_save) {
+    impl_->playerRepo.saveForBatch(batch, impl_->player_key,
+                                   game_state.player);
+    impl_->mapRepo.saveForBatch(batch, impl_->map_key, game_state.map);
+    impl_->digest.reset(game_state);
+  } else {
+    impl_->playerRepo.saveChangesForBatch(batch, impl_->player_key,
+                                          game_state.player);
+    impl_->mapRepo.saveChangesForBatch(batch, impl_->map_key, game_state.map);
+    impl_->digest.update(game_state);
+  }
+  batch.Put(impl_->manifest_key, encodeManifest(impl_->digest.manifest()));
 
-  if (provider.commitBatch()) {
+  if (impl_->provider->commitBatch(batch)) {
+    impl_->needs_full_save = false;
     spdlog::info("LevelDbAdapter: Game state saved successfully with batch.");
   } else {
+    // The digest now describes a state that was not stored; the full save
+    // this forces also resets it.
+    impl_->needs_full_save = true;
     spdlog::error("LevelDbAdapter: Save operation failed, batch not applied.");
   }
 }
 
 std::unique_ptr<Port::Out::GameStateDTO> LevelDbAdapter::loadGameState() {
-  auto player_opt = impl_->playerRepo.findById("main_player");
-  auto map_opt = impl_->mapRepo.findById("main_map");
+  // One snapshot for every read, so a save landing in between cannot pair
+  // the player of one turn with the map of another, or with another turn's
+  // manifest.
+  auto snapshot = impl_->provider->snapshot();
 
-  if (player_opt && map_opt) {
-    spdlog::info("LevelDbAdapter: Game state loaded.");
-    return std::make_unique<Port::Out::GameStateDTO>(
-        std::move(map_opt.value()), std::move(player_opt.value()));
-  } else {
+  // Games saved before manifests existed have none and load unvalidated.
+  std::optional<GameStateManifest> manifest;
+  if (auto manifest_blob =
+          impl_->provider->Get(impl_->manifest_key, snapshot.get())) {
+    manifest = decodeManifest(*manifest_blob);
+    if (!manifest) {
+      spdlog::error("LevelDbAdapter: Saved game has a corrupt manifest.");
+      return nullptr;
+    }
+  }
+
+  if (manifest) {
+    std::lock_guard<std::mutex> lock(impl_->cache_mutex);
+    if (impl_->cached_state && impl_->cached_manifest == manifest) {
+      auto game_state =
+          std::make_unique<Port::Out::GameStateDTO>(*impl_->cached_state);
+      // As if freshly read, so the next save rewrites everything.
+      game_state->map.markFullyChanged();
+      game_state->player.markFullyChanged();
+      spdlog::info("LevelDbAdapter: Game state loaded from cache.");
+      return game_state;
+    }
+  }
+
+  auto player_opt =
+      impl_->playerRepo.findById(impl_->player_key, snapshot.get());
+  auto map_opt = impl_->mapRepo.findById(impl_->map_key, snapshot.get());
+
+  if (!player_opt || !map_opt) {
     spdlog::warn("LevelDbAdapter: No saved game found or data is partial.");
     return nullptr;
   }
+  auto game_state = std::make_unique<Port::Out::GameStateDTO>(
+      std::move(map_opt.value()), std::move(player_opt.value()));
+
+  if (manifest) {
+    const GameStateManifest loaded = describeGameState(*game_state);
+    if (loaded != *manifest) {
+      spdlog::error("LevelDbAdapter: Saved game does not match its manifest "
+                    "(player {}, tiles {}, enemies {}/{}, items {}/{}).",
+                    loaded.player_checksum == manifest->player_checksum,
+                    loaded.tiles_checksum == manifest->tiles_checksum,
+                    loaded.enemy_count, manifest->enemy_count,
+                    loaded.item_count, manifest->item_count);
+      return nullptr;
+    }
+    impl_->cache(*game_state, *manifest);
+  }
+  spdlog::info("LevelDbAdapter: Game state loaded.");
+  return game_state;
 }
 
 } // namespace Persistence
@@ -1,5 +1,8 @@
 #include "LevelDbProvider.h"
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
+#include <leveldb/iterator.h>
 #include <leveldb/write_batch.h>
 #include <spdlog/spdlog.h>
 
@@ -8,37 +11,80 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
-LevelDbProvider &LevelDbProvider::getInstance() {
-  static LevelDbProvider instance;
-  return instance;
+namespace {
+leveldb::WriteOptions writeOptions(bool sync) {
+  leveldb::WriteOptions options;
+  options.sync = sync;
+  return options;
 }
+} // namespace
 
-LevelDbProvider::LevelDbProvider() {
-  leveldb::DB *db_raw = nullptr;
-  leveldb::Options options;
-  options.create_if_missing = true;
-  const std::string db_path = "game.db"; // Or from config
+LevelDbBatch::LevelDbBatch()
+    : batch_(std::make_unique<leveldb::WriteBatch>()) {}
+
+LevelDbBatch::~LevelDbBatch() = default;
+LevelDbBatch::LevelDbBatch(LevelDbBatch &&) noexcept = default;
+LevelDbBatch &LevelDbBatch::operator=(LevelDbBatch &&) noexcept = default;
+
+void LevelDbBatch::Put(const std::string &key, const std::string &value) {
+  batch_->Put(key, value);
+  ++operation_count_;
+}
+
+void LevelDbBatch::Delete(const std::string &key) {
+  batch_->Delete(key);
+  ++operation_count_;
+}
+
+void LevelDbBatch::clear() {
+  batch_->Clear();
+  operation_count_ = 0;
+}
+
+LevelDbSnapshot::~LevelDbSnapshot() { db_.ReleaseSnapshot(snapshot_); }
+
+LevelDbProvider::LevelDbProvider(const std::string &db_path,
+                                 const LevelDbOptions &options)
+    : db_path_(db_path), sync_(options.sync) {
+  leveldb::Options db_options;
+  db_options.create_if_missing = true;
+  db_options.write_buffer_size = options.write_buffer_bytes;
+  db_options.compression = options.compression ? leveldb::kSnappyCompression
+                                               : leveldb::kNoCompression;
+  if (options.block_cache_bytes > 0) {
+    block_cache_.reset(leveldb::NewLRUCache(options.block_cache_bytes));
+    db_options.block_cache = block_cache_.get();
+  }
+  if (options.bloom_bits_per_key > 0) {
+    filter_policy_.reset(
+        leveldb::NewBloomFilterPolicy(options.bloom_bits_per_key));
+    db_options.filter_policy = filter_policy_.get();
+  }
 
-  leveldb::Status status = leveldb::DB::Open(options, db_path, &db_raw);
+  leveldb::DB *db_raw = nullptr;
+  leveldb::Status status = leveldb::DB::Open(db_options, db_path_, &db_raw);
   if (status.ok()) {
     db_.reset(db_raw);
-    spdlog::info("LevelDbProvider: Successfully opened LevelDB at {}", db_path);
+    spdlog::info("LevelDbProvider: Successfully opened LevelDB at {}",
+                 db_path_);
   } else {
-    spdlog::error("LevelDbProvider: Failed to open LevelDB at {}: {}", db_path,
-                  status.ToString());
-    db_ = nullptr;
+    spdlog::error("LevelDbProvider: Failed to open LevelDB at {}: {}",
+                  db_path_, status.ToString());
   }
 }
 
 LevelDbProvider::~LevelDbProvider() = default;
 
-std::optional<std::string> LevelDbProvider::Get(const std::string &key) {
+std::optional<std::string>
+LevelDbProvider::Get(const std::string &key, const LevelDbSnapshot *snapshot) {
   if (!db_) {
     spdlog::error("LevelDbProvider: Cannot Get, DB not open.");
     return std::nullopt;
   }
+  leveldb::ReadOptions read_options;
+  read_options.snapshot = snapshot ? snapshot->snapshot_ : nullptr;
   std::string value;
-  leveldb::Status status = db_->Get(leveldb::ReadOptions(), key, &value);
+  leveldb::Status status = db_->Get(read_options, key, &value);
   if (status.ok()) {
     return value;
   } else {
@@ -50,12 +96,69 @@ std::optional<std::string> LevelDbProvider::Get(const std::string &key) {
   }
 }
 
+std::optional<std::vector<std::pair<std::string, std::string>>>
+LevelDbProvider::scanPrefix(const std::string &prefix,
+                            const LevelDbSnapshot *snapshot) {
+  if (!db_) {
+    spdlog::error("LevelDbProvider: Cannot scan, DB not open.");
+    return std::nullopt;
+  }
+  leveldb::ReadOptions read_options;
+  read_options.snapshot = snapshot ? snapshot->snapshot_ : nullptr;
+  std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(read_options));
+
+  std::vector<std::pair<std::string, std::string>> records;
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
+       it->Next()) {
+    records.emplace_back(it->key().ToString(), it->value().ToString());
+  }
+  if (!it->status().ok()) {
+    spdlog::error("LevelDbProvider: Failed to scan prefix '{}': {}", prefix,
+                  it->status().ToString());
+    return std::nullopt;
+  }
+  return records;
+}
+
+std::optional<std::vector<std::string>>
+LevelDbProvider::scanKeys(const std::string &prefix,
+                          const LevelDbSnapshot *snapshot) {
+  if (!db_) {
+    spdlog::error("LevelDbProvider: Cannot scan, DB not open.");
+    return std::nullopt;
+  }
+  leveldb::ReadOptions read_options;
+  read_options.snapshot = snapshot ? snapshot->snapshot_ : nullptr;
+  std::unique_ptr<leveldb::Iterator> it(db_->NewIterator(read_options));
+
+  std::vector<std::string> keys;
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
+       it->Next()) {
+    keys.push_back(it->key().ToString());
+  }
+  if (!it->status().ok()) {
+    spdlog::error("LevelDbProvider: Failed to scan prefix '{}': {}", prefix,
+                  it->status().ToString());
+    return std::nullopt;
+  }
+  return keys;
+}
+
+std::unique_ptr<LevelDbSnapshot> LevelDbProvider::snapshot() {
+  if (!db_) {
+    spdlog::error("LevelDbProvider: Cannot take snapshot, DB not open.");
+    return nullptr;
+  }
+  return std::unique_ptr<LevelDbSnapshot>(
+      new LevelDbSnapshot(*db_, db_->GetSnapshot()));
+}
+
 bool LevelDbProvider::Put(const std::string &key, const std::string &value) {
   if (!db_) {
     spdlog::error("LevelDbProvider: Cannot Put, DB not open.");
     return false;
   }
-  leveldb::Status status = db_->Put(leveldb::WriteOptions(), key, value);
+  leveldb::Status status = db_->Put(writeOptions(sync_), key, value);
   if (!status.ok()) {
     spdlog::error("LevelDbProvider: Failed to Put key '{}': {}", key,
                   status.ToString());
@@ -68,7 +171,7 @@ bool LevelDbProvider::Delete(const std::string &key) {
     spdlog::error("LevelDbProvider: Cannot Delete, DB not open.");
     return false;
   }
-  leveldb::Status status = db_->Delete(leveldb::WriteOptions(), key);
+  leveldb::Status status = db_->Delete(writeOptions(sync_), key);
   if (!status.ok()) {
     spdlog::error("LevelDbProvider: Failed to Delete key '{}': {}", key,
                   status.ToString());
@@ -76,42 +179,18 @@ bool LevelDbProvider::Delete(const std::string &key) {
   return status.ok();
 }
 
-void LevelDbProvider::startBatch() {
-  current_batch_ = std::make_unique<leveldb::WriteBatch>();
-}
-
-void LevelDbProvider::addToBatch(const std::string &key,
-                                 const std::string &value) {
-  if (current_batch_) {
-    current_batch_->Put(key, value);
-  } else {
-    spdlog::warn(
-        "LevelDbProvider: addToBatch called without starting a batch.");
-  }
-}
-
-void LevelDbProvider::deleteFromBatch(const std::string &key) {
-  if (current_batch_) {
-    current_batch_->Delete(key);
-  } else {
-    spdlog::warn(
-        "LevelDbProvider: deleteFromBatch called without starting a batch.");
-  }
-}
-
-bool LevelDbProvider::commitBatch() {
+bool LevelDbProvider::commitBatch(LevelDbBatch &batch) {
   if (!db_) {
     spdlog::error("LevelDbProvider: Cannot commit batch, DB not open.");
+    batch.clear();
     return false;
   }
-  if (!current_batch_) {
-    spdlog::warn("LevelDbProvider: commitBatch called with no active batch.");
+  if (batch.empty()) {
     return true; // Nothing to do
   }
 
-  leveldb::Status status =
-      db_->Write(leveldb::WriteOptions(), current_batch_.get());
-  current_batch_.reset(); // Clear the batch after commit
+  leveldb::Status status = db_->Write(writeOptions(sync_), batch.batch_.get());
+  batch.clear();
 
   if (!status.ok()) {
     spdlog::error("LevelDbProvider: Failed to commit WriteBatch: {}",
@@ -0,0 +1,203 @@
+#include "MapCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <type_traits>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+namespace MapCodec {
+
+namespace {
+
+constexpr std::size_t kTileChunkHeaderSize = 2;
+constexpr std::size_t kRunSize = 3; // uint8 tile + uint16 length
+constexpr std::uint16_t kMaxRunLength = 0xFFFF;
+
+constexpr char kLayoutMagic[4] = {'T', 'R', 'M', 'L'};
+constexpr std::uint16_t kLayoutVersion = 1;
+
+struct LayoutHeader {
+  char magic[4];
+  std::uint16_t version;
+  std::uint16_t reserved;
+  std::int32_t width;
+  std::int32_t height;
+  std::uint32_t enemy_count;
+  std::uint32_t item_count;
+};
+
+struct EntityRecord {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+static_assert(std::is_standard_layout<LayoutHeader>::value &&
+                  std::is_trivially_copyable<LayoutHeader>::value,
+              "LayoutHeader is written with memcpy.");
+static_assert(std::is_standard_layout<EntityRecord>::value &&
+                  sizeof(EntityRecord) == 8,
+              "EntityRecord must be a fixed 8-byte record.");
+
+std::size_t countRuns(const Domain::Model::Tile *tiles, std::size_t count) {
+  std::size_t runs = 0;
+  std::size_t i = 0;
+  while (i < count) {
+    std::size_t run = 1;
+    while (i + run < count && tiles[i + run] == tiles[i] &&
+           run < kMaxRunLength) {
+      ++run;
+    }
+    ++runs;
+    i += run;
+  }
+  return runs;
+}
+
+void appendRecord(std::string &out, const Domain::Model::Position &position) {
+  EntityRecord record{position.x, position.y};
+  out.append(reinterpret_cast<const char *>(&record), sizeof(record));
+}
+
+} // namespace
+
+std::string encodeTileChunk(const Domain::Model::Tile *tiles,
+                            std::size_t count) {
+  std::string out;
+  const std::size_t runs = countRuns(tiles, count);
+  if (runs * kRunSize < count) {
+    out.reserve(kTileChunkHeaderSize + runs * kRunSize);
+    out.push_back(static_cast<char>(kTileChunkMagic));
+    out.push_back(static_cast<char>(TileCodec::RLE));
+    std::size_t i = 0;
+    while (i < count) {
+      std::uint16_t run = 1;
+      while (i + run < count && tiles[i + run] == tiles[i] &&
+             run < kMaxRunLength) {
+        ++run;
+      }
+      out.push_back(static_cast<char>(tiles[i]));
+      out.append(reinterpret_cast<const char *>(&run), sizeof(run));
+      i += run;
+    }
+  } else {
+    out.reserve(kTileChunkHeaderSize + count);
+    out.push_back(static_cast<char>(kTileChunkMagic));
+    out.push_back(static_cast<char>(TileCodec::RAW));
+    out.append(reinterpret_cast<const char *>(tiles), count);
+  }
+  return out;
+}
+
+bool decodeTileChunk(const std::string &blob, Domain::Model::Tile *out,
+                     std::size_t count) {
+  if (blob.empty() ||
+      static_cast<std::uint8_t>(blob[0]) != kTileChunkMagic) {
+    // Header-less chunk from before the codec existed.
+    if (blob.size() != count) {
+      return false;
+    }
+    std::memcpy(out, blob.data(), count);
+    return true;
+  }
+
+  if (blob.size() < kTileChunkHeaderSize) {
+    return false;
+  }
+  const char *payload = blob.data() + kTileChunkHeaderSize;
+  const std::size_t payload_size = blob.size() - kTileChunkHeaderSize;
+
+  switch (static_cast<TileCodec>(blob[1])) {
+  case TileCodec::RAW:
+    if (payload_size != count) {
+      return false;
+    }
+    std::memcpy(out, payload, count);
+    return true;
+  case TileCodec::RLE: {
+    if (payload_size % kRunSize != 0) {
+      return false;
+    }
+    std::size_t written = 0;
+    for (std::size_t offset = 0; offset < payload_size; offset += kRunSize) {
+      const auto tile = static_cast<Domain::Model::Tile>(payload[offset]);
+      std::uint16_t run;
+      std::memcpy(&run, payload + offset + 1, sizeof(run));
+      if (run == 0 || written + run > count) {
+        return false;
+      }
+      std::fill(out + written, out + written + run, tile);
+      written += run;
+    }
+    return written == count;
+  }
+  }
+  spdlog::error("MapCodec: Unknown tile codec {}.",
+                static_cast<int>(static_cast<std::uint8_t>(blob[1])));
+  return false;
+}
+
+std::string encodeEntityLayout(const Domain::Model::Map &map) {
+  LayoutHeader header{};
+  std::memcpy(header.magic, kLayoutMagic, sizeof(header.magic));
+  header.version = kLayoutVersion;
+  header.width = map.getWidth();
+  header.height = map.getHeight();
+  header.enemy_count = static_cast<std::uint32_t>(map.getEnemies().size());
+  header.item_count = static_cast<std::uint32_t>(map.getItems().size());
+
+  std::string out;
+  out.reserve(sizeof(header) +
+              (header.enemy_count + header.item_count) * sizeof(EntityRecord));
+  out.append(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (const auto &entry : map.getEnemies()) {
+    appendRecord(out, entry.position);
+  }
+  for (const auto &entry : map.getItems()) {
+    appendRecord(out, entry.position);
+  }
+  return out;
+}
+
+std::optional<EntityLayout> decodeEntityLayout(const std::string &blob) {
+  LayoutHeader header;
+  if (blob.size() < sizeof(header)) {
+    return std::nullopt;
+  }
+  std::memcpy(&header, blob.data(), sizeof(header));
+  if (std::memcmp(header.magic, kLayoutMagic, sizeof(header.magic)) != 0) {
+    return std::nullopt;
+  }
+  if (header.version != kLayoutVersion) {
+    spdlog::error("MapCodec: Unsupported entity layout version {}.",
+                  header.version);
+    return std::nullopt;
+  }
+  const std::size_t record_count =
+      static_cast<std::size_t>(header.enemy_count) + header.item_count;
+  if (blob.size() != sizeof(header) + record_count * sizeof(EntityRecord)) {
+    return std::nullopt;
+  }
+
+  EntityLayout layout;
+  layout.width = header.width;
+  layout.height = header.height;
+  layout.enemies.reserve(header.enemy_count);
+  layout.items.reserve(header.item_count);
+  const char *records = blob.data() + sizeof(header);
+  for (std::size_t i = 0; i < record_count; ++i) {
+    EntityRecord record;
+    std::memcpy(&record, records + i * sizeof(record), sizeof(record));
+    auto &target = i < header.enemy_count ? layout.enemies : layout.items;
+    target.push_back({record.x, record.y});
+  }
+  return layout;
+}
+
+} // namespace MapCodec
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
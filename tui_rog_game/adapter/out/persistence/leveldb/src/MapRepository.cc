@@ -1,17 +1,25 @@
 #include "MapRepository.h"
 #include "LevelDbProvider.h"
+#include "MapCodec.h"
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstring>
+#include <set>
 #include <spdlog/spdlog.h>
+#include <string_view>
+#include <system_error>
 
 namespace TuiRogGame {
 namespace Adapter {
 namespace Out {
 namespace Persistence {
 
-MapRepository::MapRepository(EnemyRepository &enemy_repo,
+MapRepository::MapRepository(LevelDbProvider &provider,
+                             EnemyRepository &enemy_repo,
                              ItemRepository &item_repo)
-    : enemy_repo_(enemy_repo), item_repo_(item_repo) {}
+    : provider_(provider), enemy_repo_(enemy_repo), item_repo_(item_repo),
+      map_dimensions_crud_(provider), map_start_position_crud_(provider) {}
 
 std::string MapRepository::toLower(std::string s) const {
   std::transform(s.begin(), s.end(), s.begin(),
@@ -19,53 +27,52 @@ std::string MapRepository::toLower(std::string s) const {
   return s;
 }
 
-nlohmann::json
-MapRepository::serializeMapNonStandard(const Domain::Model::Map &map) const {
-  nlohmann::json j;
+// Entity records are keyed by position: at most one enemy and one item can
+// occupy a tile, while names are shared by every enemy of a kind.
+std::string
+MapRepository::entityId(const Domain::Model::Position &position) const {
+  return std::to_string(position.x) + "_" + std::to_string(position.y);
+}
 
-  nlohmann::json tiles_json = nlohmann::json::array();
-  for (int y = 0; y < map.getHeight(); ++y) {
-    nlohmann::json row_json = nlohmann::json::array();
-    for (int x = 0; x < map.getWidth(); ++x) {
-      row_json.push_back(static_cast<int>(map.getTile(x, y)));
-    }
-    tiles_json.push_back(row_json);
+std::optional<std::vector<Domain::Model::Tile>>
+MapRepository::deserializeMapTiles(const std::string &blob, int width,
+                                   int height) const {
+  const std::size_t expected = static_cast<std::size_t>(width) * height;
+  if (blob.size() != expected * sizeof(Domain::Model::Tile)) {
+    spdlog::error("MapRepository: Tile blob length mismatch. Expected {} "
+                  "bytes, got {} bytes.",
+                  expected * sizeof(Domain::Model::Tile), blob.size());
+    return std::nullopt;
   }
-  j["tiles"] = tiles_json;
+  std::vector<Domain::Model::Tile> tiles(expected);
+  std::memcpy(tiles.data(), blob.data(), blob.size());
+  return tiles;
+}
 
-  nlohmann::json enemies_json = nlohmann::json::array();
-  for (const auto &pair : map.getEnemies()) {
-    enemies_json.push_back(
-        {{"position", {{"x", pair.first.x}, {"y", pair.first.y}}},
-         {"id", pair.second->getName()}}); // Using name as ID for now
+// Maps saved before the flat tile blob kept tiles as nested JSON rows.
+std::optional<std::vector<Domain::Model::Tile>>
+MapRepository::deserializeLegacyMapTiles(const nlohmann::json &j, int width,
+                                         int height) const {
+  if (!j.contains("tiles") || !j["tiles"].is_array() ||
+      j["tiles"].size() != static_cast<std::size_t>(height)) {
+    return std::nullopt;
   }
-  j["enemies"] = enemies_json;
-
-  nlohmann::json items_json = nlohmann::json::array();
-  for (const auto &pair : map.getItems()) {
-    items_json.push_back(
-        {{"position", {{"x", pair.first.x}, {"y", pair.first.y}}},
-         {"id", pair.second->getName()}}); // Using name as ID for now
+  // Every row is checked before reserving, so a corrupt width cannot ask for
+  // more tiles than the record holds.
+  for (const auto &row_json : j["tiles"]) {
+    if (!row_json.is_array() ||
+        row_json.size() != static_cast<std::size_t>(width)) {
+      return std::nullopt;
+    }
   }
-  j["items"] = items_json;
-
-  return j;
-}
-
-std::optional<std::vector<std::vector<Domain::Model::Tile>>>
-MapRepository::deserializeMapTiles(const nlohmann::json &j) const {
-  if (j.contains("tiles") && j["tiles"].is_array()) {
-    std::vector<std::vector<Domain::Model::Tile>> tiles;
-    for (const auto &row_json : j["tiles"]) {
-      std::vector<Domain::Model::Tile> row;
-      for (const auto &tile_json : row_json) {
-        row.push_back(static_cast<Domain::Model::Tile>(tile_json.get<int>()));
-      }
-      tiles.push_back(row);
+  std::vector<Domain::Model::Tile> tiles;
+  tiles.reserve(static_cast<std::size_t>(width) * height);
+  for (const auto &row_json : j["tiles"]) {
+    for (const auto &tile_json : row_json) {
+      tiles.push_back(static_cast<Domain::Model::Tile>(tile_json.get<int>()));
     }
-    return tiles;
   }
-  return std::nullopt;
+  return tiles;
 }
 
 std::vector<std::pair<Domain::Model::Position, std::string>>
@@ -98,122 +105,404 @@ MapRepository::deserializeMapItemIds(const nlohmann::json &j) const {
   return item_ids;
 }
 
-void MapRepository::saveForBatch(const std::string &key,
+void MapRepository::saveForBatch(LevelDbBatch &batch,
+                                 const std::string &key,
                                  const Domain::Model::Map &map) {
   std::string base_key = toLower(key);
 
+  // Whatever an earlier map left under this key goes first: entities at
+  // positions that are now empty and tile chunks past the new count would
+  // otherwise outlive it. Keys saved again below are simply put back, as
+  // the batch applies in order.
+  if (auto old_keys = provider_.scanKeys(base_key + ":")) {
+    for (const auto &old_key : *old_keys) {
+      batch.Delete(old_key);
+    }
+  }
+
   Domain::Model::MapDimensions dimensions = {map.getWidth(), map.getHeight()};
-  map_dimensions_crud_.saveForBatch(base_key + ":dimensions", dimensions);
-  map_start_position_crud_.saveForBatch(base_key + ":start_position",
+  map_dimensions_crud_.saveForBatch(batch, base_key + ":dimensions",
+                                    dimensions);
+  map_start_position_crud_.saveForBatch(batch, base_key + ":start_position",
                                         map.getStartPlayerPosition());
 
-  nlohmann::json j = serializeMapNonStandard(map);
-  LevelDbProvider::getInstance().addToBatch(base_key + ":non_standard",
-                                            j.dump());
-  spdlog::debug(
-      "MapRepository: Added non-standard parts for key '{}' to batch.",
-      base_key);
+  const std::size_t chunk_count =
+      (map.getTiles().size() + kTileChunkSize - 1) / kTileChunkSize;
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    saveTileChunkForBatch(batch, base_key, map, chunk);
+  }
+
+  batch.Put(base_key + ":layout", MapCodec::encodeEntityLayout(map));
+  spdlog::debug("MapRepository: Added tiles and entity layout for key '{}' "
+                "to batch.",
+                base_key);
 
-  for (const auto &pair : map.getEnemies()) {
-    enemy_repo_.saveForBatch(base_key + ":enemies:" + pair.second->getName(),
-                             *pair.second); // Using name as ID
+  for (const auto &entry : map.getEnemies()) {
+    enemy_repo_.saveForBatch(batch,
+                             base_key + ":enemies:" + entityId(entry.position),
+                             *entry.value);
   }
-  for (const auto &pair : map.getItems()) {
-    item_repo_.saveForBatch(base_key + ":items:" + pair.second->getName(),
-                            *pair.second); // Using name as ID
+  for (const auto &entry : map.getItems()) {
+    item_repo_.saveForBatch(batch,
+                            base_key + ":items:" + entityId(entry.position),
+                            *entry.value);
   }
   spdlog::debug("MapRepository: Added map '{}' and its entities to batch.",
                 base_key);
 }
 
+void MapRepository::saveChangesForBatch(LevelDbBatch &batch,
+                                        const std::string &key,
+                                        const Domain::Model::Map &map) {
+  const Domain::Model::MapChangeSet &changes = map.getChanges();
+  if (changes.full) {
+    saveForBatch(batch, key, map);
+    return;
+  }
+
+  std::string base_key = toLower(key);
+
+  if (changes.start_position) {
+    map_start_position_crud_.saveForBatch(batch, base_key + ":start_position",
+                                          map.getStartPlayerPosition());
+  }
+
+  std::set<std::size_t> dirty_chunks;
+  for (std::uint32_t tile_index : changes.tiles) {
+    dirty_chunks.insert(tile_index / kTileChunkSize);
+  }
+  for (std::size_t chunk : dirty_chunks) {
+    saveTileChunkForBatch(batch, base_key, map, chunk);
+  }
+
+  std::set<Domain::Model::Position> dirty_enemies(changes.enemies.begin(),
+                                                  changes.enemies.end());
+  for (const auto &position : dirty_enemies) {
+    std::string enemy_key = base_key + ":enemies:" + entityId(position);
+    if (auto enemy_opt = map.getEnemyAt(position)) {
+      enemy_repo_.saveForBatch(batch, enemy_key, enemy_opt->get());
+    } else {
+      enemy_repo_.deleteForBatch(batch, enemy_key);
+    }
+  }
+
+  std::set<Domain::Model::Position> dirty_items(changes.items.begin(),
+                                                changes.items.end());
+  for (const auto &position : dirty_items) {
+    std::string item_key = base_key + ":items:" + entityId(position);
+    if (auto item_opt = map.getItemAt(position)) {
+      item_repo_.saveForBatch(batch, item_key, item_opt->get());
+    } else {
+      item_repo_.deleteForBatch(batch, item_key);
+    }
+  }
+
+  // The entity layout is small; rewrite it whenever an entity came or went.
+  if (!dirty_enemies.empty() || !dirty_items.empty()) {
+    batch.Put(base_key + ":layout", MapCodec::encodeEntityLayout(map));
+  }
+
+  spdlog::debug("MapRepository: Added {} tile chunk(s), {} enemy and {} item "
+                "change(s) for map '{}' to batch.",
+                dirty_chunks.size(), dirty_enemies.size(), dirty_items.size(),
+                base_key);
+}
+
+void MapRepository::saveTileChunkForBatch(LevelDbBatch &batch,
+                                          const std::string &base_key,
+                                          const Domain::Model::Map &map,
+                                          std::size_t chunk) const {
+  Domain::Model::TileGridView tiles = map.getTiles();
+  const std::size_t begin = chunk * kTileChunkSize;
+  const std::size_t count = std::min(kTileChunkSize, tiles.size() - begin);
+  batch.Put(base_key + ":tiles:" + std::to_string(chunk),
+            MapCodec::encodeTileChunk(tiles.data() + begin, count));
+}
+
+namespace {
+// Binary search in (id, record) pairs sorted by id.
+const std::string *findRecord(
+    const std::vector<std::pair<std::string_view, const std::string *>>
+        &records,
+    std::string_view id) {
+  auto it = std::lower_bound(
+      records.begin(), records.end(), id,
+      [](const auto &record, std::string_view key) {
+        return record.first < key;
+      });
+  return it != records.end() && it->first == id ? it->second : nullptr;
+}
+} // namespace
+
+std::optional<std::vector<Domain::Model::Tile>>
+MapRepository::decodeTileChunks(
+    const std::string &base_key,
+    const std::vector<std::pair<std::size_t, const std::string *>>
+        &chunk_records,
+    int width, int height) const {
+  const std::size_t tile_count = static_cast<std::size_t>(width) * height;
+  const std::size_t chunk_count =
+      (tile_count + kTileChunkSize - 1) / kTileChunkSize;
+  // Counted before allocating, so corrupt dimensions cannot ask for more
+  // tiles than were stored. Chunks past the end are ignored.
+  std::size_t stored = 0;
+  for (const auto &chunk_record : chunk_records) {
+    if (chunk_record.first < chunk_count) {
+      ++stored;
+    }
+  }
+  if (stored != chunk_count) {
+    spdlog::error("MapRepository: Map '{}' of {}x{} tiles needs {} tile "
+                  "chunk(s), found {}.",
+                  base_key, width, height, chunk_count, stored);
+    return std::nullopt;
+  }
+  std::vector<const std::string *> records(chunk_count, nullptr);
+  for (const auto &chunk_record : chunk_records) {
+    if (chunk_record.first < chunk_count) {
+      records[chunk_record.first] = chunk_record.second;
+    }
+  }
+
+  std::vector<Domain::Model::Tile> tiles(tile_count);
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    const std::string *record = records[chunk];
+    const std::size_t begin = chunk * kTileChunkSize;
+    const std::size_t count = std::min(kTileChunkSize, tile_count - begin);
+    if (!record ||
+        !MapCodec::decodeTileChunk(*record, tiles.data() + begin, count)) {
+      spdlog::error("MapRepository: Tile chunk {} for key '{}' is missing or "
+                    "malformed.",
+                    chunk, base_key);
+      return std::nullopt;
+    }
+  }
+  return tiles;
+}
+
 std::optional<Domain::Model::Map>
-MapRepository::findById(const std::string &key) {
+MapRepository::findById(const std::string &key,
+                        const LevelDbSnapshot *snapshot) {
   std::string base_key = toLower(key);
+  const std::string prefix = base_key + ":";
 
-  auto dimensions_opt = map_dimensions_crud_.findById(base_key + ":dimensions");
-  auto start_pos_opt =
-      map_start_position_crud_.findById(base_key + ":start_position");
+  // Every record of a map lives under "<map>:", so a single scan reads the
+  // whole map, however many entities it has.
+  auto records_opt = provider_.scanPrefix(prefix, snapshot);
+  if (!records_opt) {
+    return std::nullopt;
+  }
 
-  if (!dimensions_opt || !start_pos_opt) {
+  const std::string *dimensions_record = nullptr;
+  const std::string *start_position_record = nullptr;
+  const std::string *layout_record = nullptr;
+  const std::string *legacy_tiles_record = nullptr;
+  const std::string *non_standard_record = nullptr;
+  // (chunk index, record) pairs, in key rather than index order.
+  std::vector<std::pair<std::size_t, const std::string *>> tile_chunk_records;
+  // (entity id, record) pairs. The scan returns keys in order, so these are
+  // sorted by id; the ids point into the scanned keys.
+  std::vector<std::pair<std::string_view, const std::string *>> enemy_records;
+  std::vector<std::pair<std::string_view, const std::string *>> item_records;
+
+  constexpr std::string_view kTilesField = "tiles:";
+  constexpr std::string_view kEnemiesField = "enemies:";
+  constexpr std::string_view kItemsField = "items:";
+  auto startsWith = [](std::string_view s, std::string_view start) {
+    return s.substr(0, start.size()) == start;
+  };
+
+  for (const auto &record : *records_opt) {
+    const std::string_view field =
+        std::string_view(record.first).substr(prefix.size());
+    const std::string *value = &record.second;
+    if (field == "dimensions") {
+      dimensions_record = value;
+    } else if (field == "start_position") {
+      start_position_record = value;
+    } else if (field == "layout") {
+      layout_record = value;
+    } else if (field == "tiles") {
+      legacy_tiles_record = value;
+    } else if (field == "non_standard") {
+      non_standard_record = value;
+    } else if (startsWith(field, kTilesField)) {
+      const std::string_view index = field.substr(kTilesField.size());
+      std::size_t chunk = 0;
+      auto result =
+          std::from_chars(index.data(), index.data() + index.size(), chunk);
+      if (result.ec != std::errc() ||
+          result.ptr != index.data() + index.size()) {
+        spdlog::warn("MapRepository: Ignoring unexpected key '{}'.",
+                     record.first);
+        continue;
+      }
+      tile_chunk_records.emplace_back(chunk, value);
+    } else if (startsWith(field, kEnemiesField)) {
+      enemy_records.emplace_back(field.substr(kEnemiesField.size()), value);
+    } else if (startsWith(field, kItemsField)) {
+      item_records.emplace_back(field.substr(kItemsField.size()), value);
+    }
+  }
+
+  if (!dimensions_record || !start_position_record) {
     spdlog::debug("MapRepository: Missing standard layout parts for key '{}'.",
                   base_key);
     return std::nullopt;
   }
-
-  auto &provider = LevelDbProvider::getInstance();
-  auto non_standard_json_str_opt = provider.Get(base_key + ":non_standard");
-  if (!non_standard_json_str_opt) {
-    spdlog::debug("MapRepository: Missing non-standard parts for key '{}'.",
-                  base_key);
+  auto dimensions_opt =
+      StandardLayoutCrudRepository<Domain::Model::MapDimensions>::decode(
+          prefix + "dimensions", *dimensions_record);
+  auto start_pos_opt =
+      StandardLayoutCrudRepository<Domain::Model::Position>::decode(
+          prefix + "start_position", *start_position_record);
+  if (!dimensions_opt || !start_pos_opt) {
     return std::nullopt;
   }
 
-  try {
-    nlohmann::json j = nlohmann::json::parse(*non_standard_json_str_opt);
-    auto tiles_opt = deserializeMapTiles(j);
-    std::vector<std::pair<Domain::Model::Position, std::string>>
-        enemy_ids_and_pos = deserializeMapEnemyIds(j);
-    std::vector<std::pair<Domain::Model::Position, std::string>>
-        item_ids_and_pos = deserializeMapItemIds(j);
+  const int width = dimensions_opt->width;
+  const int height = dimensions_opt->height;
+  if (width <= 0 || height <= 0) {
+    spdlog::error("MapRepository: Map '{}' has invalid dimensions {}x{}.",
+                  base_key, width, height);
+    return std::nullopt;
+  }
 
-    if (!tiles_opt) {
-      spdlog::error(
-          "MapRepository: Failed to deserialize map tiles for key '{}'.",
-          base_key);
+  std::optional<std::vector<Domain::Model::Tile>> tiles_opt;
+  std::vector<std::pair<Domain::Model::Position, std::string>>
+      enemy_ids_and_pos;
+  std::vector<std::pair<Domain::Model::Position, std::string>>
+      item_ids_and_pos;
+
+  if (layout_record) {
+    auto layout_opt = MapCodec::decodeEntityLayout(*layout_record);
+    if (!layout_opt || layout_opt->width != width ||
+        layout_opt->height != height) {
+      spdlog::error("MapRepository: Malformed entity layout for key '{}'.",
+                    base_key);
       return std::nullopt;
     }
-
-    std::map<Domain::Model::Position, std::unique_ptr<Domain::Model::Enemy>>
-        loaded_enemies;
-    for (const auto &pair : enemy_ids_and_pos) {
-      auto enemy_opt = enemy_repo_.findById(
-          base_key + ":enemies:" + pair.second); // Use full enemy ID
-      if (enemy_opt) {
-        loaded_enemies[pair.first] = std::move(enemy_opt);
-      } else {
-        spdlog::warn("MapRepository: Enemy '{}' not found for map '{}'.",
-                     pair.second, base_key);
-      }
+    for (const auto &position : layout_opt->enemies) {
+      enemy_ids_and_pos.push_back({position, entityId(position)});
     }
-
-    std::map<Domain::Model::Position, std::unique_ptr<Domain::Model::Item>>
-        loaded_items;
-    for (const auto &pair : item_ids_and_pos) {
-      auto item_opt = item_repo_.findById(
-          base_key + ":items:" + pair.second); // Use full item ID
-      if (item_opt) {
-        loaded_items[pair.first] =
-            std::make_unique<Domain::Model::Item>(item_opt.value());
+    for (const auto &position : layout_opt->items) {
+      item_ids_and_pos.push_back({position, entityId(position)});
+    }
+    tiles_opt = decodeTileChunks(base_key, tile_chunk_records, width, height);
+  } else {
+    // Maps saved before the binary layout keep their entity list, and
+    // possibly their tiles, in the ":non_standard" JSON record.
+    if (!non_standard_record) {
+      spdlog::debug("MapRepository: Missing entity layout for key '{}'.",
+                    base_key);
+      return std::nullopt;
+    }
+    try {
+      nlohmann::json j = nlohmann::json::parse(*non_standard_record);
+      enemy_ids_and_pos = deserializeMapEnemyIds(j);
+      item_ids_and_pos = deserializeMapItemIds(j);
+      // These ids are entity names ("Health Potion"), while the records
+      // were stored under lowercased keys.
+      for (auto &pair : enemy_ids_and_pos) {
+        pair.second = toLower(pair.second);
+      }
+      for (auto &pair : item_ids_and_pos) {
+        pair.second = toLower(pair.second);
+      }
+      if (!tile_chunk_records.empty()) {
+        tiles_opt =
+            decodeTileChunks(base_key, tile_chunk_records, width, height);
+      } else if (legacy_tiles_record) {
+        tiles_opt = deserializeMapTiles(*legacy_tiles_record, width, height);
       } else {
-        spdlog::warn("MapRepository: Item '{}' not found for map '{}'.",
-                     pair.second, base_key);
+        tiles_opt = deserializeLegacyMapTiles(j, width, height);
       }
+    } catch (const nlohmann::json::exception &e) {
+      spdlog::error("MapRepository: Failed to parse JSON for non-standard "
+                    "parts for key '{}': {}",
+                    base_key, e.what());
+      return std::nullopt;
     }
+  }
 
-    Domain::Model::Map map(dimensions_opt->width, dimensions_opt->height,
-                           start_pos_opt.value(), tiles_opt.value(),
-                           std::move(loaded_enemies), std::move(loaded_items));
+  if (!tiles_opt) {
+    spdlog::error(
+        "MapRepository: Failed to deserialize map tiles for key '{}'.",
+        base_key);
+    return std::nullopt;
+  }
 
-    spdlog::debug("MapRepository: Loaded map '{}' and its entities.", base_key);
-    return map;
+  std::vector<std::pair<Domain::Model::Position,
+                        std::unique_ptr<Domain::Model::Enemy>>>
+      loaded_enemies;
+  loaded_enemies.reserve(enemy_ids_and_pos.size());
+  for (const auto &pair : enemy_ids_and_pos) {
+    std::unique_ptr<Domain::Model::Enemy> enemy;
+    if (const std::string *record = findRecord(enemy_records, pair.second)) {
+      enemy = enemy_repo_.decode(prefix + "enemies:" + pair.second, *record);
+    }
+    if (enemy) {
+      loaded_enemies.emplace_back(pair.first, std::move(enemy));
+    } else {
+      spdlog::warn("MapRepository: Enemy '{}' not found for map '{}'.",
+                   pair.second, base_key);
+    }
+  }
 
-  } catch (const nlohmann::json::exception &e) {
-    spdlog::error("MapRepository: Failed to parse JSON for non-standard parts "
-                  "for key '{}': {}",
-                  base_key, e.what());
-    return std::nullopt;
+  std::vector<std::pair<Domain::Model::Position,
+                        std::unique_ptr<Domain::Model::Item>>>
+      loaded_items;
+  loaded_items.reserve(item_ids_and_pos.size());
+  for (const auto &pair : item_ids_and_pos) {
+    std::optional<Domain::Model::Item> item_opt;
+    if (const std::string *record = findRecord(item_records, pair.second)) {
+      item_opt = item_repo_.decode(prefix + "items:" + pair.second, *record);
+    }
+    if (item_opt) {
+      loaded_items.emplace_back(
+          pair.first,
+          std::make_unique<Domain::Model::Item>(std::move(*item_opt)));
+    } else {
+      spdlog::warn("MapRepository: Item '{}' not found for map '{}'.",
+                   pair.second, base_key);
+    }
   }
+
+  Domain::Model::Map map(width, height, start_pos_opt.value(),
+                         std::move(*tiles_opt), std::move(loaded_enemies),
+                         std::move(loaded_items));
+
+  spdlog::debug("MapRepository: Loaded map '{}' and its entities.", base_key);
+  return map;
 }
 
 void MapRepository::deleteById(const std::string &key) {
-  auto &provider = LevelDbProvider::getInstance();
   std::string base_key = toLower(key);
 
+  if (auto dimensions_opt =
+          map_dimensions_crud_.findById(base_key + ":dimensions")) {
+    const std::size_t tile_count =
+        static_cast<std::size_t>(dimensions_opt->width) *
+        dimensions_opt->height;
+    for (std::size_t chunk = 0; chunk * kTileChunkSize < tile_count; ++chunk) {
+      provider_.Delete(base_key + ":tiles:" + std::to_string(chunk));
+    }
+  }
+
   map_dimensions_crud_.deleteById(base_key + ":dimensions");
   map_start_position_crud_.deleteById(base_key + ":start_position");
 
-  auto non_standard_json_str_opt = provider.Get(base_key + ":non_standard");
-  if (non_standard_json_str_opt) {
+  if (auto layout_blob_opt = provider_.Get(base_key + ":layout")) {
+    if (auto layout_opt = MapCodec::decodeEntityLayout(*layout_blob_opt)) {
+      for (const auto &position : layout_opt->enemies) {
+        enemy_repo_.deleteById(base_key + ":enemies:" + entityId(position));
+      }
+      for (const auto &position : layout_opt->items) {
+        item_repo_.deleteById(base_key + ":items:" + entityId(position));
+      }
+    }
+  } else if (auto non_standard_json_str_opt =
+                 provider_.Get(base_key + ":non_standard")) {
     try {
       nlohmann::json j = nlohmann::json::parse(*non_standard_json_str_opt);
       std::vector<std::pair<Domain::Model::Position, std::string>>
@@ -235,7 +524,9 @@ void MapRepository::deleteById(const std::string &key) {
     }
   }
 
-  provider.Delete(base_key + ":non_standard");
+  provider_.Delete(base_key + ":tiles");
+  provider_.Delete(base_key + ":layout");
+  provider_.Delete(base_key + ":non_standard");
   spdlog::debug("MapRepository: Deleted map '{}' and its entities.", base_key);
 }
 
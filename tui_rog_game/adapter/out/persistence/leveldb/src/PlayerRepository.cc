@@ -9,8 +9,11 @@ namespace Adapter {
 namespace Out {
 namespace Persistence {
 
-PlayerRepository::PlayerRepository(ItemRepository &item_repo)
-    : item_repo_(item_repo) {}
+PlayerRepository::PlayerRepository(LevelDbProvider &provider,
+                                   ItemRepository &item_repo)
+    : provider_(provider), item_repo_(item_repo),
+      player_core_stats_crud_(provider), player_stats_crud_(provider),
+      player_position_crud_(provider) {}
 
 std::string PlayerRepository::toLower(std::string s) const {
   std::transform(s.begin(), s.end(), s.begin(),
@@ -52,21 +55,23 @@ std::vector<std::string> PlayerRepository::deserializePlayerInventoryItemIds(
   return item_ids;
 }
 
-void PlayerRepository::saveForBatch(const std::string &key,
+void PlayerRepository::saveForBatch(LevelDbBatch &batch,
+                                    const std::string &key,
                                     const Domain::Model::Player &player) {
 
   std::string base_key = toLower(key); // e.g., "player:main_player"
 
   Domain::Model::PlayerCoreStats core_stats = {player.getLevel(),
                                                player.getXp(), player.getHp()};
-  player_core_stats_crud_.saveForBatch(base_key + ":core_stats", core_stats);
-  player_stats_crud_.saveForBatch(base_key + ":stats", player.getStats());
-  player_position_crud_.saveForBatch(base_key + ":position",
+  player_core_stats_crud_.saveForBatch(batch, base_key + ":core_stats",
+                                       core_stats);
+  player_stats_crud_.saveForBatch(batch, base_key + ":stats",
+                                  player.getStats());
+  player_position_crud_.saveForBatch(batch, base_key + ":position",
                                      player.getPosition());
 
   nlohmann::json j = serializePlayerNonStandard(player);
-  LevelDbProvider::getInstance().addToBatch(base_key + ":non_standard",
-                                            j.dump());
+  batch.Put(base_key + ":non_standard", j.dump());
   spdlog::debug(
       "PlayerRepository: Added non-standard parts for key '{}' to batch.",
       base_key);
@@ -75,7 +80,8 @@ void PlayerRepository::saveForBatch(const std::string &key,
   for (const auto &item_ptr : player.getInventory()) {
 
     item_repo_.saveForBatch(
-        base_key + ":inventory:" + std::to_string(item_index), *item_ptr);
+        batch, base_key + ":inventory:" + std::to_string(item_index),
+        *item_ptr);
     item_index++;
   }
   spdlog::debug(
@@ -83,14 +89,65 @@ void PlayerRepository::saveForBatch(const std::string &key,
       base_key);
 }
 
+void PlayerRepository::saveChangesForBatch(
+    LevelDbBatch &batch, const std::string &key,
+    const Domain::Model::Player &player) {
+  const Domain::Model::PlayerChangeSet &changes = player.getChanges();
+  if (changes.full) {
+    saveForBatch(batch, key, player);
+    return;
+  }
+
+  std::string base_key = toLower(key);
+
+  if (changes.core_stats) {
+    Domain::Model::PlayerCoreStats core_stats = {
+        player.getLevel(), player.getXp(), player.getHp()};
+    player_core_stats_crud_.saveForBatch(batch, base_key + ":core_stats",
+                                         core_stats);
+  }
+  if (changes.stats) {
+    player_stats_crud_.saveForBatch(batch, base_key + ":stats",
+                                    player.getStats());
+  }
+  if (changes.position) {
+    player_position_crud_.saveForBatch(batch, base_key + ":position",
+                                       player.getPosition());
+  }
+
+  if (changes.inventory_first_dirty !=
+      Domain::Model::PlayerChangeSet::kNoInventoryChange) {
+    const auto &inventory = player.getInventory();
+    for (std::size_t i = changes.inventory_first_dirty; i < inventory.size();
+         ++i) {
+      item_repo_.saveForBatch(batch,
+                              base_key + ":inventory:" + std::to_string(i),
+                              *inventory[i]);
+    }
+    for (std::size_t i = inventory.size(); i < changes.inventory_high_water;
+         ++i) {
+      item_repo_.deleteForBatch(batch,
+                                base_key + ":inventory:" + std::to_string(i));
+    }
+
+    nlohmann::json j = serializePlayerNonStandard(player);
+    batch.Put(base_key + ":non_standard", j.dump());
+  }
+
+  spdlog::debug("PlayerRepository: Added changes for player '{}' to batch.",
+                base_key);
+}
+
 std::optional<Domain::Model::Player>
-PlayerRepository::findById(const std::string &key) {
+PlayerRepository::findById(const std::string &key,
+                           const LevelDbSnapshot *snapshot) {
   std::string base_key = toLower(key);
 
   auto core_stats_opt =
-      player_core_stats_crud_.findById(base_key + ":core_stats");
-  auto stats_opt = player_stats_crud_.findById(base_key + ":stats");
-  auto position_opt = player_position_crud_.findById(base_key + ":position");
+      player_core_stats_crud_.findById(base_key + ":core_stats", snapshot);
+  auto stats_opt = player_stats_crud_.findById(base_key + ":stats", snapshot);
+  auto position_opt =
+      player_position_crud_.findById(base_key + ":position", snapshot);
 
   if (!core_stats_opt || !stats_opt || !position_opt) {
     spdlog::debug(
@@ -99,8 +156,8 @@ PlayerRepository::findById(const std::string &key) {
     return std::nullopt;
   }
 
-  auto &provider = LevelDbProvider::getInstance();
-  auto non_standard_json_str_opt = provider.Get(base_key + ":non_standard");
+  auto non_standard_json_str_opt =
+      provider_.Get(base_key + ":non_standard", snapshot);
   if (!non_standard_json_str_opt) {
     spdlog::debug("PlayerRepository: Missing non-standard parts for key '{}'.",
                   base_key);
@@ -124,8 +181,8 @@ PlayerRepository::findById(const std::string &key) {
     int item_index = 0;
     for (const std::string &item_id : inventory_item_ids) {
       auto item_opt = item_repo_.findById(
-          base_key +
-          ":inventory:" + std::to_string(item_index)); // Use index-based key
+          base_key + ":inventory:" + std::to_string(item_index),
+          snapshot); // Use index-based key
       if (item_opt) {
         loaded_inventory_items.push_back(
             std::make_unique<Domain::Model::Item>(item_opt.value()));
@@ -154,14 +211,13 @@ PlayerRepository::findById(const std::string &key) {
 }
 
 void PlayerRepository::deleteById(const std::string &key) {
-  auto &provider = LevelDbProvider::getInstance();
   std::string base_key = toLower(key);
 
   player_core_stats_crud_.deleteById(base_key + ":core_stats");
   player_stats_crud_.deleteById(base_key + ":stats");
   player_position_crud_.deleteById(base_key + ":position");
 
-  provider.Delete(base_key + ":non_standard");
+  provider_.Delete(base_key + ":non_standard");
 
   spdlog::warn("PlayerRepository: Inventory items for player '{}' are not "
                "deleted during player deletion. Manual cleanup needed.",
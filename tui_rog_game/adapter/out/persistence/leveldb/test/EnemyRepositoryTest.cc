@@ -0,0 +1,154 @@
+#include "EnemyRepository.h"
+#include "EntityCodec.h"
+#include "Goblin.h"
+#include "LevelDbProvider.h"
+#include "Orc.h"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+
+namespace {
+
+class Slime : public Enemy {
+public:
+  explicit Slime(Position position, std::string name = "Slime")
+      : Enemy(std::move(name), "Slime", Stats{1, 1, 1, 1}, position) {}
+  std::string getTypeName() const override { return "Slime"; }
+  std::unique_ptr<Enemy> clone() const override {
+    return std::make_unique<Slime>(*this);
+  }
+};
+
+// A registry knowing only Slime, under tag 7.
+const EnemyTypeRegistry &slimeTypes() {
+  static const EnemyTypeRegistry types = [] {
+    EnemyTypeRegistry registry;
+    registry.add(7, "Slime", [](Position position) {
+      return std::make_unique<Slime>(position);
+    });
+    return registry;
+  }();
+  return types;
+}
+
+class EnemyRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    db_path_ =
+        std::filesystem::temp_directory_path() / "enemy_repository_test";
+    std::filesystem::remove_all(db_path_);
+    provider_ = std::make_unique<LevelDbProvider>(db_path_.string());
+    ASSERT_TRUE(provider_->isOpen());
+  }
+
+  void TearDown() override {
+    provider_.reset();
+    std::filesystem::remove_all(db_path_);
+  }
+
+  void save(EnemyRepository &repo, const std::string &key,
+            const Enemy &enemy) {
+    LevelDbBatch batch;
+    repo.saveForBatch(batch, key, enemy);
+    ASSERT_TRUE(provider_->commitBatch(batch));
+  }
+
+  std::filesystem::path db_path_;
+  std::unique_ptr<LevelDbProvider> provider_;
+};
+
+} // namespace
+
+TEST_F(EnemyRepositoryTest, SavedEnemyLoadsBack) {
+  EnemyRepository repo(*provider_);
+  Orc orc(Position{4, 2});
+  orc.takeDamage(5);
+  save(repo, "Map:Enemies:4_2", orc);
+
+  // Keys are case-insensitive.
+  auto loaded = repo.findById("map:enemies:4_2");
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->getTypeName(), "Orc");
+  EXPECT_EQ(loaded->getName(), orc.getName());
+  EXPECT_EQ(loaded->getHealth(), orc.getHealth());
+  EXPECT_EQ(loaded->getStats().max_health, orc.getStats().max_health);
+  EXPECT_EQ(loaded->getStats().strength, orc.getStats().strength);
+  EXPECT_EQ(loaded->getPosition(), orc.getPosition());
+}
+
+TEST_F(EnemyRepositoryTest, LoadsLegacyJsonRecords) {
+  EnemyRepository repo(*provider_);
+  provider_->Put("map:enemies:goblin",
+                 nlohmann::json{{"type_name", "Goblin"},
+                                {"name", "Goblin"},
+                                {"health", 9},
+                                {"stats",
+                                 {{"strength", 8},
+                                  {"dexterity", 15},
+                                  {"intelligence", 10},
+                                  {"vitality", 5}}},
+                                {"position", {{"x", 1}, {"y", 2}}}}
+                     .dump());
+
+  auto loaded = repo.findById("map:enemies:Goblin");
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->getTypeName(), "Goblin");
+  EXPECT_EQ(loaded->getHealth(), 9);
+  EXPECT_EQ(loaded->getPosition(), (Position{1, 2}));
+}
+
+TEST_F(EnemyRepositoryTest, RejectsUnknownTypes) {
+  EnemyRepository repo(*provider_);
+  provider_->Put("map:enemies:tagged",
+                 EntityCodec::encodeEnemy(99, Goblin(Position{0, 0})));
+  provider_->Put("map:enemies:json",
+                 nlohmann::json{{"type_name", "Dragon"},
+                                {"name", "Dragon"},
+                                {"health", 1},
+                                {"stats",
+                                 {{"strength", 1},
+                                  {"dexterity", 1},
+                                  {"intelligence", 1},
+                                  {"vitality", 1}}},
+                                {"position", {{"x", 0}, {"y", 0}}}}
+                     .dump());
+
+  EXPECT_EQ(repo.findById("map:enemies:tagged"), nullptr);
+  EXPECT_EQ(repo.findById("map:enemies:json"), nullptr);
+}
+
+TEST_F(EnemyRepositoryTest, DoesNotSaveUnregisteredTypes) {
+  EnemyRepository repo(*provider_);
+  save(repo, "map:enemies:slime", Slime(Position{0, 0}));
+
+  EXPECT_FALSE(provider_->Get("map:enemies:slime").has_value());
+}
+
+TEST_F(EnemyRepositoryTest, UsesTheRegistryItIsGiven) {
+  EnemyRepository repo(*provider_, slimeTypes());
+  save(repo, "map:enemies:slime", Slime(Position{5, 6}));
+
+  auto loaded = repo.findById("map:enemies:slime");
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->getTypeName(), "Slime");
+  EXPECT_EQ(loaded->getPosition(), (Position{5, 6}));
+  // Tag 7 means nothing to a repository with the built-in types.
+  EXPECT_EQ(EnemyRepository(*provider_).findById("map:enemies:slime"),
+            nullptr);
+}
+
+TEST_F(EnemyRepositoryTest, NamesBeyondTheLengthFieldAreTruncated) {
+  EnemyRepository repo(*provider_, slimeTypes());
+  const std::string name(70000, 's');
+  save(repo, "map:enemies:long", Slime(Position{0, 0}, name));
+
+  auto loaded = repo.findById("map:enemies:long");
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->getName(), name.substr(0, 65535));
+}
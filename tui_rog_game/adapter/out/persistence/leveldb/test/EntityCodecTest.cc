@@ -0,0 +1,161 @@
+#include "EntityCodec.h"
+#include "Enemy.h"
+#include "Goblin.h"
+#include "Item.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+
+namespace {
+
+constexpr std::size_t kMaxNameLength =
+    std::numeric_limits<std::uint16_t>::max();
+
+class NamedEnemy : public Enemy {
+public:
+  NamedEnemy(std::string name, Position position)
+      : Enemy(std::move(name), "Named", Stats{1, 2, 3, 4}, position) {}
+  std::unique_ptr<Enemy> clone() const override {
+    return std::make_unique<NamedEnemy>(*this);
+  }
+};
+
+} // namespace
+
+TEST(EntityCodecTest, EnemyRoundTrips) {
+  Goblin goblin(Position{3, -4});
+  goblin.takeDamage(2);
+  const std::string blob = EntityCodec::encodeEnemy(7, goblin);
+
+  ASSERT_EQ(blob.size(), 40u + goblin.getName().size());
+  ASSERT_TRUE(EntityCodec::isEncodedRecord(blob));
+  auto record = EntityCodec::decodeEnemy(blob);
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(record->type_tag, 7);
+  EXPECT_EQ(record->name, goblin.getName());
+  EXPECT_EQ(record->stats.strength, goblin.getStats().strength);
+  EXPECT_EQ(record->stats.dexterity, goblin.getStats().dexterity);
+  EXPECT_EQ(record->stats.intelligence, goblin.getStats().intelligence);
+  EXPECT_EQ(record->stats.vitality, goblin.getStats().vitality);
+  EXPECT_EQ(record->stats.health, goblin.getHealth());
+  EXPECT_EQ(record->stats.max_health, goblin.getStats().max_health);
+  EXPECT_EQ(record->position, goblin.getPosition());
+}
+
+TEST(EntityCodecTest, ItemRoundTrips) {
+  const Item item(Item::ItemType::StrengthScroll, "Scroll of Might");
+  const std::string blob = EntityCodec::encodeItem(2, item);
+
+  ASSERT_EQ(blob.size(), 8u + item.getName().size());
+  auto record = EntityCodec::decodeItem(blob);
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(record->type_tag, 2);
+  EXPECT_EQ(record->name, "Scroll of Might");
+}
+
+TEST(EntityCodecTest, EmptyNamesRoundTrip) {
+  const NamedEnemy enemy("", Position{0, 0});
+  auto enemy_record =
+      EntityCodec::decodeEnemy(EntityCodec::encodeEnemy(1, enemy));
+  ASSERT_TRUE(enemy_record.has_value());
+  EXPECT_TRUE(enemy_record->name.empty());
+
+  auto item_record = EntityCodec::decodeItem(
+      EntityCodec::encodeItem(1, Item(Item::ItemType::HealthPotion, "")));
+  ASSERT_TRUE(item_record.has_value());
+  EXPECT_TRUE(item_record->name.empty());
+}
+
+TEST(EntityCodecTest, NamesAtTheLengthLimitAreKept) {
+  const std::string name(kMaxNameLength, 'a');
+  auto enemy_record = EntityCodec::decodeEnemy(
+      EntityCodec::encodeEnemy(1, NamedEnemy(name, Position{0, 0})));
+  ASSERT_TRUE(enemy_record.has_value());
+  EXPECT_EQ(enemy_record->name, name);
+
+  auto item_record = EntityCodec::decodeItem(
+      EntityCodec::encodeItem(1, Item(Item::ItemType::HealthPotion, name)));
+  ASSERT_TRUE(item_record.has_value());
+  EXPECT_EQ(item_record->name, name);
+}
+
+TEST(EntityCodecTest, LongerNamesAreTruncated) {
+  const std::string name = std::string(kMaxNameLength, 'a') + "bcd";
+
+  const std::string enemy_blob =
+      EntityCodec::encodeEnemy(1, NamedEnemy(name, Position{0, 0}));
+  ASSERT_EQ(enemy_blob.size(), 40u + kMaxNameLength);
+  auto enemy_record = EntityCodec::decodeEnemy(enemy_blob);
+  ASSERT_TRUE(enemy_record.has_value());
+  EXPECT_EQ(enemy_record->name, name.substr(0, kMaxNameLength));
+
+  const std::string item_blob =
+      EntityCodec::encodeItem(1, Item(Item::ItemType::HealthPotion, name));
+  ASSERT_EQ(item_blob.size(), 8u + kMaxNameLength);
+  auto item_record = EntityCodec::decodeItem(item_blob);
+  ASSERT_TRUE(item_record.has_value());
+  EXPECT_EQ(item_record->name, name.substr(0, kMaxNameLength));
+}
+
+TEST(EntityCodecTest, RejectsMalformedRecords) {
+  const std::string enemy_blob =
+      EntityCodec::encodeEnemy(1, Goblin(Position{1, 1}));
+  const std::string item_blob = EntityCodec::encodeItem(
+      1, Item(Item::ItemType::HealthPotion, "Health Potion"));
+
+  EXPECT_FALSE(EntityCodec::decodeEnemy(""));
+  EXPECT_FALSE(EntityCodec::decodeItem(""));
+  // Shorter than the fixed header.
+  EXPECT_FALSE(EntityCodec::decodeEnemy(enemy_blob.substr(0, 39)));
+  EXPECT_FALSE(EntityCodec::decodeItem(item_blob.substr(0, 7)));
+  // The name is shorter, or longer, than its length says.
+  EXPECT_FALSE(
+      EntityCodec::decodeEnemy(enemy_blob.substr(0, enemy_blob.size() - 1)));
+  EXPECT_FALSE(EntityCodec::decodeItem(item_blob + "x"));
+
+  std::string bad_magic = item_blob;
+  bad_magic[0] = '{';
+  EXPECT_FALSE(EntityCodec::isEncodedRecord(bad_magic));
+  EXPECT_FALSE(EntityCodec::decodeItem(bad_magic));
+}
+
+TEST(EntityCodecTest, RejectsRecordsOfAnotherVersion) {
+  std::string enemy_blob = EntityCodec::encodeEnemy(1, Goblin(Position{1, 1}));
+  std::string item_blob = EntityCodec::encodeItem(
+      1, Item(Item::ItemType::HealthPotion, "Health Potion"));
+  enemy_blob[1] = static_cast<char>(EntityCodec::kEntityRecordVersion + 1);
+  item_blob[1] = static_cast<char>(EntityCodec::kEntityRecordVersion + 1);
+
+  // Still a record of this codec, just not one it can read.
+  EXPECT_TRUE(EntityCodec::isEncodedRecord(item_blob));
+  EXPECT_FALSE(EntityCodec::decodeEnemy(enemy_blob));
+  EXPECT_FALSE(EntityCodec::decodeItem(item_blob));
+}
+
+TEST(EntityCodecTest, TellsRecordsFromLegacyJson) {
+  EXPECT_TRUE(EntityCodec::isEncodedRecord(EntityCodec::encodeItem(
+      1, Item(Item::ItemType::HealthPotion, "Health Potion"))));
+  EXPECT_FALSE(
+      EntityCodec::isEncodedRecord(R"({"type":0,"name":"Health Potion"})"));
+  EXPECT_FALSE(EntityCodec::isEncodedRecord(""));
+}
+
+TEST(EntityCodecTest, RegistryRefusesTakenTagsAndKeys) {
+  EntityCodec::TypeTagRegistry<std::string, int> registry;
+  ASSERT_TRUE(registry.add(1, "Goblin", 10));
+
+  EXPECT_FALSE(registry.add(1, "Orc", 20));
+  EXPECT_FALSE(registry.add(2, "Goblin", 20));
+  ASSERT_TRUE(registry.add(2, "Orc", 20));
+
+  ASSERT_NE(registry.findByTag(2), nullptr);
+  EXPECT_EQ(registry.findByTag(2)->key, "Orc");
+  ASSERT_NE(registry.findByKey(std::string("Goblin")), nullptr);
+  EXPECT_EQ(registry.findByKey(std::string("Goblin"))->factory, 10);
+  EXPECT_EQ(registry.findByTag(3), nullptr);
+}
@@ -0,0 +1,130 @@
+#include "GameStateManifest.h"
+#include "GameStateDTO.h"
+#include "Goblin.h"
+#include "Item.h"
+#include "Map.h"
+#include "Orc.h"
+#include "Player.h"
+#include "Position.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+using TuiRogGame::Port::Out::GameStateDTO;
+
+namespace {
+
+// 64 x 40 tiles, so the tile plane spans three chunks.
+GameStateDTO makeGameState() {
+  std::vector<std::pair<Position, std::unique_ptr<Enemy>>> enemies;
+  enemies.emplace_back(Position{3, 3},
+                       std::make_unique<Goblin>(Position{3, 3}));
+  enemies.emplace_back(Position{40, 30},
+                       std::make_unique<Orc>(Position{40, 30}));
+  std::vector<std::pair<Position, std::unique_ptr<Item>>> items;
+  items.emplace_back(Position{5, 1},
+                     std::make_unique<Item>(Item::ItemType::HealthPotion,
+                                            "Health Potion"));
+  Map map(64, 40, Position{1, 1}, std::vector<Tile>(64 * 40, Tile::FLOOR),
+          std::move(enemies), std::move(items));
+  return GameStateDTO(std::move(map),
+                      Player("player", Stats{10, 10, 10, 10}, Position{1, 1}));
+}
+
+class GameStateDigestTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    digest_.reset(state_);
+    state_.map.clearChanges();
+  }
+
+  // Folds the pending changes in, as a save would, and checks the result
+  // against a description from scratch.
+  void expectUpdateMatchesReset() {
+    digest_.update(state_);
+    state_.map.clearChanges();
+    EXPECT_EQ(digest_.manifest(), describeGameState(state_));
+  }
+
+  GameStateDTO state_ = makeGameState();
+  GameStateDigest digest_;
+};
+
+} // namespace
+
+TEST_F(GameStateDigestTest, TracksTileChangesInEveryChunk) {
+  const GameStateManifest before = digest_.manifest();
+  state_.map.setTile(0, 0, Tile::WALL);
+  state_.map.setTile(63, 39, Tile::EXIT);
+  expectUpdateMatchesReset();
+  EXPECT_NE(digest_.manifest().tiles_checksum, before.tiles_checksum);
+
+  // Changing a tile back restores the checksum.
+  state_.map.setTile(0, 0, Tile::FLOOR);
+  state_.map.setTile(63, 39, Tile::FLOOR);
+  expectUpdateMatchesReset();
+  EXPECT_EQ(digest_.manifest(), before);
+}
+
+TEST_F(GameStateDigestTest, TracksTheStartPosition) {
+  state_.map.setStartPlayerPosition(Position{2, 2});
+  expectUpdateMatchesReset();
+}
+
+TEST_F(GameStateDigestTest, TracksEnemies) {
+  state_.map.getEnemyAt(Position{3, 3})->get().takeDamage(1);
+  state_.map.markEnemyChanged(Position{3, 3});
+  expectUpdateMatchesReset();
+
+  state_.map.removeEnemyAt(Position{40, 30});
+  state_.map.addEnemy(Position{8, 8}, std::make_unique<Orc>(Position{8, 8}));
+  expectUpdateMatchesReset();
+  EXPECT_EQ(digest_.manifest().enemy_count, 2u);
+}
+
+TEST_F(GameStateDigestTest, TracksItems) {
+  state_.map.takeItemAt(Position{5, 1});
+  expectUpdateMatchesReset();
+  EXPECT_EQ(digest_.manifest().item_count, 0u);
+
+  state_.map.addItem(Position{6, 1},
+                     std::make_unique<Item>(Item::ItemType::StrengthScroll,
+                                            "Scroll of Might"));
+  expectUpdateMatchesReset();
+  EXPECT_EQ(digest_.manifest().item_count, 1u);
+}
+
+TEST_F(GameStateDigestTest, TracksThePlayerWithoutChangeSets) {
+  const GameStateManifest before = digest_.manifest();
+  state_.player.takeDamage(3);
+  expectUpdateMatchesReset();
+  EXPECT_NE(digest_.manifest().player_checksum, before.player_checksum);
+}
+
+TEST_F(GameStateDigestTest, UpdatesAfterAFullChangeFromScratch) {
+  state_.map.setTiles(std::vector<Tile>(64 * 40, Tile::WALL));
+  state_.map.markFullyChanged();
+  expectUpdateMatchesReset();
+}
+
+TEST(GameStateManifestTest, RoundTripsThroughItsRecord) {
+  const GameStateManifest manifest = describeGameState(makeGameState());
+
+  auto decoded = decodeManifest(encodeManifest(manifest));
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(*decoded, manifest);
+}
+
+TEST(GameStateManifestTest, RejectsCorruptRecords) {
+  const std::string blob = encodeManifest(describeGameState(makeGameState()));
+
+  EXPECT_FALSE(decodeManifest(""));
+  EXPECT_FALSE(decodeManifest(blob.substr(0, blob.size() - 1)));
+  std::string flipped = blob;
+  flipped[12] ^= 0x01;
+  EXPECT_FALSE(decodeManifest(flipped));
+}
@@ -0,0 +1,119 @@
+#include "ItemRepository.h"
+#include "EntityCodec.h"
+#include "Item.h"
+#include "LevelDbProvider.h"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+
+namespace {
+
+// A registry knowing only StrengthScroll, under tag 9.
+const ItemTypeRegistry &scrollTypes() {
+  static const ItemTypeRegistry types = [] {
+    ItemTypeRegistry registry;
+    registry.add(9, Item::ItemType::StrengthScroll, [](std::string name) {
+      return Item(Item::ItemType::StrengthScroll, std::move(name));
+    });
+    return registry;
+  }();
+  return types;
+}
+
+class ItemRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    db_path_ = std::filesystem::temp_directory_path() / "item_repository_test";
+    std::filesystem::remove_all(db_path_);
+    provider_ = std::make_unique<LevelDbProvider>(db_path_.string());
+    ASSERT_TRUE(provider_->isOpen());
+  }
+
+  void TearDown() override {
+    provider_.reset();
+    std::filesystem::remove_all(db_path_);
+  }
+
+  void save(ItemRepository &repo, const std::string &key, const Item &item) {
+    LevelDbBatch batch;
+    repo.saveForBatch(batch, key, item);
+    ASSERT_TRUE(provider_->commitBatch(batch));
+  }
+
+  std::filesystem::path db_path_;
+  std::unique_ptr<LevelDbProvider> provider_;
+};
+
+} // namespace
+
+TEST_F(ItemRepositoryTest, SavedItemLoadsBack) {
+  ItemRepository repo(*provider_);
+  save(repo, "Map:Items:2_3",
+       Item(Item::ItemType::StrengthScroll, "Scroll of Might"));
+
+  // Keys are case-insensitive.
+  auto loaded = repo.findById("map:items:2_3");
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->getType(), Item::ItemType::StrengthScroll);
+  EXPECT_EQ(loaded->getName(), "Scroll of Might");
+}
+
+TEST_F(ItemRepositoryTest, LoadsLegacyJsonRecords) {
+  ItemRepository repo(*provider_);
+  provider_->Put("map:items:health potion",
+                 nlohmann::json{{"type", 0}, {"name", "Health Potion"}}.dump());
+
+  auto loaded = repo.findById("map:items:Health Potion");
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->getType(), Item::ItemType::HealthPotion);
+  EXPECT_EQ(loaded->getName(), "Health Potion");
+}
+
+TEST_F(ItemRepositoryTest, RejectsUnknownTypeTagsAndMalformedRecords) {
+  ItemRepository repo(*provider_);
+  provider_->Put("map:items:tagged",
+                 EntityCodec::encodeItem(
+                     99, Item(Item::ItemType::HealthPotion, "Health Potion")));
+  const std::string valid = EntityCodec::encodeItem(
+      1, Item(Item::ItemType::HealthPotion, "Health Potion"));
+  provider_->Put("map:items:truncated", valid.substr(0, valid.size() - 1));
+  provider_->Put("map:items:json", R"({"name":"Health Potion"})");
+
+  EXPECT_FALSE(repo.findById("map:items:tagged").has_value());
+  EXPECT_FALSE(repo.findById("map:items:truncated").has_value());
+  EXPECT_FALSE(repo.findById("map:items:json").has_value());
+  EXPECT_FALSE(repo.findById("map:items:missing").has_value());
+}
+
+TEST_F(ItemRepositoryTest, UsesTheRegistryItIsGiven) {
+  ItemRepository repo(*provider_, scrollTypes());
+  save(repo, "map:items:scroll",
+       Item(Item::ItemType::StrengthScroll, "Scroll of Might"));
+  // Not registered, so not saved.
+  save(repo, "map:items:potion",
+       Item(Item::ItemType::HealthPotion, "Health Potion"));
+
+  auto loaded = repo.findById("map:items:scroll");
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->getType(), Item::ItemType::StrengthScroll);
+  EXPECT_FALSE(provider_->Get("map:items:potion").has_value());
+  // Tag 9 means nothing to a repository with the built-in types.
+  EXPECT_FALSE(
+      ItemRepository(*provider_).findById("map:items:scroll").has_value());
+}
+
+TEST_F(ItemRepositoryTest, NamesBeyondTheLengthFieldAreTruncated) {
+  ItemRepository repo(*provider_);
+  const std::string name(70000, 'p');
+  save(repo, "map:items:long", Item(Item::ItemType::HealthPotion, name));
+
+  auto loaded = repo.findById("map:items:long");
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->getName(), name.substr(0, 65535));
+}
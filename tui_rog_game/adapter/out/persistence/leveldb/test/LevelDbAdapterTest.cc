@@ -0,0 +1,199 @@
+#include "LevelDbAdapter.h"
+#include "EnemyRepository.h"
+#include "GameStateDTO.h"
+#include "GameStateManifest.h"
+#include "Goblin.h"
+#include "Item.h"
+#include "LevelDbProvider.h"
+#include "Map.h"
+#include "Orc.h"
+#include "Player.h"
+#include "Position.h"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+using TuiRogGame::Port::Out::GameStateDTO;
+
+namespace {
+
+GameStateDTO makeGameState() {
+  std::vector<Tile> tiles(40 * 30, Tile::FLOOR);
+  tiles[0] = Tile::WALL;
+  tiles[40 * 30 - 1] = Tile::EXIT;
+  std::vector<std::pair<Position, std::unique_ptr<Enemy>>> enemies;
+  enemies.emplace_back(Position{3, 3},
+                       std::make_unique<Goblin>(Position{3, 3}));
+  enemies.emplace_back(Position{20, 10},
+                       std::make_unique<Orc>(Position{20, 10}));
+  std::vector<std::pair<Position, std::unique_ptr<Item>>> items;
+  items.emplace_back(Position{5, 1},
+                     std::make_unique<Item>(Item::ItemType::HealthPotion,
+                                            "Health Potion"));
+  Map map(40, 30, Position{1, 1}, std::move(tiles), std::move(enemies),
+          std::move(items));
+  return GameStateDTO(std::move(map),
+                      Player("player", Stats{10, 10, 10, 10}, Position{1, 1}));
+}
+
+class LevelDbAdapterTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    db_path_ = std::filesystem::temp_directory_path() / "leveldb_adapter_test";
+    std::filesystem::remove_all(db_path_);
+    provider_ = std::make_shared<LevelDbProvider>(db_path_.string());
+    ASSERT_TRUE(provider_->isOpen());
+  }
+
+  void TearDown() override {
+    provider_.reset();
+    std::filesystem::remove_all(db_path_);
+  }
+
+  // A fresh adapter has nothing cached, so it reads every record back.
+  std::unique_ptr<GameStateDTO> loadFresh() {
+    return LevelDbAdapter(provider_).loadGameState();
+  }
+
+  std::filesystem::path db_path_;
+  std::shared_ptr<LevelDbProvider> provider_;
+};
+
+void expectSameGame(const GameStateDTO &loaded, const GameStateDTO &saved) {
+  EXPECT_EQ(describeGameState(loaded), describeGameState(saved));
+  ASSERT_EQ(loaded.map.getWidth(), saved.map.getWidth());
+  ASSERT_EQ(loaded.map.getHeight(), saved.map.getHeight());
+  for (int y = 0; y < saved.map.getHeight(); ++y) {
+    for (int x = 0; x < saved.map.getWidth(); ++x) {
+      ASSERT_EQ(loaded.map.getTile(x, y), saved.map.getTile(x, y));
+    }
+  }
+  EXPECT_EQ(loaded.map.getStartPlayerPosition(),
+            saved.map.getStartPlayerPosition());
+  EXPECT_EQ(loaded.player.getPosition(), saved.player.getPosition());
+  EXPECT_EQ(loaded.player.getHp(), saved.player.getHp());
+  EXPECT_EQ(loaded.player.getInventory().size(),
+            saved.player.getInventory().size());
+}
+
+} // namespace
+
+TEST_F(LevelDbAdapterTest, SavedGameLoadsBack) {
+  const GameStateDTO saved = makeGameState();
+  LevelDbAdapter(provider_).saveGameState(saved);
+
+  auto loaded = loadFresh();
+  ASSERT_NE(loaded, nullptr);
+  expectSameGame(*loaded, saved);
+  auto goblin = loaded->map.getEnemyAt(Position{3, 3});
+  ASSERT_TRUE(goblin.has_value());
+  EXPECT_EQ(goblin->get().getTypeName(), "Goblin");
+  auto potion = loaded->map.getItemAt(Position{5, 1});
+  ASSERT_TRUE(potion.has_value());
+  EXPECT_EQ(potion->get().getName(), "Health Potion");
+}
+
+TEST_F(LevelDbAdapterTest, IncrementalSaveLoadsBack) {
+  LevelDbAdapter adapter(provider_);
+  GameStateDTO state = makeGameState();
+  adapter.saveGameState(state);
+  state.map.clearChanges();
+  state.player.clearChanges();
+
+  // Only these changes are written by the second save.
+  state.map.setTile(39, 29, Tile::FLOOR);
+  state.map.setTile(7, 7, Tile::WALL);
+  state.map.getEnemyAt(Position{3, 3})->get().takeDamage(2);
+  state.map.markEnemyChanged(Position{3, 3});
+  state.map.removeEnemyAt(Position{20, 10});
+  state.map.addItem(state.player.getPosition(),
+                    std::make_unique<Item>(Item::ItemType::StrengthScroll,
+                                           "Scroll of Might"));
+  state.player.addItem(state.map.takeItemAt(Position{5, 1}));
+  state.player.moveTo(Position{2, 1});
+  state.player.takeDamage(3);
+  adapter.saveGameState(state);
+
+  auto loaded = loadFresh();
+  ASSERT_NE(loaded, nullptr);
+  expectSameGame(*loaded, state);
+  EXPECT_FALSE(loaded->map.getEnemyAt(Position{20, 10}).has_value());
+  EXPECT_FALSE(loaded->map.getItemAt(Position{5, 1}).has_value());
+  auto goblin = loaded->map.getEnemyAt(Position{3, 3});
+  ASSERT_TRUE(goblin.has_value());
+  EXPECT_EQ(goblin->get().getHealth(),
+            state.map.getEnemyAt(Position{3, 3})->get().getHealth());
+}
+
+TEST_F(LevelDbAdapterTest, RejectsAGameThatDoesNotMatchItsManifest) {
+  LevelDbAdapter(provider_).saveGameState(makeGameState());
+
+  // A record rewritten behind the adapter's back.
+  Goblin wounded(Position{3, 3});
+  wounded.takeDamage(1);
+  LevelDbBatch batch;
+  EnemyRepository(*provider_).saveForBatch(batch, "main_map:enemies:3_3",
+                                           wounded);
+  ASSERT_TRUE(provider_->commitBatch(batch));
+
+  EXPECT_EQ(loadFresh(), nullptr);
+}
+
+TEST_F(LevelDbAdapterTest, RejectsAManifestOfAnotherGame) {
+  LevelDbAdapter(provider_).saveGameState(makeGameState());
+
+  GameStateDTO other = makeGameState();
+  other.player.takeDamage(1);
+  ASSERT_TRUE(provider_->Put("main_manifest",
+                             encodeManifest(describeGameState(other))));
+
+  EXPECT_EQ(loadFresh(), nullptr);
+}
+
+TEST_F(LevelDbAdapterTest, RejectsACorruptManifest) {
+  LevelDbAdapter(provider_).saveGameState(makeGameState());
+  std::string manifest = *provider_->Get("main_manifest");
+  manifest[20] ^= 0x01;
+  ASSERT_TRUE(provider_->Put("main_manifest", manifest));
+  EXPECT_EQ(loadFresh(), nullptr);
+
+  ASSERT_TRUE(provider_->Put("main_manifest", "not a manifest"));
+  EXPECT_EQ(loadFresh(), nullptr);
+}
+
+TEST_F(LevelDbAdapterTest, LoadsGamesSavedBeforeManifests) {
+  const GameStateDTO saved = makeGameState();
+  LevelDbAdapter(provider_).saveGameState(saved);
+  ASSERT_TRUE(provider_->Delete("main_manifest"));
+
+  auto loaded = loadFresh();
+  ASSERT_NE(loaded, nullptr);
+  expectSameGame(*loaded, saved);
+}
+
+TEST_F(LevelDbAdapterTest, SessionsDoNotSeeEachOther) {
+  LevelDbAdapter(provider_, "alice").saveGameState(makeGameState());
+
+  EXPECT_NE(LevelDbAdapter(provider_, "alice").loadGameState(), nullptr);
+  EXPECT_EQ(LevelDbAdapter(provider_, "bob").loadGameState(), nullptr);
+}
+
+TEST_F(LevelDbAdapterTest, LoadingAfterASaveReturnsTheSavedGame) {
+  LevelDbAdapter adapter(provider_);
+  adapter.saveGameState(makeGameState());
+  auto resumed = adapter.loadGameState();
+  ASSERT_NE(resumed, nullptr);
+  EXPECT_NE(adapter.loadGameState(), nullptr);
+
+  resumed->player.takeDamage(4);
+  adapter.saveGameState(*resumed);
+
+  auto loaded = adapter.loadGameState();
+  ASSERT_NE(loaded, nullptr);
+  EXPECT_EQ(loaded->player.getHp(), resumed->player.getHp());
+}
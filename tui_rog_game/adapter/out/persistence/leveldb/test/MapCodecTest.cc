@@ -0,0 +1,165 @@
+#include "MapCodec.h"
+#include "Goblin.h"
+#include "Item.h"
+#include "Map.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+
+namespace {
+
+std::vector<Tile> decode(const std::string &blob, std::size_t count) {
+  std::vector<Tile> tiles(count, Tile::WALL);
+  EXPECT_TRUE(MapCodec::decodeTileChunk(blob, tiles.data(), count));
+  return tiles;
+}
+
+std::uint8_t codecOf(const std::string &blob) {
+  return static_cast<std::uint8_t>(blob.at(1));
+}
+
+} // namespace
+
+TEST(MapCodecTest, UniformChunkRoundTripsAsRle) {
+  const std::vector<Tile> tiles(256, Tile::FLOOR);
+  const std::string blob = MapCodec::encodeTileChunk(tiles.data(), 256);
+
+  ASSERT_EQ(static_cast<std::uint8_t>(blob[0]), MapCodec::kTileChunkMagic);
+  ASSERT_EQ(codecOf(blob),
+            static_cast<std::uint8_t>(MapCodec::TileCodec::RLE));
+  ASSERT_EQ(blob.size(), 2u + 3u);
+  ASSERT_EQ(decode(blob, 256), tiles);
+}
+
+TEST(MapCodecTest, VariedChunkRoundTripsAsRaw) {
+  std::vector<Tile> tiles;
+  for (int i = 0; i < 64; ++i) {
+    tiles.push_back(i % 2 == 0 ? Tile::WALL : Tile::FLOOR);
+  }
+  const std::string blob = MapCodec::encodeTileChunk(tiles.data(), 64);
+
+  ASSERT_EQ(codecOf(blob),
+            static_cast<std::uint8_t>(MapCodec::TileCodec::RAW));
+  ASSERT_EQ(blob.size(), 2u + 64u);
+  ASSERT_EQ(decode(blob, 64), tiles);
+}
+
+TEST(MapCodecTest, SplitsRunsAtTheLengthLimit) {
+  // One tile more than a run can hold, then a different one.
+  std::vector<Tile> tiles(0xFFFF + 1, Tile::FLOOR);
+  tiles.push_back(Tile::EXIT);
+  const std::string blob =
+      MapCodec::encodeTileChunk(tiles.data(), tiles.size());
+
+  ASSERT_EQ(codecOf(blob),
+            static_cast<std::uint8_t>(MapCodec::TileCodec::RLE));
+  ASSERT_EQ(blob.size(), 2u + 3u * 3u);
+  std::uint16_t first_run;
+  std::memcpy(&first_run, blob.data() + 3, sizeof(first_run));
+  ASSERT_EQ(first_run, 0xFFFF);
+  ASSERT_EQ(decode(blob, tiles.size()), tiles);
+}
+
+TEST(MapCodecTest, ReadsLegacyHeaderlessChunks) {
+  const std::vector<Tile> tiles = {Tile::WALL, Tile::FLOOR, Tile::ENEMY,
+                                   Tile::ITEM};
+  const std::string legacy(reinterpret_cast<const char *>(tiles.data()),
+                           tiles.size());
+
+  ASSERT_EQ(decode(legacy, tiles.size()), tiles);
+
+  std::vector<Tile> out(8);
+  ASSERT_FALSE(MapCodec::decodeTileChunk(legacy, out.data(), out.size()));
+}
+
+TEST(MapCodecTest, RejectsMalformedTileChunks) {
+  const std::vector<Tile> tiles(100, Tile::FLOOR);
+  std::vector<Tile> out(100);
+  const std::string rle = MapCodec::encodeTileChunk(tiles.data(), 100);
+
+  // Truncated mid-run.
+  ASSERT_FALSE(MapCodec::decodeTileChunk(rle.substr(0, rle.size() - 1),
+                                         out.data(), out.size()));
+  // Runs covering fewer tiles than asked for.
+  ASSERT_FALSE(MapCodec::decodeTileChunk(rle, out.data(), 101));
+  // Runs overflowing the chunk.
+  ASSERT_FALSE(MapCodec::decodeTileChunk(rle, out.data(), 99));
+
+  std::string zero_run = rle;
+  zero_run[3] = zero_run[4] = 0;
+  ASSERT_FALSE(MapCodec::decodeTileChunk(zero_run, out.data(), out.size()));
+
+  std::string header_only(1, static_cast<char>(MapCodec::kTileChunkMagic));
+  ASSERT_FALSE(
+      MapCodec::decodeTileChunk(header_only, out.data(), out.size()));
+
+  std::string unknown_codec = rle;
+  unknown_codec[1] = 7;
+  ASSERT_FALSE(
+      MapCodec::decodeTileChunk(unknown_codec, out.data(), out.size()));
+
+  std::vector<Tile> varied(100, Tile::WALL);
+  for (std::size_t i = 0; i < varied.size(); i += 2) {
+    varied[i] = Tile::FLOOR;
+  }
+  const std::string raw = MapCodec::encodeTileChunk(varied.data(), 100);
+  ASSERT_FALSE(MapCodec::decodeTileChunk(raw.substr(0, raw.size() - 1),
+                                         out.data(), out.size()));
+}
+
+TEST(MapCodecTest, EntityLayoutRoundTrips) {
+  std::vector<std::pair<Position, std::unique_ptr<Enemy>>> enemies;
+  for (const Position &position : {Position{1, 2}, Position{7, 3}}) {
+    enemies.emplace_back(position, std::make_unique<Goblin>(position));
+  }
+  std::vector<std::pair<Position, std::unique_ptr<Item>>> items;
+  items.emplace_back(Position{4, 5},
+                     std::make_unique<Item>(Item::ItemType::HealthPotion,
+                                            "Health Potion"));
+  Map map(10, 8, {0, 0}, std::vector<Tile>(80, Tile::FLOOR),
+          std::move(enemies), std::move(items));
+
+  const auto layout =
+      MapCodec::decodeEntityLayout(MapCodec::encodeEntityLayout(map));
+
+  ASSERT_TRUE(layout.has_value());
+  ASSERT_EQ(layout->width, 10);
+  ASSERT_EQ(layout->height, 8);
+  ASSERT_EQ(layout->enemies.size(), 2u);
+  ASSERT_EQ(layout->items, (std::vector<Position>{{4, 5}}));
+  for (const Position &position : {Position{1, 2}, Position{7, 3}}) {
+    ASSERT_NE(std::find(layout->enemies.begin(), layout->enemies.end(),
+                        position),
+              layout->enemies.end());
+  }
+}
+
+TEST(MapCodecTest, RejectsMalformedEntityLayouts) {
+  Map map(4, 4, {0, 0}, std::vector<Tile>(16, Tile::FLOOR), {}, {});
+  map.addEnemy({1, 1}, std::make_unique<Goblin>(Position{1, 1}));
+  const std::string blob = MapCodec::encodeEntityLayout(map);
+  ASSERT_TRUE(MapCodec::decodeEntityLayout(blob).has_value());
+
+  // One record short, one record too many.
+  ASSERT_FALSE(
+      MapCodec::decodeEntityLayout(blob.substr(0, blob.size() - 8)));
+  ASSERT_FALSE(MapCodec::decodeEntityLayout(blob + std::string(8, '\0')));
+  // Shorter than the header.
+  ASSERT_FALSE(MapCodec::decodeEntityLayout(blob.substr(0, 10)));
+
+  std::string bad_magic = blob;
+  bad_magic[0] = 'X';
+  ASSERT_FALSE(MapCodec::decodeEntityLayout(bad_magic));
+
+  std::string bad_version = blob;
+  bad_version[4] = 2;
+  ASSERT_FALSE(MapCodec::decodeEntityLayout(bad_version));
+}
@@ -0,0 +1,185 @@
+#include "MapRepository.h"
+#include "EnemyRepository.h"
+#include "Goblin.h"
+#include "Item.h"
+#include "ItemRepository.h"
+#include "LevelDbProvider.h"
+#include "Map.h"
+#include "MapDimensions.h"
+#include "Position.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+
+namespace {
+
+template <typename T> std::string rawBytes(const T &value) {
+  std::string bytes(sizeof(T), '\0');
+  std::memcpy(bytes.data(), &value, sizeof(T));
+  return bytes;
+}
+
+// A floor-only map with a goblin at each of enemies and a potion at each of
+// items.
+Map makeMap(int width, int height, const std::vector<Position> &enemies,
+            const std::vector<Position> &items) {
+  std::vector<std::pair<Position, std::unique_ptr<Enemy>>> placed_enemies;
+  for (const auto &position : enemies) {
+    placed_enemies.emplace_back(position, std::make_unique<Goblin>(position));
+  }
+  std::vector<std::pair<Position, std::unique_ptr<Item>>> placed_items;
+  for (const auto &position : items) {
+    placed_items.emplace_back(
+        position,
+        std::make_unique<Item>(Item::ItemType::HealthPotion, "Health Potion"));
+  }
+  return Map(width, height, Position{0, 0},
+             std::vector<Tile>(static_cast<std::size_t>(width) * height,
+                               Tile::FLOOR),
+             std::move(placed_enemies), std::move(placed_items));
+}
+
+class MapRepositoryTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    db_path_ = std::filesystem::temp_directory_path() / "map_repository_test";
+    std::filesystem::remove_all(db_path_);
+    provider_ = std::make_unique<LevelDbProvider>(db_path_.string());
+    ASSERT_TRUE(provider_->isOpen());
+    enemy_repo_ = std::make_unique<EnemyRepository>(*provider_);
+    item_repo_ = std::make_unique<ItemRepository>(*provider_);
+    map_repo_ =
+        std::make_unique<MapRepository>(*provider_, *enemy_repo_, *item_repo_);
+  }
+
+  void TearDown() override {
+    map_repo_.reset();
+    item_repo_.reset();
+    enemy_repo_.reset();
+    provider_.reset();
+    std::filesystem::remove_all(db_path_);
+  }
+
+  void save(const std::string &key, const Map &map) {
+    LevelDbBatch batch;
+    map_repo_->saveForBatch(batch, key, map);
+    ASSERT_TRUE(provider_->commitBatch(batch));
+  }
+
+  std::vector<std::string> keysUnder(const std::string &prefix) {
+    return provider_->scanKeys(prefix).value_or(std::vector<std::string>());
+  }
+
+  std::filesystem::path db_path_;
+  std::unique_ptr<LevelDbProvider> provider_;
+  std::unique_ptr<EnemyRepository> enemy_repo_;
+  std::unique_ptr<ItemRepository> item_repo_;
+  std::unique_ptr<MapRepository> map_repo_;
+};
+
+} // namespace
+
+// Records exactly as the first release wrote them: raw dimensions and start
+// position, tiles and entity ids (their names) in one JSON record, and one
+// JSON record per entity under its lowercased name.
+TEST_F(MapRepositoryTest, LoadsAMapInTheFirstSaveFormat) {
+  provider_->Put("main_map:dimensions", rawBytes(MapDimensions{3, 2}));
+  provider_->Put("main_map:start_position", rawBytes(Position{0, 0}));
+  const nlohmann::json non_standard = {
+      {"tiles", {{1, 1, 2}, {0, 1, 1}}},
+      {"enemies", {{{"position", {{"x", 1}, {"y", 0}}}, {"id", "Goblin"}}}},
+      {"items",
+       {{{"position", {{"x", 2}, {"y", 1}}}, {"id", "Health Potion"}}}}};
+  provider_->Put("main_map:non_standard", non_standard.dump());
+  provider_->Put("main_map:enemies:goblin",
+                 nlohmann::json{{"type_name", "Goblin"},
+                                {"name", "Goblin"},
+                                {"health", 7},
+                                {"stats",
+                                 {{"strength", 3},
+                                  {"dexterity", 4},
+                                  {"intelligence", 1},
+                                  {"vitality", 2}}},
+                                {"position", {{"x", 1}, {"y", 0}}}}
+                     .dump());
+  provider_->Put("main_map:items:health potion",
+                 nlohmann::json{{"type", 0}, {"name", "Health Potion"}}.dump());
+
+  auto map = map_repo_->findById("main_map");
+
+  ASSERT_TRUE(map.has_value());
+  EXPECT_EQ(map->getWidth(), 3);
+  EXPECT_EQ(map->getHeight(), 2);
+  EXPECT_EQ(map->getTile(2, 0), Tile::EXIT);
+  EXPECT_EQ(map->getTile(0, 1), Tile::WALL);
+
+  auto enemy = map->getEnemyAt(Position{1, 0});
+  ASSERT_TRUE(enemy.has_value());
+  EXPECT_EQ(enemy->get().getTypeName(), "Goblin");
+  EXPECT_EQ(enemy->get().getHealth(), 7);
+
+  auto item = map->getItemAt(Position{2, 1});
+  ASSERT_TRUE(item.has_value());
+  EXPECT_EQ(item->get().getName(), "Health Potion");
+  EXPECT_EQ(item->get().getType(), Item::ItemType::HealthPotion);
+}
+
+TEST_F(MapRepositoryTest, SavingAnotherMapRemovesTheRecordsOfTheFirst) {
+  // Three tile chunks, two enemies and an item.
+  save("level", makeMap(64, 40, {{3, 3}, {10, 10}}, {{5, 1}}));
+  save("level", makeMap(10, 10, {{3, 3}}, {}));
+
+  const std::vector<std::string> expected = {
+      "level:dimensions", "level:enemies:3_3", "level:layout",
+      "level:start_position", "level:tiles:0"};
+  EXPECT_EQ(keysUnder("level:"), expected);
+
+  auto map = map_repo_->findById("level");
+  ASSERT_TRUE(map.has_value());
+  EXPECT_EQ(map->getWidth(), 10);
+  EXPECT_EQ(map->getEnemies().size(), 1u);
+  EXPECT_EQ(map->getItems().size(), 0u);
+}
+
+TEST_F(MapRepositoryTest, SavingOverAFirstFormatMapRemovesItsRecords) {
+  provider_->Put("main_map:dimensions", rawBytes(MapDimensions{3, 2}));
+  provider_->Put("main_map:start_position", rawBytes(Position{0, 0}));
+  provider_->Put("main_map:non_standard", R"({"tiles":[[1,1,2],[0,1,1]]})");
+  provider_->Put("main_map:enemies:goblin", "{}");
+  provider_->Put("main_map:items:health potion", "{}");
+
+  save("main_map", makeMap(3, 2, {}, {}));
+
+  const std::vector<std::string> expected = {
+      "main_map:dimensions", "main_map:layout", "main_map:start_position",
+      "main_map:tiles:0"};
+  EXPECT_EQ(keysUnder("main_map:"), expected);
+}
+
+TEST_F(MapRepositoryTest, RejectsImplausibleDimensionsWithoutAllocating) {
+  save("level", makeMap(10, 10, {}, {}));
+  for (const MapDimensions &dimensions :
+       {MapDimensions{-1, 10}, MapDimensions{10, 0}}) {
+    provider_->Put("level:dimensions", rawBytes(dimensions));
+    EXPECT_FALSE(map_repo_->findById("level").has_value());
+  }
+
+  // First-format maps have no layout to check the dimensions against; the
+  // stored tiles must account for them instead.
+  provider_->Put("old:dimensions", rawBytes(MapDimensions{1 << 30, 2}));
+  provider_->Put("old:start_position", rawBytes(Position{0, 0}));
+  provider_->Put("old:non_standard", R"({"tiles":[[1,1,2],[0,1,1]]})");
+  EXPECT_FALSE(map_repo_->findById("old").has_value());
+
+  provider_->Put("old:dimensions", rawBytes(MapDimensions{1 << 20, 1 << 20}));
+  provider_->Put("old:tiles:0", *provider_->Get("level:tiles:0"));
+  EXPECT_FALSE(map_repo_->findById("old").has_value());
+}
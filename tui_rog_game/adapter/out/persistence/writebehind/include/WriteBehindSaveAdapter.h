@@ -0,0 +1,75 @@
+#pragma once
+
+#include "GameStateDTO.h"
+#include "ISaveGameStatePort.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+
+// Decorates another save port so saving never blocks the caller on storage.
+// saveGameState snapshots the state and returns; a background writer hands
+// snapshots to the wrapped port. Saves arriving while one is still pending are
+// coalesced: only the latest state is written, carrying the change sets of the
+// snapshots it replaced so incremental saves stay complete.
+class WriteBehindSaveAdapter : public Port::Out::ISaveGameStatePort {
+public:
+  struct Options {
+    // How long a pending snapshot waits for newer saves before it is written.
+    std::chrono::milliseconds flush_interval{100};
+    // Saves folded into the pending snapshot before it is written without
+    // waiting out the interval. Once the writer is also busy, further saves
+    // block until it catches up, bounding how far storage can fall behind.
+    std::size_t max_pending = 8;
+  };
+
+  explicit WriteBehindSaveAdapter(
+      std::shared_ptr<Port::Out::ISaveGameStatePort> inner);
+  WriteBehindSaveAdapter(std::shared_ptr<Port::Out::ISaveGameStatePort> inner,
+                         Options options);
+  // Writes whatever is still pending before returning.
+  ~WriteBehindSaveAdapter() override;
+
+  WriteBehindSaveAdapter(const WriteBehindSaveAdapter &) = delete;
+  WriteBehindSaveAdapter &operator=(const WriteBehindSaveAdapter &) = delete;
+
+  void
+  saveGameState(const TuiRogGame::Port::Out::GameStateDTO &gameState) override;
+  void flush() override;
+
+  // Saves accepted, and saves actually handed to the wrapped port.
+  std::size_t getSaveCount() const;
+  std::size_t getWriteCount() const;
+
+private:
+  void writerLoop();
+
+  std::shared_ptr<Port::Out::ISaveGameStatePort> inner_;
+  Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable space_available_;
+  std::condition_variable idle_;
+  std::unique_ptr<Port::Out::GameStateDTO> pending_;
+  std::size_t pending_count_ = 0; // Saves folded into pending_.
+  std::chrono::steady_clock::time_point pending_since_;
+  bool writing_ = false;
+  std::size_t flush_waiters_ = 0;
+  bool stopping_ = false;
+  std::size_t save_count_ = 0;
+  std::size_t write_count_ = 0;
+  std::thread writer_;
+};
+
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
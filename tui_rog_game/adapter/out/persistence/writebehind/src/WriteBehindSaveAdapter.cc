@@ -0,0 +1,126 @@
+#include "WriteBehindSaveAdapter.h"
+#include <spdlog/spdlog.h>
+
+namespace TuiRogGame {
+namespace Adapter {
+namespace Out {
+namespace Persistence {
+
+WriteBehindSaveAdapter::WriteBehindSaveAdapter(
+    std::shared_ptr<Port::Out::ISaveGameStatePort> inner)
+    : WriteBehindSaveAdapter(std::move(inner), Options()) {}
+
+WriteBehindSaveAdapter::WriteBehindSaveAdapter(
+    std::shared_ptr<Port::Out::ISaveGameStatePort> inner, Options options)
+    : inner_(std::move(inner)), options_(options) {
+  if (options_.max_pending == 0) {
+    options_.max_pending = 1;
+  }
+  writer_ = std::thread([this] { writerLoop(); });
+  spdlog::info("[WriteBehindSaveAdapter] Started (flush interval {} ms, max "
+               "pending {}).",
+               options_.flush_interval.count(), options_.max_pending);
+}
+
+WriteBehindSaveAdapter::~WriteBehindSaveAdapter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+  space_available_.notify_all();
+  writer_.join();
+  if (inner_) {
+    inner_->flush();
+  }
+  spdlog::info("[WriteBehindSaveAdapter] Stopped after {} saves, {} writes.",
+               save_count_, write_count_);
+}
+
+void WriteBehindSaveAdapter::saveGameState(
+    const TuiRogGame::Port::Out::GameStateDTO &gameState) {
+  // Copy before taking the lock so the writer is never held up by it.
+  auto snapshot = std::make_unique<Port::Out::GameStateDTO>(gameState);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  space_available_.wait(lock, [this] {
+    return stopping_ || pending_count_ < options_.max_pending;
+  });
+  if (pending_) {
+    snapshot->map.mergeEarlierChanges(pending_->map.getChanges());
+    snapshot->player.mergeEarlierChanges(pending_->player.getChanges());
+  } else {
+    pending_since_ = std::chrono::steady_clock::now();
+  }
+  pending_ = std::move(snapshot);
+  ++pending_count_;
+  ++save_count_;
+  lock.unlock();
+  work_available_.notify_one();
+}
+
+void WriteBehindSaveAdapter::flush() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++flush_waiters_;
+    work_available_.notify_one();
+    idle_.wait(lock, [this] { return !pending_ && !writing_; });
+    --flush_waiters_;
+  }
+  if (inner_) {
+    inner_->flush();
+  }
+}
+
+std::size_t WriteBehindSaveAdapter::getSaveCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return save_count_;
+}
+
+std::size_t WriteBehindSaveAdapter::getWriteCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return write_count_;
+}
+
+void WriteBehindSaveAdapter::writerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_available_.wait(lock, [this] { return stopping_ || pending_; });
+    if (!pending_) {
+      return; // Stopping with nothing left to write.
+    }
+
+    // Give rapid successive saves a chance to coalesce into this one.
+    work_available_.wait_until(
+        lock, pending_since_ + options_.flush_interval, [this] {
+          return stopping_ || flush_waiters_ > 0 ||
+                 pending_count_ >= options_.max_pending;
+        });
+
+    std::unique_ptr<Port::Out::GameStateDTO> snapshot = std::move(pending_);
+    const std::size_t coalesced = pending_count_;
+    pending_count_ = 0;
+    writing_ = true;
+    lock.unlock();
+    space_available_.notify_all();
+
+    if (inner_) {
+      inner_->saveGameState(*snapshot);
+    }
+    spdlog::debug("[WriteBehindSaveAdapter] Wrote snapshot covering {} "
+                  "save(s).",
+                  coalesced);
+
+    lock.lock();
+    writing_ = false;
+    ++write_count_;
+    if (!pending_) {
+      idle_.notify_all();
+    }
+  }
+}
+
+} // namespace Persistence
+} // namespace Out
+} // namespace Adapter
+} // namespace TuiRogGame
@@ -0,0 +1,121 @@
+#include "WriteBehindSaveAdapter.h"
+#include "GameStateDTO.h"
+#include "ISaveGameStatePort.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace TuiRogGame::Adapter::Out::Persistence;
+using namespace TuiRogGame::Domain::Model;
+using namespace TuiRogGame::Port::Out;
+
+namespace {
+
+class RecordingSavePort : public ISaveGameStatePort {
+public:
+  void saveGameState(const GameStateDTO &gameState) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    saved_.push_back(std::make_unique<GameStateDTO>(gameState));
+  }
+
+  std::size_t savedCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return saved_.size();
+  }
+
+  const GameStateDTO &last() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return *saved_.back();
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<GameStateDTO>> saved_;
+};
+
+GameStateDTO makeState() {
+  Map map(10, 10, {0, 0}, std::vector<Tile>(100, Tile::FLOOR), {}, {});
+  Player player("p", Stats{}, {0, 0});
+  map.clearChanges();
+  player.clearChanges();
+  return GameStateDTO(std::move(map), std::move(player));
+}
+
+bool waitForSaves(RecordingSavePort &port, std::size_t count) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (port.savedCount() < count) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+} // namespace
+
+TEST(WriteBehindSaveAdapterTest, CoalescesRapidSavesIntoLatestState) {
+  auto inner = std::make_shared<RecordingSavePort>();
+  WriteBehindSaveAdapter::Options options;
+  options.flush_interval = std::chrono::hours(1);
+  options.max_pending = 100;
+  WriteBehindSaveAdapter adapter(inner, options);
+
+  GameStateDTO state = makeState();
+  for (int x = 1; x <= 5; ++x) {
+    state.map.setTile(x, 0, Tile::WALL);
+    state.player.moveTo({x, 1});
+    adapter.saveGameState(state);
+    // Mirror the engine: changes are cleared once the save is handed off.
+    state.map.clearChanges();
+    state.player.clearChanges();
+  }
+  adapter.flush();
+
+  ASSERT_EQ(adapter.getSaveCount(), 5u);
+  ASSERT_EQ(adapter.getWriteCount(), 1u);
+  ASSERT_EQ(inner->savedCount(), 1u);
+  const GameStateDTO &written = inner->last();
+  ASSERT_EQ(written.player.getPosition(), (Position{5, 1}));
+  // The single write still covers every tile changed by the skipped saves.
+  ASSERT_EQ(written.map.getChanges().tiles.size(), 5u);
+  ASSERT_TRUE(written.player.getChanges().position);
+}
+
+TEST(WriteBehindSaveAdapterTest, WritesAfterFlushInterval) {
+  auto inner = std::make_shared<RecordingSavePort>();
+  WriteBehindSaveAdapter::Options options;
+  options.flush_interval = std::chrono::milliseconds(5);
+  WriteBehindSaveAdapter adapter(inner, options);
+
+  adapter.saveGameState(makeState());
+  ASSERT_TRUE(waitForSaves(*inner, 1));
+}
+
+TEST(WriteBehindSaveAdapterTest, WritesWhenPendingLimitReached) {
+  auto inner = std::make_shared<RecordingSavePort>();
+  WriteBehindSaveAdapter::Options options;
+  options.flush_interval = std::chrono::hours(1);
+  options.max_pending = 2;
+  WriteBehindSaveAdapter adapter(inner, options);
+
+  GameStateDTO state = makeState();
+  adapter.saveGameState(state);
+  adapter.saveGameState(state);
+  ASSERT_TRUE(waitForSaves(*inner, 1));
+}
+
+TEST(WriteBehindSaveAdapterTest, DestructorWritesPendingState) {
+  auto inner = std::make_shared<RecordingSavePort>();
+  {
+    WriteBehindSaveAdapter::Options options;
+    options.flush_interval = std::chrono::hours(1);
+    WriteBehindSaveAdapter adapter(inner, options);
+    adapter.saveGameState(makeState());
+  }
+  ASSERT_EQ(inner->savedCount(), 1u);
+}
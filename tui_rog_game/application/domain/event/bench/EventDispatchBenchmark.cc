@@ -0,0 +1,171 @@
+#include "CombatStartedEvent.h"
+#include "DescriptionGeneratedEvent.h"
+#include "DomainEvent.h"
+#include "EnemyAttackedEvent.h"
+#include "EnemyDefeatedEvent.h"
+#include "EventVisitor.h"
+#include "GameLoadedEvent.h"
+#include "ItemFoundEvent.h"
+#include "ItemUsedEvent.h"
+#include "MapChangedEvent.h"
+#include "PlayerAttackedEvent.h"
+#include "PlayerDiedEvent.h"
+#include "PlayerLeveledUpEvent.h"
+#include "PlayerMovedEvent.h"
+#include "Rng.h"
+#include "Stats.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace {
+void addCounters(benchmark::State &state, uint64_t cnt) {
+  state.counters["OPS"] = benchmark::Counter(cnt, benchmark::Counter::kIsRate);
+  state.counters["Latency"] = benchmark::Counter(
+      cnt, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+} // namespace
+
+namespace TuiRogGame {
+namespace Benchmark {
+
+using namespace Domain::Event;
+
+struct BenchmarkInitializer {
+  BenchmarkInitializer() { spdlog::set_level(spdlog::level::off); }
+};
+static BenchmarkInitializer benchmark_initializer;
+
+// An even mix of every event class, shuffled so the branch predictor cannot
+// learn the sequence.
+std::vector<std::unique_ptr<DomainEvent>> makeMixedEvents(std::size_t count) {
+  std::vector<std::unique_ptr<DomainEvent>> events;
+  events.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    switch (i % 12) {
+    case 0:
+      events.push_back(std::make_unique<PlayerMovedEvent>(
+          Domain::Model::Position{static_cast<int>(i % 64), 1}));
+      break;
+    case 1:
+      events.push_back(std::make_unique<ItemFoundEvent>(
+          ItemFoundEvent::ItemType::HealthPotion, "Potion", "Heals"));
+      break;
+    case 2:
+      events.push_back(
+          std::make_unique<CombatStartedEvent>("Orc", "Orc", 30, 5, 2));
+      break;
+    case 3:
+      events.push_back(std::make_unique<PlayerAttackedEvent>(7, "Orc", 23));
+      break;
+    case 4:
+      events.push_back(std::make_unique<EnemyAttackedEvent>("Orc", 4, 96));
+      break;
+    case 5:
+      events.push_back(std::make_unique<EnemyDefeatedEvent>("Orc", 50));
+      break;
+    case 6:
+      events.push_back(std::make_unique<ItemUsedEvent>("Potion"));
+      break;
+    case 7:
+      events.push_back(
+          std::make_unique<PlayerLeveledUpEvent>(2, Domain::Model::Stats()));
+      break;
+    case 8:
+      events.push_back(std::make_unique<PlayerDiedEvent>());
+      break;
+    case 9:
+      events.push_back(std::make_unique<DescriptionGeneratedEvent>("..."));
+      break;
+    case 10:
+      events.push_back(std::make_unique<GameLoadedEvent>());
+      break;
+    default:
+      events.push_back(std::make_unique<MapChangedEvent>());
+      break;
+    }
+  }
+  Domain::Model::Rng rng(42);
+  rng.shuffle(events.begin(), events.end());
+  return events;
+}
+
+const std::vector<std::unique_ptr<DomainEvent>> &mixedEvents() {
+  static const auto events = makeMixedEvents(1 << 20);
+  return events;
+}
+
+// The dynamic_cast chain the adapters used, in HardcodedDescAdapter's order.
+int scoreWithDynamicCast(const DomainEvent &event) {
+  if (dynamic_cast<const GameLoadedEvent *>(&event)) {
+    return 1;
+  } else if (auto e = dynamic_cast<const PlayerMovedEvent *>(&event)) {
+    return e->getNewPosition().x;
+  } else if (auto e = dynamic_cast<const CombatStartedEvent *>(&event)) {
+    return e->getEnemyHp();
+  } else if (dynamic_cast<const EnemyDefeatedEvent *>(&event)) {
+    return 3;
+  } else if (auto e = dynamic_cast<const ItemFoundEvent *>(&event)) {
+    return static_cast<int>(e->getItemName().size());
+  } else if (dynamic_cast<const MapChangedEvent *>(&event)) {
+    return 5;
+  } else if (auto e = dynamic_cast<const PlayerLeveledUpEvent *>(&event)) {
+    return e->getNewLevel();
+  } else if (dynamic_cast<const PlayerDiedEvent *>(&event)) {
+    return 7;
+  } else if (auto e = dynamic_cast<const PlayerAttackedEvent *>(&event)) {
+    return e->getDamageDealt();
+  } else if (auto e = dynamic_cast<const EnemyAttackedEvent *>(&event)) {
+    return e->getDamageDealt();
+  } else if (auto e = dynamic_cast<const ItemUsedEvent *>(&event)) {
+    return static_cast<int>(e->getItemName().size());
+  }
+  return 0;
+}
+
+int scoreWithVisitor(const DomainEvent &event) {
+  return visit(
+      event,
+      Overloaded{
+          [](const GameLoadedEvent &) { return 1; },
+          [](const PlayerMovedEvent &e) { return e.getNewPosition().x; },
+          [](const CombatStartedEvent &e) { return e.getEnemyHp(); },
+          [](const EnemyDefeatedEvent &) { return 3; },
+          [](const ItemFoundEvent &e) {
+            return static_cast<int>(e.getItemName().size());
+          },
+          [](const MapChangedEvent &) { return 5; },
+          [](const PlayerLeveledUpEvent &e) { return e.getNewLevel(); },
+          [](const PlayerDiedEvent &) { return 7; },
+          [](const PlayerAttackedEvent &e) { return e.getDamageDealt(); },
+          [](const EnemyAttackedEvent &e) { return e.getDamageDealt(); },
+          [](const ItemUsedEvent &e) {
+            return static_cast<int>(e.getItemName().size());
+          },
+          [](const DomainEvent &) { return 0; }});
+}
+
+template <int (*Score)(const DomainEvent &)>
+static void BM_EventDispatch(benchmark::State &state) {
+  const auto &events = mixedEvents();
+  for (auto _ : state) {
+    std::int64_t total = 0;
+    for (const auto &event : events) {
+      total += Score(*event);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.counters["EventsPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * events.size()),
+      benchmark::Counter::kIsRate);
+  addCounters(state, state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_EventDispatch, scoreWithDynamicCast)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EventDispatch, scoreWithVisitor)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace Benchmark
+} // namespace TuiRogGame
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DomainEvent.h"
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -14,6 +15,9 @@ public:
                               int enemy_attack, int enemy_defense);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<CombatStartedEvent>(*this);
+  }
 
   const std::string &getEnemyTypeName() const { return enemy_type_name_; }
   const std::string &getEnemyName() const { return enemy_name_; }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "DomainEvent.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -9,14 +11,32 @@ namespace Event {
 
 class DescriptionGeneratedEvent : public DomainEvent {
 public:
-  DescriptionGeneratedEvent(const std::string &description);
+  // turn_id identifies the GameEngine turn the description belongs to and
+  // sequence_id orders descriptions across turns, so that late arrivals from
+  // an earlier turn can be recognized and dropped by the render port.
+  // A partial event carries the next piece of a description that is still
+  // being generated; the complete text follows in a final event with the same
+  // sequence_id.
+  DescriptionGeneratedEvent(const std::string &description,
+                            std::uint64_t turn_id = 0,
+                            std::uint64_t sequence_id = 0,
+                            bool partial = false);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<DescriptionGeneratedEvent>(*this);
+  }
 
   const std::string &getDescription() const { return description_; }
+  std::uint64_t getTurnId() const { return turn_id_; }
+  std::uint64_t getSequenceId() const { return sequence_id_; }
+  bool isPartial() const { return partial_; }
 
 private:
   std::string description_;
+  std::uint64_t turn_id_;
+  std::uint64_t sequence_id_;
+  bool partial_;
 };
 
 } // namespace Event
@@ -29,6 +29,7 @@ public:
   virtual ~DomainEvent() = default;
   Type getType() const { return type_; }
   virtual std::string toString() const = 0;
+  virtual std::unique_ptr<DomainEvent> clone() const = 0;
 
 protected:
   DomainEvent(Type type) : type_(type) {}
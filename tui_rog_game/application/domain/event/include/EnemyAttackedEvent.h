@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DomainEvent.h"
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -13,6 +14,9 @@ public:
                      int player_current_health);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<EnemyAttackedEvent>(*this);
+  }
 
   const std::string &getEnemyName() const { return enemy_name_; }
   int getDamageDealt() const { return damage_dealt_; }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DomainEvent.h"
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -12,6 +13,9 @@ public:
   EnemyDefeatedEvent(const std::string &enemy_name, int xp_gained);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<EnemyDefeatedEvent>(*this);
+  }
 
   const std::string &getEnemyName() const { return enemy_name_; }
   int getXpGained() const { return xp_gained_; }
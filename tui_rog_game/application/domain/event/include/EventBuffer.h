@@ -0,0 +1,72 @@
+#pragma once
+
+#include "DomainEvent.h"
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Event {
+
+// Read-only view over the events of one turn. Iterating yields
+// `const DomainEvent *`; the events belong to the EventBuffer the span came
+// from and are only valid until that buffer is cleared.
+class EventSpan {
+public:
+  using iterator = const DomainEvent *const *;
+
+  EventSpan() = default;
+  EventSpan(iterator first, std::size_t count)
+      : first_(first), count_(count) {}
+
+  iterator begin() const { return first_; }
+  iterator end() const { return first_ + count_; }
+  std::size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  const DomainEvent &operator[](std::size_t i) const { return *first_[i]; }
+
+private:
+  iterator first_ = nullptr;
+  std::size_t count_ = 0;
+};
+
+// Per-turn event storage. Events are constructed into a monotonic arena that
+// starts in an inline buffer and are all destroyed by clear(), which rewinds
+// the arena. A turn only spills to the heap if its events outgrow the inline
+// buffer; the pointer list keeps its capacity between turns.
+class EventBuffer {
+public:
+  static constexpr std::size_t kInlineBytes = 2048;
+
+  EventBuffer();
+  ~EventBuffer();
+
+  EventBuffer(const EventBuffer &) = delete;
+  EventBuffer &operator=(const EventBuffer &) = delete;
+
+  template <typename E, typename... Args> E &emplace(Args &&...args) {
+    void *storage = arena_.allocate(sizeof(E), alignof(E));
+    E *event = ::new (storage) E(std::forward<Args>(args)...);
+    events_.push_back(event);
+    return *event;
+  }
+
+  // Destroys every event and rewinds the arena.
+  void clear();
+
+  EventSpan view() const { return EventSpan(events_.data(), events_.size()); }
+  std::size_t size() const { return events_.size(); }
+  bool empty() const { return events_.empty(); }
+
+private:
+  alignas(std::max_align_t) std::byte inline_buffer_[kInlineBytes];
+  std::pmr::monotonic_buffer_resource arena_;
+  std::vector<DomainEvent *> events_;
+};
+
+} // namespace Event
+} // namespace Domain
+} // namespace TuiRogGame
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CombatStartedEvent.h"
+#include "DescriptionGeneratedEvent.h"
+#include "DomainEvent.h"
+#include "EnemyAttackedEvent.h"
+#include "EnemyDefeatedEvent.h"
+#include "GameLoadedEvent.h"
+#include "ItemFoundEvent.h"
+#include "ItemUsedEvent.h"
+#include "MapChangedEvent.h"
+#include "PlayerAttackedEvent.h"
+#include "PlayerDiedEvent.h"
+#include "PlayerLeveledUpEvent.h"
+#include "PlayerMovedEvent.h"
+#include <type_traits>
+#include <utility>
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Event {
+
+// Builds one visitor out of several lambdas:
+//   visit(event, Overloaded{
+//       [](const ItemFoundEvent &e) { ... },
+//       [](const DomainEvent &) { /* everything else */ }});
+template <typename... Handlers> struct Overloaded : Handlers... {
+  using Handlers::operator()...;
+};
+template <typename... Handlers>
+Overloaded(Handlers...) -> Overloaded<Handlers...>;
+
+// Stands in for events whose tag has no event class of its own (GameSaved,
+// Unknown), so a visitor can handle them without a DomainEvent catch-all.
+struct UntypedEvent {
+  const DomainEvent &event;
+};
+
+namespace Detail {
+template <typename Visitor, typename... Events>
+constexpr bool handlesAll =
+    (std::is_invocable_v<Visitor, const Events &> && ...);
+
+// Concrete events derive from DomainEvent directly, so a visitor that cannot
+// take a DomainEvent (nor, therefore, anything through a generic lambda) is
+// only invocable with the event types it names.
+template <typename Visitor>
+constexpr bool handlesEachExactly =
+    !std::is_invocable_v<Visitor, const DomainEvent &> &&
+    handlesAll<Visitor, UntypedEvent, PlayerMovedEvent, ItemFoundEvent,
+               CombatStartedEvent, PlayerAttackedEvent, EnemyAttackedEvent,
+               EnemyDefeatedEvent, ItemUsedEvent, PlayerLeveledUpEvent,
+               PlayerDiedEvent, DescriptionGeneratedEvent, GameLoadedEvent,
+               MapChangedEvent>;
+
+template <typename Visitor>
+decltype(auto) dispatch(const DomainEvent &event, Visitor &visitor) {
+  using Type = DomainEvent::Type;
+  switch (event.getType()) {
+  case Type::PlayerMoved:
+    return visitor(static_cast<const PlayerMovedEvent &>(event));
+  case Type::ItemFound:
+    return visitor(static_cast<const ItemFoundEvent &>(event));
+  case Type::CombatStarted:
+    return visitor(static_cast<const CombatStartedEvent &>(event));
+  case Type::PlayerAttacked:
+    return visitor(static_cast<const PlayerAttackedEvent &>(event));
+  case Type::EnemyAttacked:
+    return visitor(static_cast<const EnemyAttackedEvent &>(event));
+  case Type::EnemyDefeated:
+    return visitor(static_cast<const EnemyDefeatedEvent &>(event));
+  case Type::ItemUsed:
+    return visitor(static_cast<const ItemUsedEvent &>(event));
+  case Type::PlayerLeveledUp:
+    return visitor(static_cast<const PlayerLeveledUpEvent &>(event));
+  case Type::PlayerDied:
+    return visitor(static_cast<const PlayerDiedEvent &>(event));
+  case Type::DescriptionGenerated:
+    return visitor(static_cast<const DescriptionGeneratedEvent &>(event));
+  case Type::GameLoaded:
+    return visitor(static_cast<const GameLoadedEvent &>(event));
+  case Type::MapChanged:
+    return visitor(static_cast<const MapChangedEvent &>(event));
+  case Type::GameSaved:
+  case Type::Unknown:
+    break;
+  }
+  if constexpr (std::is_invocable_v<Visitor &, const UntypedEvent &>) {
+    return visitor(UntypedEvent{event});
+  } else {
+    return visitor(event);
+  }
+}
+} // namespace Detail
+
+// Calls the visitor with the event as its concrete type. Dispatch is a switch
+// on getType() followed by a static_cast, so no RTTI is involved; each
+// concrete event sets its own Type in its constructor, which is what makes
+// the cast safe. The switch has no default, so a new Type is flagged by
+// -Wswitch until it is added here, and every overload must return the same
+// type.
+//
+// A const DomainEvent & overload catches every type the visitor does not
+// handle explicitly, and GameSaved and Unknown unless it handles
+// UntypedEvent. Use visitExhaustive() where each type must be handled.
+template <typename Visitor>
+decltype(auto) visit(const DomainEvent &event, Visitor &&visitor) {
+  static_assert(
+      Detail::handlesAll<Visitor, PlayerMovedEvent, ItemFoundEvent,
+                         CombatStartedEvent, PlayerAttackedEvent,
+                         EnemyAttackedEvent, EnemyDefeatedEvent,
+                         ItemUsedEvent, PlayerLeveledUpEvent, PlayerDiedEvent,
+                         DescriptionGeneratedEvent, GameLoadedEvent,
+                         MapChangedEvent> &&
+          (std::is_invocable_v<Visitor, const DomainEvent &> ||
+           std::is_invocable_v<Visitor, const UntypedEvent &>),
+      "Event visitor must handle every event type, e.g. through a "
+      "const DomainEvent & catch-all.");
+  return Detail::dispatch(event, visitor);
+}
+
+// Like visit(), but the visitor must name every concrete event type and
+// UntypedEvent, and may not take a const DomainEvent & or be generic, so
+// adding an event class breaks the build until each such visitor handles it.
+template <typename Visitor>
+decltype(auto) visitExhaustive(const DomainEvent &event, Visitor &&visitor) {
+  static_assert(Detail::handlesEachExactly<Visitor>,
+                "Exhaustive event visitor must handle UntypedEvent and every "
+                "concrete event type by name, without a DomainEvent "
+                "catch-all.");
+  return Detail::dispatch(event, visitor);
+}
+
+} // namespace Event
+} // namespace Domain
+} // namespace TuiRogGame
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DomainEvent.h"
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -11,6 +12,9 @@ class GameLoadedEvent : public DomainEvent {
 public:
   GameLoadedEvent() : DomainEvent(Type::GameLoaded) {}
   std::string toString() const override { return "GameLoadedEvent"; }
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<GameLoadedEvent>(*this);
+  }
 };
 
 } // namespace Event
@@ -16,6 +16,9 @@ public:
                           const std::string &item_description);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<ItemFoundEvent>(*this);
+  }
 
   ItemType getItemType() const { return item_type_; }
   const std::string &getItemName() const { return item_name_; }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DomainEvent.h"
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -12,6 +13,9 @@ public:
   ItemUsedEvent(const std::string &item_name);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<ItemUsedEvent>(*this);
+  }
 
   const std::string &getItemName() const { return item_name_; }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DomainEvent.h"
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -11,6 +12,9 @@ class PlayerDiedEvent : public DomainEvent {
 public:
   PlayerDiedEvent() : DomainEvent(Type::PlayerDied) {}
   std::string toString() const override { return "You died! Game Over."; }
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<PlayerDiedEvent>(*this);
+  }
 };
 
 } // namespace Event
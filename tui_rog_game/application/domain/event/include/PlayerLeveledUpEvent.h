@@ -3,6 +3,7 @@
 #include "DomainEvent.h"
 #include "Stats.h"
 #include <format>
+#include <memory>
 #include <string>
 
 namespace TuiRogGame {
@@ -14,6 +15,9 @@ public:
   PlayerLeveledUpEvent(int new_level, const Model::Stats &new_stats);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<PlayerLeveledUpEvent>(*this);
+  }
 
   int getNewLevel() const { return new_level_; }
   const Model::Stats &getNewStats() const { return new_stats_; }
@@ -2,6 +2,7 @@
 
 #include "DomainEvent.h"
 #include "Position.h"
+#include <memory>
 
 namespace TuiRogGame {
 namespace Domain {
@@ -13,6 +14,9 @@ public:
       const TuiRogGame::Domain::Model::Position &new_position);
 
   std::string toString() const override;
+  std::unique_ptr<DomainEvent> clone() const override {
+    return std::make_unique<PlayerMovedEvent>(*this);
+  }
 
   TuiRogGame::Domain::Model::Position getNewPosition() const;
 
@@ -6,8 +6,10 @@ namespace Domain {
 namespace Event {
 
 DescriptionGeneratedEvent::DescriptionGeneratedEvent(
-    const std::string &description)
-    : DomainEvent(Type::DescriptionGenerated), description_(description) {}
+    const std::string &description, std::uint64_t turn_id,
+    std::uint64_t sequence_id, bool partial)
+    : DomainEvent(Type::DescriptionGenerated), description_(description),
+      turn_id_(turn_id), sequence_id_(sequence_id), partial_(partial) {}
 
 std::string DescriptionGeneratedEvent::toString() const { return description_; }
 
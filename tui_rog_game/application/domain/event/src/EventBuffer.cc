@@ -0,0 +1,26 @@
+#include "EventBuffer.h"
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Event {
+
+EventBuffer::EventBuffer()
+    : arena_(inline_buffer_, sizeof(inline_buffer_),
+             std::pmr::new_delete_resource()) {
+  // Enough for any single turn the engine produces today.
+  events_.reserve(16);
+}
+
+EventBuffer::~EventBuffer() { clear(); }
+
+void EventBuffer::clear() {
+  for (DomainEvent *event : events_) {
+    event->~DomainEvent();
+  }
+  events_.clear();
+  arena_.release();
+}
+
+} // namespace Event
+} // namespace Domain
+} // namespace TuiRogGame
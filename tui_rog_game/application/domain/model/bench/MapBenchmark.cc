@@ -0,0 +1,229 @@
+#include "Enemy.h"
+#include "Item.h"
+#include "Map.h"
+#include "Orc.h"
+#include "Position.h"
+#include "Rng.h"
+#include "Tile.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <utility>
+#include <vector>
+
+// Counts every heap allocation made by the benchmark process so the
+// benchmarks can report allocations per operation.
+namespace {
+std::atomic<std::size_t> allocation_count{0};
+std::atomic<std::size_t> allocated_bytes{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+void addCounters(benchmark::State &state, uint64_t cnt) {
+  state.counters["OPS"] = benchmark::Counter(cnt, benchmark::Counter::kIsRate);
+  state.counters["Latency"] = benchmark::Counter(
+      cnt, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+// Reports heap allocations (and bytes) per iteration since `start`.
+class AllocationScope {
+public:
+  AllocationScope()
+      : start_count_(allocation_count.load()),
+        start_bytes_(allocated_bytes.load()) {}
+
+  void report(benchmark::State &state) const {
+    const double iterations = static_cast<double>(state.iterations());
+    state.counters["Allocs"] =
+        (allocation_count.load() - start_count_) / iterations;
+    state.counters["AllocBytes"] =
+        (allocated_bytes.load() - start_bytes_) / iterations;
+  }
+
+private:
+  std::size_t start_count_;
+  std::size_t start_bytes_;
+};
+} // namespace
+
+namespace TuiRogGame {
+namespace Benchmark {
+
+struct BenchmarkInitializer {
+  BenchmarkInitializer() { spdlog::set_level(spdlog::level::off); }
+};
+static BenchmarkInitializer benchmark_initializer;
+
+// A walled side x side map with an enemy and an item roughly every 64 tiles.
+Domain::Model::Map createMap(int side) {
+  std::vector<Domain::Model::Tile> tiles(static_cast<std::size_t>(side) * side,
+                                         Domain::Model::Tile::FLOOR);
+  std::vector<
+      std::pair<Domain::Model::Position, std::unique_ptr<Domain::Model::Enemy>>>
+      enemies;
+  std::vector<
+      std::pair<Domain::Model::Position, std::unique_ptr<Domain::Model::Item>>>
+      items;
+  for (int y = 0; y < side; ++y) {
+    for (int x = 0; x < side; ++x) {
+      const std::size_t index = static_cast<std::size_t>(y) * side + x;
+      if (x == 0 || y == 0 || x == side - 1 || y == side - 1) {
+        tiles[index] = Domain::Model::Tile::WALL;
+      } else if (index % 64 == 1) {
+        tiles[index] = Domain::Model::Tile::ENEMY;
+        enemies.emplace_back(
+            Domain::Model::Position{x, y},
+            std::make_unique<Domain::Model::Orc>(
+                Domain::Model::Position{x, y}));
+      } else if (index % 64 == 33) {
+        tiles[index] = Domain::Model::Tile::ITEM;
+        items.emplace_back(Domain::Model::Position{x, y},
+                           std::make_unique<Domain::Model::Item>(
+                               Domain::Model::Item::ItemType::HealthPotion,
+                               "Health Potion"));
+      }
+    }
+  }
+  Domain::Model::Map map(side, side, {1, 1}, std::move(tiles),
+                         std::move(enemies), std::move(items));
+  map.clearChanges();
+  return map;
+}
+
+// One snapshot of the map, as taken for a render or a save.
+static void BM_Map_Copy(benchmark::State &state) {
+  Domain::Model::Map map = createMap(static_cast<int>(state.range(0)));
+
+  AllocationScope allocations;
+  for (auto _ : state) {
+    Domain::Model::Map copy(map);
+    benchmark::DoNotOptimize(copy);
+  }
+  allocations.report(state);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_Map_Copy)->Arg(32)->Arg(128)->Arg(512);
+
+// The snapshots a turn takes: the renderer keeps the latest one, the save
+// and one description request each hold another until the turn is over.
+// With range(1) set the turn also damages an enemy, as an attack does.
+static void BM_Map_TurnSnapshots(benchmark::State &state) {
+  Domain::Model::Map map = createMap(static_cast<int>(state.range(0)));
+  const bool attack = state.range(1) != 0;
+  const Domain::Model::Position enemy_position =
+      map.getEnemies().begin()->position;
+  std::optional<Domain::Model::Map> rendered;
+
+  AllocationScope allocations;
+  for (auto _ : state) {
+    rendered.emplace(map);
+    Domain::Model::Map saved(map);
+    Domain::Model::Map described(map);
+    if (attack) {
+      if (auto enemy = map.getEnemyAt(enemy_position)) {
+        enemy->get().takeDamage(0);
+        map.markEnemyChanged(enemy_position);
+      }
+    }
+    map.clearChanges();
+    benchmark::DoNotOptimize(saved);
+    benchmark::DoNotOptimize(described);
+  }
+  allocations.report(state);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_Map_TurnSnapshots)
+    ->Args({32, 0})
+    ->Args({32, 1})
+    ->Args({128, 0})
+    ->Args({128, 1})
+    ->Args({512, 0})
+    ->Args({512, 1});
+
+// Generates range(0) maps of range(1) x range(1) tiles from a fixed seed, one
+// sub-seed per map like the engine does. The label holds an FNV-1a checksum
+// over all tiles and start positions; it must not change when the generator
+// is only optimized, so compare it between runs to verify output byte for
+// byte.
+static void BM_Map_GenerateFromSeed(benchmark::State &state) {
+  constexpr std::uint64_t kSeed = 20240601;
+  const std::uint64_t map_count = static_cast<std::uint64_t>(state.range(0));
+  const int side = static_cast<int>(state.range(1));
+
+  std::uint64_t checksum = 0;
+  for (auto _ : state) {
+    checksum = 1469598103934665603ull;
+    auto mix = [&checksum](std::uint64_t value) {
+      checksum ^= value;
+      checksum *= 1099511628211ull;
+    };
+    for (std::uint64_t i = 0; i < map_count; ++i) {
+      Domain::Model::Map map(side, side);
+      Domain::Model::Rng rng(Domain::Model::Rng::deriveSeed(kSeed, i));
+      map.generate(rng);
+      for (Domain::Model::Tile tile : map.getTiles()) {
+        mix(static_cast<std::uint64_t>(tile));
+      }
+      mix(static_cast<std::uint64_t>(map.getStartPlayerPosition().x));
+      mix(static_cast<std::uint64_t>(map.getStartPlayerPosition().y));
+    }
+  }
+  char label[32];
+  std::snprintf(label, sizeof(label), "checksum=%016llx",
+                static_cast<unsigned long long>(checksum));
+  state.SetLabel(label);
+  state.counters["MapsPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * map_count),
+      benchmark::Counter::kIsRate);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_Map_GenerateFromSeed)
+    ->Args({16, 20})
+    ->Args({16, 64})
+    ->Args({4, 128})
+    ->Unit(benchmark::kMillisecond);
+
+// One map per iteration, swept over the side length. Complexity is fitted
+// against the tile count, so anything worse than linear shows up as a poor
+// O(N) fit.
+static void BM_Map_GenerateBySize(benchmark::State &state) {
+  const int side = static_cast<int>(state.range(0));
+  std::uint64_t stream = 0;
+  for (auto _ : state) {
+    Domain::Model::Map map(side, side);
+    Domain::Model::Rng rng(Domain::Model::Rng::deriveSeed(20240601, stream++));
+    map.generate(rng);
+    benchmark::DoNotOptimize(map.getStartPlayerPosition());
+  }
+  state.SetComplexityN(static_cast<int64_t>(side) * side);
+  state.counters["TilesPerSec"] = benchmark::Counter(
+      static_cast<double>(state.iterations()) * side * side,
+      benchmark::Counter::kIsRate);
+  addCounters(state, state.iterations());
+}
+BENCHMARK(BM_Map_GenerateBySize)
+    ->RangeMultiplier(2)
+    ->Range(64, 2048)
+    ->Complexity(benchmark::oN)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace Benchmark
+} // namespace TuiRogGame
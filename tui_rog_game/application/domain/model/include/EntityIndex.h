@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Position.h"
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Model {
+
+// Owning index of entities placed on a map grid, keyed by flattened tile index.
+// Entities live in a dense vector for cache-friendly iteration; an
+// open-addressing table (linear probing) maps tile index -> dense slot so
+// lookups are O(1). Removal swaps the last entry into the freed slot, so
+// iteration order is not stable across removals.
+template <typename T> class EntityIndex {
+public:
+  struct Entry {
+    Position position;
+    std::unique_ptr<T> value;
+  };
+  using const_iterator = typename std::vector<Entry>::const_iterator;
+
+  EntityIndex(int width, int height) : width_(width), height_(height) {}
+
+  // Deep copy; clone_value(const T &) must return std::unique_ptr<T>. The
+  // slot table is copied as-is since positions are unchanged.
+  template <typename CloneFn>
+  EntityIndex(const EntityIndex &other, CloneFn clone_value)
+      : width_(other.width_), height_(other.height_), slots_(other.slots_),
+        slot_shift_(other.slot_shift_) {
+    entries_.reserve(other.entries_.size());
+    for (const auto &entry : other.entries_) {
+      entries_.push_back({entry.position, clone_value(*entry.value)});
+    }
+  }
+
+  EntityIndex(EntityIndex &&) noexcept = default;
+  EntityIndex &operator=(EntityIndex &&) noexcept = default;
+  EntityIndex(const EntityIndex &) = delete;
+  EntityIndex &operator=(const EntityIndex &) = delete;
+
+  std::size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  void reserve(std::size_t count) {
+    entries_.reserve(count);
+    if (count * 2 > slots_.size()) {
+      rehash(count * 2);
+    }
+  }
+
+  T *find(const Position &position) {
+    const std::int32_t entry = findEntry(position);
+    return entry < 0 ? nullptr : entries_[entry].value.get();
+  }
+  const T *find(const Position &position) const {
+    const std::int32_t entry = findEntry(position);
+    return entry < 0 ? nullptr : entries_[entry].value.get();
+  }
+
+  // Inserts the value, replacing any entity already at the position.
+  // Returns false (and drops the value) if the position is off the grid.
+  bool insertOrAssign(const Position &position, std::unique_ptr<T> value) {
+    if (!contains(position)) {
+      return false;
+    }
+    const std::int32_t existing = findEntry(position);
+    if (existing >= 0) {
+      entries_[existing].value = std::move(value);
+      return true;
+    }
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      rehash(std::max<std::size_t>(kMinSlots, slots_.size() * 2));
+    }
+    entries_.push_back({position, std::move(value)});
+    insertSlot(keyOf(position),
+               static_cast<std::int32_t>(entries_.size() - 1));
+    return true;
+  }
+
+  // Removes and returns the entity at the position, or nullptr if none.
+  std::unique_ptr<T> take(const Position &position) {
+    if (!contains(position) || slots_.empty()) {
+      return nullptr;
+    }
+    std::size_t slot = probeSlot(keyOf(position));
+    if (slots_[slot].entry < 0) {
+      return nullptr;
+    }
+    const std::int32_t entry = slots_[slot].entry;
+    std::unique_ptr<T> value = std::move(entries_[entry].value);
+    eraseSlot(slot);
+
+    const std::int32_t last = static_cast<std::int32_t>(entries_.size() - 1);
+    if (entry != last) {
+      entries_[entry] = std::move(entries_[last]);
+      slots_[probeSlot(keyOf(entries_[entry].position))].entry = entry;
+    }
+    entries_.pop_back();
+    return value;
+  }
+
+  bool erase(const Position &position) { return take(position) != nullptr; }
+
+  void clear() {
+    entries_.clear();
+    std::fill(slots_.begin(), slots_.end(), Slot{});
+  }
+
+  // Calls fn(const Entry &) for every entity within Chebyshev distance
+  // `radius` of center. Small windows probe tile by tile; large ones scan the
+  // dense entries instead.
+  template <typename Fn>
+  void forEachInRadius(const Position &center, int radius, Fn &&fn) const {
+    if (radius < 0 || entries_.empty()) {
+      return;
+    }
+    const std::size_t side = static_cast<std::size_t>(radius) * 2 + 1;
+    if (side * side > entries_.size()) {
+      for (const auto &entry : entries_) {
+        if (std::abs(entry.position.x - center.x) <= radius &&
+            std::abs(entry.position.y - center.y) <= radius) {
+          fn(entry);
+        }
+      }
+      return;
+    }
+    for (int y = center.y - radius; y <= center.y + radius; ++y) {
+      for (int x = center.x - radius; x <= center.x + radius; ++x) {
+        const std::int32_t entry = findEntry({x, y});
+        if (entry >= 0) {
+          fn(entries_[entry]);
+        }
+      }
+    }
+  }
+
+  std::vector<const Entry *> findInRadius(const Position &center,
+                                          int radius) const {
+    std::vector<const Entry *> result;
+    forEachInRadius(center, radius, [&result](const Entry &entry) {
+      result.push_back(&entry);
+    });
+    return result;
+  }
+
+private:
+  struct Slot {
+    std::uint32_t key = 0;
+    std::int32_t entry = -1; // -1 marks an empty slot.
+  };
+
+  static constexpr std::size_t kMinSlots = 16;
+
+  bool contains(const Position &position) const {
+    return position.x >= 0 && position.x < width_ && position.y >= 0 &&
+           position.y < height_;
+  }
+
+  std::uint32_t keyOf(const Position &position) const {
+    return static_cast<std::uint32_t>(position.y) *
+               static_cast<std::uint32_t>(width_) +
+           static_cast<std::uint32_t>(position.x);
+  }
+
+  std::size_t homeSlot(std::uint32_t key) const {
+    // Fibonacci hashing: take the top bits of the product so neighbouring
+    // tiles spread across the table. slots_.size() == 1 << (32 - shift).
+    return static_cast<std::uint32_t>(key * 2654435769u) >> slot_shift_;
+  }
+
+  // Slot holding key, or the empty slot where it would be inserted.
+  std::size_t probeSlot(std::uint32_t key) const {
+    std::size_t slot = homeSlot(key);
+    while (slots_[slot].entry >= 0 && slots_[slot].key != key) {
+      slot = (slot + 1) & (slots_.size() - 1);
+    }
+    return slot;
+  }
+
+  std::int32_t findEntry(const Position &position) const {
+    if (slots_.empty() || !contains(position)) {
+      return -1;
+    }
+    return slots_[probeSlot(keyOf(position))].entry;
+  }
+
+  void insertSlot(std::uint32_t key, std::int32_t entry) {
+    std::size_t slot = probeSlot(key);
+    slots_[slot].key = key;
+    slots_[slot].entry = entry;
+  }
+
+  // Backward-shift deletion keeps probe chains intact without tombstones.
+  void eraseSlot(std::size_t slot) {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t next = (slot + 1) & mask;
+    while (slots_[next].entry >= 0) {
+      const std::size_t home = homeSlot(slots_[next].key);
+      if (((next - home) & mask) >= ((next - slot) & mask)) {
+        slots_[slot] = slots_[next];
+        slot = next;
+      }
+      next = (next + 1) & mask;
+    }
+    slots_[slot] = Slot{};
+  }
+
+  void rehash(std::size_t min_slots) {
+    std::size_t slot_count = kMinSlots;
+    while (slot_count < min_slots) {
+      slot_count *= 2;
+    }
+    slots_.assign(slot_count, Slot{});
+    slot_shift_ = 32;
+    for (std::size_t n = slot_count; n > 1; n >>= 1) {
+      --slot_shift_;
+    }
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+      insertSlot(keyOf(entries_[i].position), static_cast<std::int32_t>(i));
+    }
+  }
+
+  int width_;
+  int height_;
+  std::vector<Entry> entries_;
+  std::vector<Slot> slots_;
+  int slot_shift_ = 32;
+};
+
+} // namespace Model
+} // namespace Domain
+} // namespace TuiRogGame
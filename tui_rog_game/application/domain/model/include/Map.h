@@ -1,31 +1,49 @@
 #pragma once
 
 #include <functional>
-#include <map>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "Enemy.h"
+#include "EntityIndex.h"
 #include "Item.h"
+#include "MapChangeSet.h"
 #include "Position.h"
+#include "Rng.h"
 #include "Tile.h"
+#include "TileGridView.h"
 
 namespace TuiRogGame {
 namespace Domain {
 namespace Model {
 
+// Tiles, enemies and items are shared between copies and only cloned when a
+// copy is about to modify them (copy-on-write), so snapshotting a Map for
+// rendering, saving or descriptions does not copy the grid or its entities.
+// A Map is not safe to mutate from one thread while another copies it, but
+// copies may be read and destroyed on any thread: a Map writes in place only
+// once it holds the last reference, and then after an acquire fence, so reads
+// through copies released on other threads happen before the write.
 class Map {
 public:
   Map(int width, int height);
 
+  // tiles is row-major and must hold exactly width * height entries.
   Map(int width, int height, Position start_player_position,
-      std::vector<std::vector<Tile>> tiles,
-      std::map<Position, std::unique_ptr<Enemy>> enemies,
-      std::map<Position, std::unique_ptr<Item>> items);
+      std::vector<Tile> tiles,
+      std::vector<std::pair<Position, std::unique_ptr<Enemy>>> enemies,
+      std::vector<std::pair<Position, std::unique_ptr<Item>>> items);
 
+  // Shares the other map's tiles and entities; O(1) apart from change sets.
   Map(const Map &other);
+  Map(Map &&other) noexcept = default;
 
+  // Output depends only on the map size and the generator's state, so a
+  // seeded Rng reproduces the same map.
+  void generate(Rng &rng);
+  // Uses the calling thread's randomly seeded generator.
   void generate();
   Position getStartPlayerPosition() const { return start_player_position_; }
 
@@ -35,22 +53,32 @@ public:
   bool isWalkable(int x, int y) const;
   bool isValidPosition(int x, int y) const;
 
-  const std::vector<std::vector<Tile>> &getTiles() const { return tiles_; }
-  const std::map<Position, std::unique_ptr<Enemy>> &getEnemies() const {
-    return enemies_;
+  TileGridView getTiles() const {
+    return TileGridView(tiles_->data(), width_, height_);
   }
-  const std::map<Position, std::unique_ptr<Item>> &getItems() const {
-    return items_;
+  const EntityIndex<Enemy> &getEnemies() const { return *enemies_; }
+  const EntityIndex<Item> &getItems() const { return *items_; }
+
+  // Entities within Chebyshev distance `radius` of center (a radius of 1 is
+  // the 3x3 block around it). Pointers are invalidated by any map mutation.
+  std::vector<const EntityIndex<Enemy>::Entry *>
+  getEnemiesInRadius(const Position &center, int radius) const {
+    return enemies_->findInRadius(center, radius);
   }
-
-  void setTiles(std::vector<std::vector<Tile>> tiles) {
-    tiles_ = std::move(tiles);
+  std::vector<const EntityIndex<Item>::Entry *>
+  getItemsInRadius(const Position &center, int radius) const {
+    return items_->findInRadius(center, radius);
   }
+
+  void setTiles(std::vector<Tile> tiles);
   void addEnemy(Position position, std::unique_ptr<Enemy> enemy);
   void addItem(Position position, std::unique_ptr<Item> item);
-  void setStartPlayerPosition(Position pos) { start_player_position_ = pos; }
+  void setStartPlayerPosition(Position pos);
   void setTile(int x, int y, Tile tile);
 
+  // The non-const lookups un-share the entities before handing out a mutable
+  // reference. Copying the map afterwards shares them again, so do not keep
+  // such a reference across a copy; look the entity up again instead.
   std::optional<std::reference_wrapper<Enemy>>
   getEnemyAt(const Position &position);
   const std::optional<std::reference_wrapper<const Enemy>>
@@ -65,13 +93,38 @@ public:
 
   std::unique_ptr<Item> takeItemAt(const Position &position);
 
+  // Change tracking for incremental saves. Enemies are mutated through
+  // references handed out by getEnemyAt, so callers report those changes via
+  // markEnemyChanged.
+  const MapChangeSet &getChanges() const { return changes_; }
+  void clearChanges() { changes_ = MapChangeSet{false}; }
+  void markFullyChanged() { changes_ = MapChangeSet{}; }
+  void markEnemyChanged(const Position &position);
+  // Prepends changes from a snapshot this map supersedes, so a save that
+  // skips that snapshot still covers everything changed since the last save.
+  void mergeEarlierChanges(const MapChangeSet &earlier);
+
 private:
+  std::size_t tileIndex(int x, int y) const {
+    return static_cast<std::size_t>(y) * width_ + x;
+  }
+  // Copy-on-write accessors: clone the shared part first if another Map
+  // still refers to it.
+  std::vector<Tile> &mutableTiles();
+  EntityIndex<Enemy> &mutableEnemies();
+  EntityIndex<Item> &mutableItems();
+
+  void recordTileChange(std::size_t index);
+  void recordItemChange(const Position &position);
+
   int width_;
   int height_;
-  std::vector<std::vector<Tile>> tiles_;
-  std::map<Position, std::unique_ptr<Enemy>> enemies_;
-  std::map<Position, std::unique_ptr<Item>> items_;
+  // Row-major, width_ * height_ entries.
+  std::shared_ptr<std::vector<Tile>> tiles_;
+  std::shared_ptr<EntityIndex<Enemy>> enemies_;
+  std::shared_ptr<EntityIndex<Item>> items_;
   Position start_player_position_;
+  MapChangeSet changes_;
 };
 
 } // namespace Model
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Position.h"
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Model {
+
+// What changed on a Map since its changes were last cleared (i.e. since the
+// last successful save). Entries may repeat; consumers dedupe as needed.
+struct MapChangeSet {
+  // The whole map must be rewritten (new or regenerated map, bulk tile set).
+  // While set, the finer-grained lists below are not maintained.
+  bool full = true;
+  bool start_position = false;
+  std::vector<std::uint32_t> tiles; // Flattened tile indices.
+  std::vector<Position> enemies;    // Added, removed or modified.
+  std::vector<Position> items;      // Added, removed or modified.
+
+  bool empty() const {
+    return !full && !start_position && tiles.empty() && enemies.empty() &&
+           items.empty();
+  }
+
+  // Folds a later change set into this one.
+  void merge(const MapChangeSet &newer) {
+    if (full || newer.full) {
+      *this = MapChangeSet{};
+      return;
+    }
+    start_position = start_position || newer.start_position;
+    tiles.insert(tiles.end(), newer.tiles.begin(), newer.tiles.end());
+    enemies.insert(enemies.end(), newer.enemies.begin(), newer.enemies.end());
+    items.insert(items.end(), newer.items.begin(), newer.items.end());
+  }
+};
+
+} // namespace Model
+} // namespace Domain
+} // namespace TuiRogGame
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "PlayerChangeSet.h"
 #include "PlayerCoreStats.h"
 #include "Position.h"
 #include "Stats.h"
@@ -35,10 +36,19 @@ public:
     return inventory_;
   }
 
-  void setLevel(int level) { level_ = level; }
-  void setXp(int xp) { xp_ = xp; }
-  void setHp(int hp) { hp_ = hp; }
-  void setPosition(Position pos) { position_ = pos; }
+  void setLevel(int level) {
+    level_ = level;
+    changes_.core_stats = true;
+  }
+  void setXp(int xp) {
+    xp_ = xp;
+    changes_.core_stats = true;
+  }
+  void setHp(int hp) {
+    hp_ = hp;
+    changes_.core_stats = true;
+  }
+  void setPosition(Position pos) { moveTo(pos); }
 
   void moveTo(Position new_position);
   bool gainXp(int amount);
@@ -48,7 +58,16 @@ public:
 
   Player(const Player &other);
 
+  // Change tracking for incremental saves.
+  const PlayerChangeSet &getChanges() const { return changes_; }
+  void clearChanges();
+  void markFullyChanged() { changes_ = PlayerChangeSet{}; }
+  // See Map::mergeEarlierChanges.
+  void mergeEarlierChanges(const PlayerChangeSet &earlier);
+
 private:
+  void markInventoryChangedFrom(std::size_t index);
+
   PlayerId id_;
   int level_ = 1;
   int xp_ = 0;
@@ -56,6 +75,7 @@ private:
   Stats stats_;
   Position position_;
   std::vector<std::unique_ptr<Item>> inventory_;
+  PlayerChangeSet changes_;
 };
 
 } // namespace Model
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Model {
+
+// What changed on a Player since its changes were last cleared (i.e. since
+// the last successful save).
+struct PlayerChangeSet {
+  static constexpr std::size_t kNoInventoryChange =
+      std::numeric_limits<std::size_t>::max();
+
+  bool full = true;
+  bool core_stats = false; // level, xp, hp
+  bool stats = false;
+  bool position = false;
+  // Inventory slots [inventory_first_dirty, current size) must be rewritten
+  // and slots [current size, inventory_high_water) removed.
+  std::size_t inventory_first_dirty = kNoInventoryChange;
+  std::size_t inventory_high_water = 0;
+
+  bool empty() const {
+    return !full && !core_stats && !stats && !position &&
+           inventory_first_dirty == kNoInventoryChange;
+  }
+
+  // Folds a later change set into this one.
+  void merge(const PlayerChangeSet &newer) {
+    if (full || newer.full) {
+      *this = PlayerChangeSet{};
+      return;
+    }
+    core_stats = core_stats || newer.core_stats;
+    stats = stats || newer.stats;
+    position = position || newer.position;
+    inventory_first_dirty =
+        std::min(inventory_first_dirty, newer.inventory_first_dirty);
+    inventory_high_water =
+        std::max(inventory_high_water, newer.inventory_high_water);
+  }
+};
+
+} // namespace Model
+} // namespace Domain
+} // namespace TuiRogGame
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Model {
+
+// Seedable xoshiro256** generator for gameplay randomness (map generation).
+// std:: distributions and std::shuffle are implementation-defined, so the
+// bounded and shuffling helpers are defined here too: a seed reproduces the
+// same output on every platform and standard library.
+class Rng {
+public:
+  using result_type = std::uint64_t;
+
+  explicit Rng(std::uint64_t seed);
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return ~result_type(0); }
+
+  result_type operator()() {
+    const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+    const std::uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  // Uniform in [0, bound); bound must be non-zero.
+  std::uint64_t nextBelow(std::uint64_t bound) {
+    // Reject the low values that would bias the modulo.
+    const std::uint64_t threshold = (0 - bound) % bound;
+    while (true) {
+      const std::uint64_t value = (*this)();
+      if (value >= threshold) {
+        return value % bound;
+      }
+    }
+  }
+
+  // Fisher-Yates shuffle.
+  template <typename RandomIt> void shuffle(RandomIt first, RandomIt last) {
+    const auto count = std::distance(first, last);
+    for (auto i = count - 1; i > 0; --i) {
+      const auto j = static_cast<decltype(i)>(
+          nextBelow(static_cast<std::uint64_t>(i) + 1));
+      using std::swap;
+      swap(first[i], first[j]);
+    }
+  }
+
+  // Seed of an independent stream derived from seed, e.g. one per map.
+  static std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t stream);
+
+  // Per-thread generator seeded once from std::random_device, for callers
+  // that do not need reproducible output.
+  static Rng &threadLocal();
+
+private:
+  static std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  std::uint64_t state_[4];
+};
+
+} // namespace Model
+} // namespace Domain
+} // namespace TuiRogGame
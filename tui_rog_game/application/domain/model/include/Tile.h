@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstdint>
+
 namespace TuiRogGame {
 namespace Domain {
 namespace Model {
 
-enum class Tile { WALL, FLOOR, EXIT, ENEMY, ITEM };
+// One byte per tile so a whole grid can be copied and persisted as raw bytes.
+enum class Tile : std::uint8_t { WALL, FLOOR, EXIT, ENEMY, ITEM };
 
 } // namespace Model
 } // namespace Domain
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Tile.h"
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Model {
+
+// Non-owning, read-only view over a row-major tile grid.
+// Valid only as long as the owning Map is alive and not modified.
+class TileGridView {
+public:
+  TileGridView(const Tile *data, int width, int height)
+      : data_(data), width_(width), height_(height) {}
+
+  int getWidth() const { return width_; }
+  int getHeight() const { return height_; }
+  std::size_t size() const {
+    return static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
+  }
+
+  const Tile *data() const { return data_; }
+  const Tile *begin() const { return data_; }
+  const Tile *end() const { return data_ + size(); }
+
+  // Pointer to the first tile of row y; the row has getWidth() tiles.
+  const Tile *row(int y) const {
+    return data_ + static_cast<std::size_t>(y) * width_;
+  }
+  Tile at(int x, int y) const { return row(y)[x]; }
+
+private:
+  const Tile *data_;
+  int width_;
+  int height_;
+};
+
+} // namespace Model
+} // namespace Domain
+} // namespace TuiRogGame
@@ -1,56 +1,93 @@
 #include "Map.h"
 #include "Goblin.h"
+#include "Log.h"
 #include "Orc.h"
 #include <algorithm>
-#include <random>
-#include <set>
-#include <spdlog/spdlog.h>
+#include <atomic>
 #include <stdexcept>
 
 namespace TuiRogGame {
 namespace Domain {
 namespace Model {
 
-Map::Map(int width, int height) : width_(width), height_(height) {
+namespace {
+
+// Whether this Map holds the only reference to shared, and so may write to
+// it in place. use_count() is a relaxed load; the acquire fence pairs it with
+// the release decrement by the thread that dropped the last other reference,
+// so everything that thread read from the data happens before our writes.
+template <typename T> bool soleOwner(const std::shared_ptr<T> &shared) {
+  if (shared.use_count() > 1) {
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return true;
+}
+
+} // namespace
+
+Map::Map(int width, int height)
+    : width_(width), height_(height),
+      enemies_(std::make_shared<EntityIndex<Enemy>>(width, height)),
+      items_(std::make_shared<EntityIndex<Item>>(width, height)) {
   if (width <= 0 || height <= 0) {
     throw std::invalid_argument("Map dimensions must be positive.");
   }
-  tiles_.resize(height, std::vector<Tile>(width, Tile::WALL));
+  tiles_ = std::make_shared<std::vector<Tile>>(
+      static_cast<std::size_t>(width) * height, Tile::WALL);
 }
 
 Map::Map(int width, int height, Position start_player_position,
-         std::vector<std::vector<Tile>> tiles,
-         std::map<Position, std::unique_ptr<Enemy>> enemies,
-         std::map<Position, std::unique_ptr<Item>> items)
-    : width_(width), height_(height), tiles_(std::move(tiles)),
-      enemies_(std::move(enemies)), items_(std::move(items)),
+         std::vector<Tile> tiles,
+         std::vector<std::pair<Position, std::unique_ptr<Enemy>>> enemies,
+         std::vector<std::pair<Position, std::unique_ptr<Item>>> items)
+    : width_(width), height_(height),
+      tiles_(std::make_shared<std::vector<Tile>>(std::move(tiles))),
+      enemies_(std::make_shared<EntityIndex<Enemy>>(width, height)),
+      items_(std::make_shared<EntityIndex<Item>>(width, height)),
       start_player_position_(start_player_position) {
   if (width_ <= 0 || height_ <= 0) {
     throw std::invalid_argument("Map dimensions must be positive.");
   }
-}
+  if (tiles_->size() != static_cast<std::size_t>(width_) * height_) {
+    throw std::invalid_argument("Map tile count does not match dimensions.");
+  }
 
-Map::Map(const Map &other)
-    : width_(other.width_), height_(other.height_), tiles_(other.tiles_),
-      start_player_position_(other.start_player_position_) {
-  for (const auto &pair : other.enemies_) {
-    enemies_.emplace(pair.first, pair.second->clone());
+  enemies_->reserve(enemies.size());
+  for (auto &pair : enemies) {
+    if (!enemies_->insertOrAssign(pair.first, std::move(pair.second))) {
+      TRG_LOG_WARN("Map: Dropping enemy outside the map at ({}, {}).",
+                   pair.first.x, pair.first.y);
+    }
   }
-  for (const auto &pair : other.items_) {
-    items_.emplace(pair.first, std::make_unique<Item>(*pair.second));
+  items_->reserve(items.size());
+  for (auto &pair : items) {
+    if (!items_->insertOrAssign(pair.first, std::move(pair.second))) {
+      TRG_LOG_WARN("Map: Dropping item outside the map at ({}, {}).",
+                   pair.first.x, pair.first.y);
+    }
   }
 }
 
-void Map::generate() {
-  enemies_.clear();
-  items_.clear();
+Map::Map(const Map &other)
+    : width_(other.width_), height_(other.height_), tiles_(other.tiles_),
+      enemies_(other.enemies_), items_(other.items_),
+      start_player_position_(other.start_player_position_),
+      changes_(other.changes_) {}
+
+void Map::generate() { generate(Rng::threadLocal()); }
+
+void Map::generate(Rng &rng) {
+  // Start from fresh storage rather than un-sharing parts that are about to
+  // be overwritten anyway.
+  enemies_ = std::make_shared<EntityIndex<Enemy>>(width_, height_);
+  items_ = std::make_shared<EntityIndex<Item>>(width_, height_);
+  markFullyChanged();
 
   // Initialize all tiles to WALL
-  for (int y = 0; y < height_; ++y) {
-    for (int x = 0; x < width_; ++x) {
-      tiles_[y][x] = Tile::WALL;
-    }
-  }
+  tiles_ = std::make_shared<std::vector<Tile>>(
+      static_cast<std::size_t>(width_) * height_, Tile::WALL);
+  std::vector<Tile> &tiles = *tiles_;
 
   // Random walk parameters
   int max_walk_length =
@@ -58,17 +95,13 @@ void Map::generate() {
   int current_x = width_ / 2;
   int current_y = height_ / 2;
 
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> distrib(
-      0, 3); // 0: up, 1: down, 2: left, 3: right
-
   for (int i = 0; i < max_walk_length; ++i) {
     if (isValidPosition(current_x, current_y)) {
-      tiles_[current_y][current_x] = Tile::FLOOR;
+      tiles[tileIndex(current_x, current_y)] = Tile::FLOOR;
     }
 
-    int direction = distrib(gen);
+    // 0: up, 1: down, 2: left, 3: right
+    int direction = static_cast<int>(rng.nextBelow(4));
     switch (direction) {
     case 0: // Up
       current_y--;
@@ -89,59 +122,60 @@ void Map::generate() {
     current_y = std::max(1, std::min(current_y, height_ - 2));
   }
 
-  // Collect all floor positions after random walk
-  std::vector<Position> floor_positions;
-  for (int y = 0; y < height_; ++y) {
-    for (int x = 0; x < width_; ++x) {
-      if (tiles_[y][x] == Tile::FLOOR) {
-        floor_positions.push_back({x, y});
-      }
+  // Keep only the largest connected floor region. Components are flood
+  // filled in row-major order of their first tile; each one lands as a
+  // contiguous run of tile indices in `order`, so the largest is just a
+  // (begin, size) pair and no per-tile allocation is needed.
+  const std::size_t tile_count = tiles.size();
+  std::vector<bool> visited(tile_count, false);
+  std::vector<std::size_t> order;
+  std::size_t largest_begin = 0;
+  std::size_t largest_size = 0;
+
+  for (std::size_t start = 0; start < tile_count; ++start) {
+    if (tiles[start] != Tile::FLOOR || visited[start]) {
+      continue;
     }
-  }
-
-  if (!floor_positions.empty()) {
-    std::vector<Position> all_floor_tiles = floor_positions;
-    std::set<Position> visited;
-    std::vector<Position> largest_component;
-
-    for (const auto &start_pos : all_floor_tiles) {
-      if (visited.find(start_pos) == visited.end()) {
-        std::vector<Position> q;
-        q.push_back(start_pos);
-        visited.insert(start_pos);
-
-        int head = 0;
-        while (head < q.size()) {
-          Position pos = q[head++];
-
-          Position neighbors[] = {{pos.x + 1, pos.y},
-                                  {pos.x - 1, pos.y},
-                                  {pos.x, pos.y + 1},
-                                  {pos.x, pos.y - 1}};
-          for (const auto &neighbor : neighbors) {
-            if (isValidPosition(neighbor.x, neighbor.y) &&
-                tiles_[neighbor.y][neighbor.x] == Tile::FLOOR &&
-                visited.find(neighbor) == visited.end()) {
-              visited.insert(neighbor);
-              q.push_back(neighbor);
-            }
-          }
+    const std::size_t begin = order.size();
+    order.push_back(start);
+    visited[start] = true;
+
+    for (std::size_t head = begin; head < order.size(); ++head) {
+      const std::size_t index = order[head];
+      const int x = static_cast<int>(index % width_);
+      const int y = static_cast<int>(index / width_);
+      auto visit = [&](bool in_bounds, std::size_t neighbor) {
+        if (in_bounds && tiles[neighbor] == Tile::FLOOR &&
+            !visited[neighbor]) {
+          visited[neighbor] = true;
+          order.push_back(neighbor);
         }
+      };
+      const std::size_t width = static_cast<std::size_t>(width_);
+      visit(x + 1 < width_, index + 1);
+      visit(x > 0, index - 1);
+      visit(y + 1 < height_, index + width);
+      visit(y > 0, index - width);
+    }
 
-        if (q.size() > largest_component.size()) {
-          largest_component = q;
-        }
-      }
+    if (order.size() - begin > largest_size) {
+      largest_begin = begin;
+      largest_size = order.size() - begin;
     }
+  }
 
-    std::set<Position> largest_set(largest_component.begin(),
-                                   largest_component.end());
-    for (const auto &pos : all_floor_tiles) {
-      if (largest_set.find(pos) == largest_set.end()) {
-        tiles_[pos.y][pos.x] = Tile::WALL;
-      }
+  const std::size_t largest_end = largest_begin + largest_size;
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    if (i < largest_begin || i >= largest_end) {
+      tiles[order[i]] = Tile::WALL;
     }
-    floor_positions = largest_component;
+  }
+
+  std::vector<Position> floor_positions;
+  floor_positions.reserve(largest_size);
+  for (std::size_t i = largest_begin; i < largest_end; ++i) {
+    floor_positions.push_back({static_cast<int>(order[i] % width_),
+                               static_cast<int>(order[i] / width_)});
   }
 
   if (floor_positions.empty()) {
@@ -152,24 +186,24 @@ void Map::generate() {
     for (int y = center_y - 1; y <= center_y + 1; ++y) {
       for (int x = center_x - 1; x <= center_x + 1; ++x) {
         if (isValidPosition(x, y)) {
-          tiles_[y][x] = Tile::FLOOR;
+          tiles[tileIndex(x, y)] = Tile::FLOOR;
           floor_positions.push_back({x, y});
         }
       }
     }
 
     if (floor_positions.empty()) {
-      spdlog::error("Map is too small to generate any floor tiles.");
+      TRG_LOG_ERROR("Map is too small to generate any floor tiles.");
       return;
     }
   }
 
   // Shuffle floor positions for random placement of entities
-  std::shuffle(floor_positions.begin(), floor_positions.end(), gen);
+  rng.shuffle(floor_positions.begin(), floor_positions.end());
 
   // Place player, enemies, items, and exit
   if (floor_positions.size() < 2) {
-    spdlog::warn("Not enough floor tiles for both player and exit. They might "
+    TRG_LOG_WARN("Not enough floor tiles for both player and exit. They might "
                  "share a position.");
   }
 
@@ -181,11 +215,12 @@ void Map::generate() {
   if (!floor_positions.empty()) {
     Position exit_pos = floor_positions.back();
     floor_positions.pop_back();
-    tiles_[exit_pos.y][exit_pos.x] = Tile::EXIT;
+    tiles[tileIndex(exit_pos.x, exit_pos.y)] = Tile::EXIT;
   } else {
     // If only one floor tile, player and exit share it
-    tiles_[start_player_position_.y][start_player_position_.x] = Tile::EXIT;
-    spdlog::warn("Only one floor tile generated. Player and Exit share the "
+    tiles[tileIndex(start_player_position_.x, start_player_position_.y)] =
+        Tile::EXIT;
+    TRG_LOG_WARN("Only one floor tile generated. Player and Exit share the "
                  "same position.");
   }
 
@@ -194,7 +229,7 @@ void Map::generate() {
     Position orc_pos = floor_positions.back();
     floor_positions.pop_back();
     auto orc = std::make_unique<Orc>(orc_pos);
-    spdlog::debug("Map::generate: Placing Orc at ({}, {}).", orc_pos.x,
+    TRG_LOG_DEBUG("Map::generate: Placing Orc at ({}, {}).", orc_pos.x,
                   orc_pos.y);
     addEnemy(orc_pos, std::move(orc));
   }
@@ -203,7 +238,7 @@ void Map::generate() {
     Position goblin_pos = floor_positions.back();
     floor_positions.pop_back();
     auto goblin = std::make_unique<Goblin>(goblin_pos);
-    spdlog::debug("Map::generate: Placing Goblin at ({}, {}).", goblin_pos.x,
+    TRG_LOG_DEBUG("Map::generate: Placing Goblin at ({}, {}).", goblin_pos.x,
                   goblin_pos.y);
     addEnemy(goblin_pos, std::move(goblin));
   }
@@ -220,7 +255,7 @@ Tile Map::getTile(int x, int y) const {
   if (x < 0 || x >= width_ || y < 0 || y >= height_) {
     return Tile::WALL;
   }
-  return tiles_[y][x];
+  return (*tiles_)[tileIndex(x, y)];
 }
 
 bool Map::isWalkable(int x, int y) const {
@@ -233,19 +268,21 @@ bool Map::isValidPosition(int x, int y) const {
 }
 
 void Map::addEnemy(Position position, std::unique_ptr<Enemy> enemy) {
-  spdlog::debug("Map::addEnemy: Attempting to add enemy at ({}, {}).",
+  TRG_LOG_DEBUG("Map::addEnemy: Attempting to add enemy at ({}, {}).",
                 position.x, position.y);
   Tile tile_at_pos = getTile(position.x, position.y);
-  spdlog::debug("Map::addEnemy: Tile at ({}, {}) is {}.", position.x,
+  TRG_LOG_DEBUG("Map::addEnemy: Tile at ({}, {}) is {}.", position.x,
                 position.y, static_cast<int>(tile_at_pos));
   if (tile_at_pos == Tile::FLOOR) {
-    enemies_[position] = std::move(enemy);
-    tiles_[position.y][position.x] = Tile::ENEMY;
-    spdlog::debug("Map::addEnemy: Successfully added enemy at ({}, {}). Tile "
+    mutableEnemies().insertOrAssign(position, std::move(enemy));
+    mutableTiles()[tileIndex(position.x, position.y)] = Tile::ENEMY;
+    recordTileChange(tileIndex(position.x, position.y));
+    markEnemyChanged(position);
+    TRG_LOG_DEBUG("Map::addEnemy: Successfully added enemy at ({}, {}). Tile "
                   "set to ENEMY.",
                   position.x, position.y);
   } else {
-    spdlog::warn(
+    TRG_LOG_WARN(
         "Map::addEnemy: Failed to add enemy at ({}, {}). Tile is not FLOOR.",
         position.x, position.y);
   }
@@ -253,79 +290,146 @@ void Map::addEnemy(Position position, std::unique_ptr<Enemy> enemy) {
 
 void Map::addItem(Position position, std::unique_ptr<Item> item) {
   if (getTile(position.x, position.y) == Tile::FLOOR) {
-    items_[position] = std::move(item);
-    tiles_[position.y][position.x] = Tile::ITEM;
+    mutableItems().insertOrAssign(position, std::move(item));
+    mutableTiles()[tileIndex(position.x, position.y)] = Tile::ITEM;
+    recordTileChange(tileIndex(position.x, position.y));
+    recordItemChange(position);
   }
 }
 
 std::optional<std::reference_wrapper<Enemy>>
 Map::getEnemyAt(const Position &position) {
-  spdlog::debug("Map::getEnemyAt: Searching for enemy at ({}, {}).", position.x,
+  TRG_LOG_DEBUG("Map::getEnemyAt: Searching for enemy at ({}, {}).", position.x,
                 position.y);
-  auto it = enemies_.find(position);
-  if (it != enemies_.end()) {
-    spdlog::debug("Map::getEnemyAt: Enemy found at ({}, {}): {}.", position.x,
-                  position.y, it->second->getName());
-    return std::ref(*it->second);
+  if (enemies_->find(position) != nullptr) {
+    Enemy *enemy = mutableEnemies().find(position);
+    TRG_LOG_DEBUG("Map::getEnemyAt: Enemy found at ({}, {}): {}.", position.x,
+                  position.y, enemy->getName());
+    return std::ref(*enemy);
   }
-  spdlog::debug("Map::getEnemyAt: No enemy found at ({}, {}).", position.x,
+  TRG_LOG_DEBUG("Map::getEnemyAt: No enemy found at ({}, {}).", position.x,
                 position.y);
   return std::nullopt;
 }
 
 const std::optional<std::reference_wrapper<const Enemy>>
 Map::getEnemyAt(const Position &position) const {
-  spdlog::debug("Map::getEnemyAt (const): Searching for enemy at ({}, {}).",
+  TRG_LOG_DEBUG("Map::getEnemyAt (const): Searching for enemy at ({}, {}).",
                 position.x, position.y);
-  auto it = enemies_.find(position);
-  if (it != enemies_.end()) {
-    spdlog::debug("Map::getEnemyAt (const): Enemy found at ({}, {}): {}.",
-                  position.x, position.y, it->second->getName());
-    return std::cref(*it->second);
+  if (const Enemy *enemy = enemies_->find(position)) {
+    TRG_LOG_DEBUG("Map::getEnemyAt (const): Enemy found at ({}, {}): {}.",
+                  position.x, position.y, enemy->getName());
+    return std::cref(*enemy);
   }
-  spdlog::debug("Map::getEnemyAt (const): No enemy found at ({}, {}).",
+  TRG_LOG_DEBUG("Map::getEnemyAt (const): No enemy found at ({}, {}).",
                 position.x, position.y);
   return std::nullopt;
 }
 
 void Map::removeEnemyAt(const Position &position) {
-  if (enemies_.erase(position) > 0) {
-    tiles_[position.y][position.x] = Tile::FLOOR;
+  if (enemies_->find(position) != nullptr) {
+    mutableEnemies().erase(position);
+    mutableTiles()[tileIndex(position.x, position.y)] = Tile::FLOOR;
+    recordTileChange(tileIndex(position.x, position.y));
+    markEnemyChanged(position);
   }
 }
 
 std::optional<std::reference_wrapper<Item>>
 Map::getItemAt(const Position &position) {
-  auto it = items_.find(position);
-  if (it != items_.end()) {
-    return std::ref(*it->second);
+  if (items_->find(position) != nullptr) {
+    return std::ref(*mutableItems().find(position));
   }
   return std::nullopt;
 }
 
 const std::optional<std::reference_wrapper<const Item>>
 Map::getItemAt(const Position &position) const {
-  auto it = items_.find(position);
-  if (it != items_.end()) {
-    return std::cref(*it->second);
+  if (const Item *item = items_->find(position)) {
+    return std::cref(*item);
   }
   return std::nullopt;
 }
 
 std::unique_ptr<Item> Map::takeItemAt(const Position &position) {
-  auto it = items_.find(position);
-  if (it != items_.end()) {
-    std::unique_ptr<Item> item = std::move(it->second);
-    items_.erase(it);
-    tiles_[position.y][position.x] = Tile::FLOOR;
-    return item;
-  }
-  return nullptr;
+  if (items_->find(position) == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<Item> item = mutableItems().take(position);
+  if (item) {
+    mutableTiles()[tileIndex(position.x, position.y)] = Tile::FLOOR;
+    recordTileChange(tileIndex(position.x, position.y));
+    recordItemChange(position);
+  }
+  return item;
+}
+
+void Map::setTiles(std::vector<Tile> tiles) {
+  if (tiles.size() != static_cast<std::size_t>(width_) * height_) {
+    TRG_LOG_ERROR("Map::setTiles: Expected {} tiles, got {}. Ignoring.",
+                  static_cast<std::size_t>(width_) * height_, tiles.size());
+    return;
+  }
+  tiles_ = std::make_shared<std::vector<Tile>>(std::move(tiles));
+  markFullyChanged();
 }
 
 void Map::setTile(int x, int y, Tile tile) {
   if (isValidPosition(x, y)) {
-    tiles_[y][x] = tile;
+    mutableTiles()[tileIndex(x, y)] = tile;
+    recordTileChange(tileIndex(x, y));
+  }
+}
+
+void Map::setStartPlayerPosition(Position pos) {
+  start_player_position_ = pos;
+  changes_.start_position = true;
+}
+
+void Map::markEnemyChanged(const Position &position) {
+  if (!changes_.full) {
+    changes_.enemies.push_back(position);
+  }
+}
+
+void Map::mergeEarlierChanges(const MapChangeSet &earlier) {
+  MapChangeSet merged = earlier;
+  merged.merge(changes_);
+  changes_ = std::move(merged);
+}
+
+std::vector<Tile> &Map::mutableTiles() {
+  if (!soleOwner(tiles_)) {
+    tiles_ = std::make_shared<std::vector<Tile>>(*tiles_);
+  }
+  return *tiles_;
+}
+
+EntityIndex<Enemy> &Map::mutableEnemies() {
+  if (!soleOwner(enemies_)) {
+    enemies_ = std::make_shared<EntityIndex<Enemy>>(
+        *enemies_, [](const Enemy &enemy) { return enemy.clone(); });
+  }
+  return *enemies_;
+}
+
+EntityIndex<Item> &Map::mutableItems() {
+  if (!soleOwner(items_)) {
+    items_ = std::make_shared<EntityIndex<Item>>(
+        *items_, [](const Item &item) { return std::make_unique<Item>(item); });
+  }
+  return *items_;
+}
+
+void Map::recordTileChange(std::size_t index) {
+  if (!changes_.full) {
+    changes_.tiles.push_back(static_cast<std::uint32_t>(index));
+  }
+}
+
+void Map::recordItemChange(const Position &position) {
+  if (!changes_.full) {
+    changes_.items.push_back(position);
   }
 }
 
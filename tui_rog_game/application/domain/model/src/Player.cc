@@ -1,4 +1,5 @@
 #include "Player.h"
+#include <algorithm>
 #include <memory>
 
 namespace TuiRogGame {
@@ -23,7 +24,8 @@ Player::Player(PlayerId id, PlayerCoreStats core_stats, Stats stats,
 
 Player::Player(const Player &other)
     : id_(other.id_), level_(other.level_), xp_(other.xp_), hp_(other.hp_),
-      stats_(other.stats_), position_(other.position_) {
+      stats_(other.stats_), position_(other.position_),
+      changes_(other.changes_) {
   for (const auto &item_ptr : other.inventory_) {
     inventory_.push_back(std::make_unique<Item>(*item_ptr));
   }
@@ -33,10 +35,14 @@ int Player::getMaxHp() const { return calculateMaxHp(stats_); }
 
 int Player::getAttackPower() const { return 5 + (stats_.strength * 2); }
 
-void Player::moveTo(Position new_position) { position_ = new_position; }
+void Player::moveTo(Position new_position) {
+  position_ = new_position;
+  changes_.position = true;
+}
 
 bool Player::gainXp(int amount) {
   xp_ += amount;
+  changes_.core_stats = true;
 
   bool leveled_up = false;
 
@@ -50,6 +56,7 @@ bool Player::gainXp(int amount) {
     stats_.vitality++;
 
     hp_ = getMaxHp();
+    changes_.stats = true;
 
     leveled_up = true;
   }
@@ -61,10 +68,12 @@ void Player::takeDamage(int amount) {
   if (hp_ < 0) {
     hp_ = 0;
   }
+  changes_.core_stats = true;
 }
 
 void Player::addItem(std::unique_ptr<Item> item) {
   inventory_.push_back(std::move(item));
+  markInventoryChangedFrom(inventory_.size() - 1);
 }
 
 bool Player::useItem(const std::string &item_name) {
@@ -73,8 +82,12 @@ bool Player::useItem(const std::string &item_name) {
 
       if ((*it)->getType() == Item::ItemType::HealthPotion) {
         hp_ = std::min(hp_ + 20, getMaxHp());
+        changes_.core_stats = true;
       }
 
+      // Later items shift down a slot, so everything from here is dirty.
+      markInventoryChangedFrom(
+          static_cast<std::size_t>(it - inventory_.begin()));
       inventory_.erase(it);
       return true;
     }
@@ -82,6 +95,27 @@ bool Player::useItem(const std::string &item_name) {
   return false;
 }
 
+void Player::clearChanges() {
+  changes_ = PlayerChangeSet{false};
+  changes_.inventory_high_water = inventory_.size();
+}
+
+void Player::mergeEarlierChanges(const PlayerChangeSet &earlier) {
+  PlayerChangeSet merged = earlier;
+  merged.merge(changes_);
+  changes_ = merged;
+}
+
+void Player::markInventoryChangedFrom(std::size_t index) {
+  if (changes_.full) {
+    return;
+  }
+  changes_.inventory_first_dirty =
+      std::min(changes_.inventory_first_dirty, index);
+  changes_.inventory_high_water =
+      std::max(changes_.inventory_high_water, inventory_.size());
+}
+
 } // namespace Model
 } // namespace Domain
 } // namespace TuiRogGame
@@ -0,0 +1,41 @@
+#include "Rng.h"
+#include <random>
+
+namespace TuiRogGame {
+namespace Domain {
+namespace Model {
+
+namespace {
+
+// splitmix64 step; spreads seeds so that nearby seeds give unrelated states.
+std::uint64_t splitMix64(std::uint64_t &x) {
+  std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+} // namespace
+
+Rng::Rng(std::uint64_t seed) {
+  for (auto &word : state_) {
+    word = splitMix64(seed);
+  }
+}
+
+std::uint64_t Rng::deriveSeed(std::uint64_t seed, std::uint64_t stream) {
+  std::uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull);
+  return splitMix64(x);
+}
+
+Rng &Rng::threadLocal() {
+  thread_local Rng rng([] {
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+  }());
+  return rng;
+}
+
+} // namespace Model
+} // namespace Domain
+} // namespace TuiRogGame
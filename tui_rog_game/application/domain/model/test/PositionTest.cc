@@ -1,8 +1,14 @@
 #include "Position.h"
 #include "Map.h"
 #include "Orc.h"
+#include "Player.h"
+#include "Rng.h"
 #include "gtest/gtest.h"
+#include <cstdint>
 #include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 using namespace TuiRogGame::Domain::Model;
 
@@ -59,9 +65,16 @@ TEST(PositionTest, MapKeyBehavior) {
 
 TEST(MapTest, EnemyManagement) {
   Map map(10, 10);
-  map.generate();
+  Rng rng(1);
+  map.generate(rng);
 
-  Position newEnemyPos = {1, 1};
+  // First plain floor tile in row-major order.
+  Position newEnemyPos = {-1, -1};
+  for (int i = 0; i < 100 && newEnemyPos.x < 0; ++i) {
+    if (map.getTile(i % 10, i / 10) == Tile::FLOOR) {
+      newEnemyPos = {i % 10, i / 10};
+    }
+  }
 
   ASSERT_EQ(map.getTile(newEnemyPos.x, newEnemyPos.y), Tile::FLOOR);
 
@@ -80,3 +93,178 @@ TEST(MapTest, EnemyManagement) {
   auto nonExistentEnemy = map.getEnemyAt(otherPos);
   ASSERT_FALSE(nonExistentEnemy.has_value());
 }
+
+TEST(MapTest, FlatTileGrid) {
+  std::vector<Tile> tiles(4 * 3, Tile::FLOOR);
+  tiles[1 * 4 + 2] = Tile::EXIT; // (2, 1)
+
+  Map map(4, 3, {0, 0}, tiles, {}, {});
+  ASSERT_EQ(map.getTile(2, 1), Tile::EXIT);
+
+  TileGridView view = map.getTiles();
+  ASSERT_EQ(view.size(), tiles.size());
+  ASSERT_EQ(view.row(1)[2], Tile::EXIT);
+  ASSERT_EQ(view.at(3, 2), Tile::FLOOR);
+
+  Map copy(map);
+  copy.setTile(2, 1, Tile::WALL);
+  ASSERT_EQ(map.getTile(2, 1), Tile::EXIT);
+  ASSERT_EQ(copy.getTile(2, 1), Tile::WALL);
+
+  ASSERT_THROW(Map(4, 4, {0, 0}, tiles, {}, {}), std::invalid_argument);
+}
+
+TEST(MapTest, EntityIndexMatchesOrderedMap) {
+  EntityIndex<int> index(32, 32);
+  std::map<Position, int> reference;
+
+  // Deterministic insert/remove mix exercising probing and swap-removal.
+  unsigned int state = 12345;
+  for (int i = 0; i < 5000; ++i) {
+    state = state * 1103515245u + 12345u;
+    Position pos = {static_cast<int>((state >> 8) % 32),
+                    static_cast<int>((state >> 16) % 32)};
+    if ((state >> 4) % 3 == 0) {
+      auto taken = index.take(pos);
+      ASSERT_EQ(taken != nullptr, reference.erase(pos) > 0);
+    } else {
+      index.insertOrAssign(pos, std::make_unique<int>(i));
+      reference[pos] = i;
+    }
+  }
+
+  ASSERT_EQ(index.size(), reference.size());
+  for (const auto &pair : reference) {
+    const int *value = index.find(pair.first);
+    ASSERT_NE(value, nullptr);
+    ASSERT_EQ(*value, pair.second);
+  }
+  ASSERT_EQ(index.find({-1, 0}), nullptr);
+  ASSERT_EQ(index.find({32, 0}), nullptr);
+}
+
+TEST(MapTest, EntitiesInRadius) {
+  Map map(10, 10, {0, 0}, std::vector<Tile>(100, Tile::FLOOR), {}, {});
+  map.addEnemy({4, 4}, std::make_unique<Orc>(Position{4, 4}));
+  map.addEnemy({6, 5}, std::make_unique<Orc>(Position{6, 5}));
+  map.addEnemy({9, 9}, std::make_unique<Orc>(Position{9, 9}));
+
+  ASSERT_EQ(map.getEnemiesInRadius({5, 5}, 1).size(), 2u);
+  ASSERT_EQ(map.getEnemiesInRadius({5, 5}, 0).size(), 0u);
+  ASSERT_EQ(map.getEnemiesInRadius({5, 5}, 4).size(), 3u);
+
+  map.removeEnemyAt({4, 4});
+  auto nearby = map.getEnemiesInRadius({5, 5}, 1);
+  ASSERT_EQ(nearby.size(), 1u);
+  ASSERT_EQ(nearby[0]->position, (Position{6, 5}));
+  ASSERT_EQ(map.getTile(4, 4), Tile::FLOOR);
+}
+
+TEST(MapTest, ChangeTracking) {
+  Map map(10, 10, {0, 0}, std::vector<Tile>(100, Tile::FLOOR), {}, {});
+  ASSERT_TRUE(map.getChanges().full);
+
+  map.clearChanges();
+  ASSERT_TRUE(map.getChanges().empty());
+
+  map.setTile(3, 2, Tile::WALL);
+  map.addEnemy({4, 4}, std::make_unique<Orc>(Position{4, 4}));
+  const MapChangeSet &changes = map.getChanges();
+  ASSERT_FALSE(changes.full);
+  ASSERT_EQ(changes.tiles.size(), 2u);
+  ASSERT_EQ(changes.tiles[0], 2u * 10u + 3u);
+  ASSERT_EQ(changes.enemies.size(), 1u);
+
+  Map copy(map);
+  ASSERT_EQ(copy.getChanges().tiles.size(), 2u);
+
+  map.generate();
+  ASSERT_TRUE(map.getChanges().full);
+  ASSERT_TRUE(map.getChanges().tiles.empty());
+}
+
+TEST(MapTest, CopiesShareUntilModified) {
+  Map map(10, 10, {0, 0}, std::vector<Tile>(100, Tile::FLOOR), {}, {});
+  map.addEnemy({4, 4}, std::make_unique<Orc>(Position{4, 4}));
+
+  const Map snapshot(map);
+  ASSERT_EQ(snapshot.getTiles().data(), map.getTiles().data());
+  ASSERT_EQ(&snapshot.getEnemies(), &map.getEnemies());
+
+  map.setTile(1, 1, Tile::WALL);
+  ASSERT_NE(snapshot.getTiles().data(), map.getTiles().data());
+  ASSERT_EQ(snapshot.getTile(1, 1), Tile::FLOOR);
+  ASSERT_EQ(&snapshot.getEnemies(), &map.getEnemies());
+
+  const int health = snapshot.getEnemyAt({4, 4})->get().getHealth();
+  map.getEnemyAt({4, 4})->get().takeDamage(1);
+  ASSERT_EQ(snapshot.getEnemyAt({4, 4})->get().getHealth(), health);
+  ASSERT_LT(map.getEnemyAt({4, 4})->get().getHealth(), health);
+}
+
+namespace {
+// FNV-1a over everything generate() decides.
+std::uint64_t mapFingerprint(const Map &map) {
+  std::uint64_t hash = 1469598103934665603ull;
+  auto mix = [&hash](std::uint64_t value) {
+    hash ^= value;
+    hash *= 1099511628211ull;
+  };
+  for (Tile tile : map.getTiles()) {
+    mix(static_cast<std::uint64_t>(tile));
+  }
+  mix(static_cast<std::uint64_t>(map.getStartPlayerPosition().x));
+  mix(static_cast<std::uint64_t>(map.getStartPlayerPosition().y));
+  std::map<Position, std::string> entities;
+  for (const auto &entry : map.getEnemies()) {
+    entities[entry.position] = entry.value->getName();
+  }
+  for (const auto &entry : map.getItems()) {
+    entities[entry.position] = entry.value->getName();
+  }
+  for (const auto &entity : entities) {
+    mix(static_cast<std::uint64_t>(entity.first.x));
+    mix(static_cast<std::uint64_t>(entity.first.y));
+    for (char c : entity.second) {
+      mix(static_cast<unsigned char>(c));
+    }
+  }
+  return hash;
+}
+} // namespace
+
+TEST(MapTest, GenerateIsReproducible) {
+  Map first(40, 20);
+  Map second(40, 20);
+  Rng first_rng(Rng::deriveSeed(1234, 0));
+  Rng second_rng(Rng::deriveSeed(1234, 0));
+  first.generate(first_rng);
+  second.generate(second_rng);
+  ASSERT_EQ(mapFingerprint(first), mapFingerprint(second));
+  // Pinned: changes meant only to speed up generation must keep this value.
+  ASSERT_EQ(mapFingerprint(first), 0x1e366e961b9d6e24ull);
+
+  Map other(40, 20);
+  Rng other_rng(Rng::deriveSeed(1234, 1));
+  other.generate(other_rng);
+  ASSERT_NE(mapFingerprint(first), mapFingerprint(other));
+}
+
+TEST(PlayerTest, InventoryChangeTracking) {
+  Player player("p", Stats{}, {1, 1});
+  player.addItem(
+      std::make_unique<Item>(Item::ItemType::HealthPotion, "Potion A"));
+  player.addItem(
+      std::make_unique<Item>(Item::ItemType::HealthPotion, "Potion B"));
+  player.clearChanges();
+  ASSERT_TRUE(player.getChanges().empty());
+
+  ASSERT_TRUE(player.useItem("Potion A"));
+  const PlayerChangeSet &changes = player.getChanges();
+  ASSERT_EQ(changes.inventory_first_dirty, 0u);
+  ASSERT_EQ(changes.inventory_high_water, 2u);
+  ASSERT_FALSE(changes.position);
+
+  player.moveTo({2, 1});
+  ASSERT_TRUE(player.getChanges().position);
+}
@@ -2,6 +2,7 @@
 
 #include "DescriptionGeneratedEvent.h" // Added for DescriptionGeneratedEvent
 #include "DomainEvent.h"
+#include "EventBuffer.h"
 #include "IGenerateDescriptionPort.h"
 #include "IGetPlayerActionUseCase.h"
 #include "ILoadGameStatePort.h"
@@ -9,12 +10,21 @@
 #include "ISaveGameStatePort.h"
 #include "Map.h"
 #include "Player.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
 namespace TuiRogGame {
+namespace Common {
+class ThreadPool;
+} // namespace Common
+
 namespace Domain {
 namespace Service {
 
@@ -25,18 +35,35 @@ public:
              std::unique_ptr<Port::Out::IGenerateDescriptionPort>
                  primary_description_port,
              std::unique_ptr<Port::Out::IGenerateDescriptionPort>
-                 alternative_description_port);
+                 alternative_description_port,
+             std::shared_ptr<Common::ThreadPool> description_pool = nullptr,
+             std::optional<std::uint64_t> seed = std::nullopt);
+  ~GameEngine() override;
 
   void setRenderPort(Port::Out::IRenderPort *render_port);
   void
   handlePlayerAction(const Port::In::PlayerActionCommand &command) override;
 
+  // Blocks until every description requested so far has been generated (or
+  // dropped as stale) and delivered to the render port.
+  void waitForDescriptions();
+
+  // Seed the maps of this game derive from; random unless one was given.
+  std::uint64_t getSeed() const { return seed_; }
+
 private:
-  std::vector<std::unique_ptr<Domain::Event::DomainEvent>> initializeGame();
-  std::vector<std::unique_ptr<Domain::Event::DomainEvent>>
-  processPlayerMove(int dx, int dy);
-  void processEvents(
-      const std::vector<std::unique_ptr<Domain::Event::DomainEvent>> &events);
+  // Both add the turn's events to turn_->events.
+  void initializeGame();
+  void processPlayerMove(int dx, int dy);
+  // Renders the turn's events over game_state, the state at the end of the
+  // turn (nullptr when nothing needs it).
+  void processEvents(Domain::Event::EventSpan events,
+                     const Port::Out::GameStateDTO *game_state);
+  // The enemy at current_enemy_, or nullptr (leaving combat) if it is gone.
+  Model::Enemy *currentEnemy();
+  // Generates map_ from the next per-map sub-seed, so the n-th map of a game
+  // depends only on the game seed and n.
+  void generateMap();
 
   bool is_running_ = false;
   std::shared_ptr<Port::Out::ISaveGameStatePort> save_port_;
@@ -46,19 +73,69 @@ private:
   std::unique_ptr<Port::Out::IGenerateDescriptionPort>
       alternative_description_port_;
   bool use_alternative_description_port_ = false;
-  Port::Out::IRenderPort *render_port_ = nullptr;
+  std::atomic<Port::Out::IRenderPort *> render_port_{nullptr};
 
   std::unique_ptr<Model::Player> player_;
   std::unique_ptr<Model::Map> map_;
-  std::optional<std::reference_wrapper<Model::Enemy>> current_enemy_;
+  // Position of the enemy being fought. Kept as a position rather than a
+  // reference because map snapshots may un-share (and move) its enemies.
+  std::optional<Model::Position> current_enemy_;
+  std::uint64_t seed_;
+  std::uint64_t generated_map_count_ = 0;
 
 public:
   void toggleDescriptionPort();
 
 private:
-  std::unique_ptr<Domain::Event::DescriptionGeneratedEvent>
-  createDescriptionEvent(const Port::Out::GameStateDTO &game_state,
-                         const Domain::Event::DomainEvent &event);
+  struct DescriptionRequest {
+    const Domain::Event::DomainEvent *event;
+    const Port::Out::GameStateDTO *game_state;
+  };
+
+  // The events of one turn and what the description worker needs of them.
+  // The worker reads a dispatched turn in place, so a turn's events are
+  // neither copied nor cloned; the record is reused once the worker is done.
+  struct TurnRecord {
+    Domain::Event::EventBuffer events;
+    // The events to describe, in the order they happened.
+    std::vector<DescriptionRequest> requests;
+    // The states the requests were made in; a new one is only taken when
+    // the state changed since the last request.
+    std::vector<std::shared_ptr<const Port::Out::GameStateDTO>> snapshots;
+    Port::Out::IGenerateDescriptionPort *port = nullptr;
+    std::uint64_t turn_id = 0;
+    std::uint64_t first_sequence_id = 0;
+    bool in_use = false; // Guarded by description_tasks_mutex_.
+  };
+
+  Port::Out::IGenerateDescriptionPort *activeDescriptionPort() const;
+  // A record no turn is using, marked in use until the turn is done with it.
+  TurnRecord &acquireTurnRecord();
+  void releaseTurnRecord(TurnRecord &record);
+  void requestDescription(const Domain::Event::DomainEvent &event);
+  // Hands the turn's record to the worker, or releases it if there is
+  // nothing to describe.
+  void dispatchDescriptionRequests();
+  // Called after every change to map_ or player_, so the next description
+  // request takes a new snapshot.
+  void stateChanged() { state_changed_ = true; }
+  void generateDescriptions(TurnRecord &record);
+  void finishDescriptionTask();
+
+  std::shared_ptr<Common::ThreadPool> description_pool_;
+  // Two records let the worker describe one turn while the next is played;
+  // more are only added while the worker falls behind.
+  std::vector<std::unique_ptr<TurnRecord>> turn_records_;
+  // Record of the turn being handled.
+  TurnRecord *turn_ = nullptr;
+  bool state_changed_ = true;
+  std::uint64_t next_description_sequence_id_ = 1;
+  std::atomic<std::uint64_t> current_turn_id_{0};
+  std::atomic<bool> descriptions_cancelled_{false};
+  std::mutex description_port_mutex_;
+  std::mutex description_tasks_mutex_;
+  std::condition_variable description_tasks_done_;
+  std::size_t pending_description_tasks_ = 0;
 };
 
 } // namespace Service
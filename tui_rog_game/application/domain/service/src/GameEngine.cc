@@ -6,13 +6,15 @@
 #include "GameLoadedEvent.h"
 #include "ItemFoundEvent.h"
 #include "ItemUsedEvent.h"
+#include "Log.h"
 #include "MapChangedEvent.h"
 #include "PlayerAttackedEvent.h"
 #include "PlayerDiedEvent.h"
 #include "PlayerLeveledUpEvent.h"
 #include "PlayerMovedEvent.h"
+#include "ThreadPool.h"
 #include <iostream>
-#include <spdlog/spdlog.h>
+#include <utility>
 
 namespace TuiRogGame {
 namespace Domain {
@@ -24,11 +26,32 @@ GameEngine::GameEngine(
     std::unique_ptr<TuiRogGame::Port::Out::IGenerateDescriptionPort>
         primary_description_port,
     std::unique_ptr<TuiRogGame::Port::Out::IGenerateDescriptionPort>
-        alternative_description_port)
+        alternative_description_port,
+    std::shared_ptr<Common::ThreadPool> description_pool,
+    std::optional<std::uint64_t> seed)
     : save_port_(std::move(save_port)), load_port_(std::move(load_port)),
       primary_description_port_(std::move(primary_description_port)),
-      alternative_description_port_(std::move(alternative_description_port)) {
-  spdlog::info("GameEngine initialized.");
+      alternative_description_port_(std::move(alternative_description_port)),
+      seed_(seed ? *seed : Model::Rng::threadLocal()()),
+      description_pool_(std::move(description_pool)) {
+  if (!description_pool_ &&
+      (primary_description_port_ || alternative_description_port_)) {
+    // A single worker keeps descriptions in request order and never calls a
+    // description port from two threads at once. Engines without description
+    // ports (e.g. server sessions) do not need a thread at all.
+    description_pool_ = std::make_shared<Common::ThreadPool>(1);
+  }
+  for (int i = 0; i < 2; ++i) {
+    turn_records_.push_back(std::make_unique<TurnRecord>());
+  }
+  TRG_LOG_INFO("GameEngine initialized with seed {}.", seed_);
+}
+
+GameEngine::~GameEngine() {
+  // Queued tasks bail out early once cancelled; wait for the one that may be
+  // in flight, since it still uses the description ports owned by this engine.
+  descriptions_cancelled_ = true;
+  waitForDescriptions();
 }
 
 void GameEngine::setRenderPort(
@@ -36,72 +59,64 @@ void GameEngine::setRenderPort(
   render_port_ = render_port;
 }
 
-std::vector<std::unique_ptr<TuiRogGame::Domain::Event::DomainEvent>>
-GameEngine::initializeGame() {
-  std::vector<std::unique_ptr<Domain::Event::DomainEvent>> events;
-
+void GameEngine::initializeGame() {
   if (load_port_) {
     auto loaded_game_state = load_port_->loadGameState();
     if (loaded_game_state) {
 
       map_ = std::make_unique<Model::Map>(loaded_game_state->map);
       player_ = std::make_unique<Model::Player>(loaded_game_state->player);
-      events.push_back(std::make_unique<Domain::Event::GameLoadedEvent>());
-      if (auto desc_event = createDescriptionEvent(
-              Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-        events.push_back(std::move(desc_event));
-      }
+      requestDescription(
+          turn_->events.emplace<Domain::Event::GameLoadedEvent>());
 
-      spdlog::info("Game loaded. Player: {} at ({}, {})", player_->getName(),
+      TRG_LOG_INFO("Game loaded. Player: {} at ({}, {})", player_->getName(),
                    player_->getPosition().x, player_->getPosition().y);
-      return events;
+      return;
     }
   }
 
   map_ = std::make_unique<Model::Map>(20, 10);
-  map_->generate();
+  generateMap();
 
   player_ = std::make_unique<Model::Player>("player1", Model::Stats{},
                                             map_->getStartPlayerPosition());
-  spdlog::info("New game initialized. Player: {} at ({}, {})",
+  TRG_LOG_INFO("New game initialized. Player: {} at ({}, {})",
                player_->getName(), player_->getPosition().x,
                player_->getPosition().y);
 
-  events.push_back(std::make_unique<Domain::Event::PlayerMovedEvent>(
+  requestDescription(turn_->events.emplace<Domain::Event::PlayerMovedEvent>(
       player_->getPosition()));
-  if (auto desc_event = createDescriptionEvent(
-          Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-    events.push_back(std::move(desc_event));
-  }
-  return events;
 }
 
 void GameEngine::handlePlayerAction(
     const TuiRogGame::Port::In::PlayerActionCommand &command) {
-  spdlog::info("GameEngine: Handling player action type: {}",
-               static_cast<int>(command.type));
-  std::vector<std::unique_ptr<Domain::Event::DomainEvent>> events;
+  TRG_LOG_DEBUG("GameEngine: Handling player action type: {}",
+                static_cast<int>(command.type));
+  // Starting a new turn makes every description still pending for an earlier
+  // turn stale.
+  ++current_turn_id_;
+  turn_ = &acquireTurnRecord();
 
   switch (command.type) {
   case TuiRogGame::Port::In::PlayerActionCommand::INITIALIZE:
-    events = initializeGame();
+    initializeGame();
     break;
   case TuiRogGame::Port::In::PlayerActionCommand::MOVE_UP:
-    events = processPlayerMove(0, -1);
+    processPlayerMove(0, -1);
     break;
   case TuiRogGame::Port::In::PlayerActionCommand::MOVE_DOWN:
-    events = processPlayerMove(0, 1);
+    processPlayerMove(0, 1);
     break;
   case TuiRogGame::Port::In::PlayerActionCommand::MOVE_LEFT:
-    events = processPlayerMove(-1, 0);
+    processPlayerMove(-1, 0);
     break;
   case TuiRogGame::Port::In::PlayerActionCommand::MOVE_RIGHT:
-    events = processPlayerMove(1, 0);
+    processPlayerMove(1, 0);
     break;
   case TuiRogGame::Port::In::PlayerActionCommand::ATTACK: {
-    spdlog::debug("GameEngine: Player initiated attack command.");
-    if (!current_enemy_) { // If not already in combat
-      spdlog::debug(
+    TRG_LOG_DEBUG("GameEngine: Player initiated attack command.");
+    if (!currentEnemy()) { // If not already in combat
+      TRG_LOG_DEBUG(
           "GameEngine: Not in combat, checking for adjacent enemies.");
 
       Model::Position player_pos = player_->getPosition();
@@ -114,28 +129,21 @@ void GameEngine::handlePlayerAction(
 
       bool enemy_found = false;
       for (const auto &adj_pos : adjacent_positions) {
-        spdlog::debug("GameEngine: Checking adjacent position ({}, {}).",
+        TRG_LOG_DEBUG("GameEngine: Checking adjacent position ({}, {}).",
                       adj_pos.x, adj_pos.y);
         if (map_->isValidPosition(adj_pos.x, adj_pos.y)) {
-          if (auto enemy_opt = map_->getEnemyAt(adj_pos)) {
-            current_enemy_ = std::ref(enemy_opt->get());
-            spdlog::debug("GameEngine: Enemy found at ({}, {}): {}. Setting "
+          if (auto enemy_opt = std::as_const(*map_).getEnemyAt(adj_pos)) {
+            const Model::Enemy &enemy = enemy_opt->get();
+            current_enemy_ = adj_pos;
+            TRG_LOG_DEBUG("GameEngine: Enemy found at ({}, {}): {}. Setting "
                           "current_enemy_.",
-                          adj_pos.x, adj_pos.y,
-                          current_enemy_->get().getName());
-            events.push_back(
-                std::make_unique<Domain::Event::CombatStartedEvent>(
-                    current_enemy_->get().getTypeName(),
-                    current_enemy_->get().getName(),
-                    current_enemy_->get().getHealth(),
-                    current_enemy_->get().getStats().strength,
-                    current_enemy_->get().getStats().vitality));
-            if (auto desc_event = createDescriptionEvent(
-                    Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-              events.push_back(std::move(desc_event));
-            }
-            spdlog::info("Combat started with adjacent enemy {} at ({}, {}).",
-                         current_enemy_->get().getName(), adj_pos.x, adj_pos.y);
+                          adj_pos.x, adj_pos.y, enemy.getName());
+            requestDescription(
+                turn_->events.emplace<Domain::Event::CombatStartedEvent>(
+                    enemy.getTypeName(), enemy.getName(), enemy.getHealth(),
+                    enemy.getStats().strength, enemy.getStats().vitality));
+            TRG_LOG_INFO("Combat started with adjacent enemy {} at ({}, {}).",
+                         enemy.getName(), adj_pos.x, adj_pos.y);
             enemy_found = true;
             break; // Found an enemy, start combat
           }
@@ -143,267 +151,411 @@ void GameEngine::handlePlayerAction(
       }
 
       if (!enemy_found) {
-        spdlog::warn("Player tried to attack but no adjacent enemy found.");
+        TRG_LOG_WARN("Player tried to attack but no adjacent enemy found.");
 
         break; // Exit ATTACK case
       }
     } else {
-      spdlog::debug(
+      TRG_LOG_DEBUG(
           "GameEngine: Already in combat with {}. Proceeding with attack.",
-          current_enemy_->get().getName());
+          currentEnemy()->getName());
     }
 
+    // Fetched once mutably: the description snapshots below share the map's
+    // enemies, so the enemy must not be modified through this reference after
+    // the first requestDescription.
+    Model::Enemy &enemy = *currentEnemy();
+    const std::string enemy_name = enemy.getName();
     int player_damage = player_->getAttackPower();
-    spdlog::debug("GameEngine: Player attacking {} for {} damage.",
-                  current_enemy_->get().getName(), player_damage);
-    current_enemy_->get().takeDamage(player_damage);
-    events.push_back(std::make_unique<Domain::Event::PlayerAttackedEvent>(
-        player_damage, current_enemy_->get().getName(),
-        current_enemy_->get().getHealth()));
-    if (auto desc_event = createDescriptionEvent(
-            Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-      events.push_back(std::move(desc_event));
-    }
-    spdlog::info("Player attacked {} for {} damage. {}'s health: {}",
-                 current_enemy_->get().getName(), player_damage,
-                 current_enemy_->get().getName(),
-                 current_enemy_->get().getHealth());
-
-    if (current_enemy_->get().getHealth() <= 0) {
-      spdlog::debug("GameEngine: Enemy {} defeated.",
-                    current_enemy_->get().getName());
+    TRG_LOG_DEBUG("GameEngine: Player attacking {} for {} damage.", enemy_name,
+                  player_damage);
+    enemy.takeDamage(player_damage);
+    const int enemy_health = enemy.getHealth();
+    const int enemy_attack_power = enemy.getAttackPower();
+    map_->markEnemyChanged(*current_enemy_);
+    stateChanged();
+    requestDescription(
+        turn_->events.emplace<Domain::Event::PlayerAttackedEvent>(
+            player_damage, enemy_name, enemy_health));
+    TRG_LOG_INFO("Player attacked {} for {} damage. {}'s health: {}",
+                 enemy_name, player_damage, enemy_name, enemy_health);
+
+    if (enemy_health <= 0) {
+      TRG_LOG_DEBUG("GameEngine: Enemy {} defeated.", enemy_name);
 
       int xp_gained = 50; // Example XP
       bool leveled_up = player_->gainXp(xp_gained);
-      events.push_back(std::make_unique<Domain::Event::EnemyDefeatedEvent>(
-          current_enemy_->get().getName(), xp_gained));
-      if (auto desc_event = createDescriptionEvent(
-              Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-        events.push_back(std::move(desc_event));
-      }
-      spdlog::info("{} defeated! Player gained {} XP.",
-                   current_enemy_->get().getName(), xp_gained);
+      stateChanged();
+      requestDescription(
+          turn_->events.emplace<Domain::Event::EnemyDefeatedEvent>(enemy_name,
+                                                                  xp_gained));
+      TRG_LOG_INFO("{} defeated! Player gained {} XP.", enemy_name, xp_gained);
 
       if (leveled_up) {
-        events.push_back(std::make_unique<Domain::Event::PlayerLeveledUpEvent>(
-            player_->getLevel(), player_->getStats()));
-        if (auto desc_event = createDescriptionEvent(
-                Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-          events.push_back(std::move(desc_event));
-        }
-        spdlog::info("Player leveled up to level {}!", player_->getLevel());
+        requestDescription(
+            turn_->events.emplace<Domain::Event::PlayerLeveledUpEvent>(
+                player_->getLevel(), player_->getStats()));
+        TRG_LOG_INFO("Player leveled up to level {}!", player_->getLevel());
       }
 
-      map_->removeEnemyAt(current_enemy_->get().getPosition());
+      map_->removeEnemyAt(*current_enemy_);
+      stateChanged();
       current_enemy_.reset(); // Clear current enemy
     } else {
-      spdlog::debug("GameEngine: Enemy {} still alive. Health: {}. Enemy "
+      TRG_LOG_DEBUG("GameEngine: Enemy {} still alive. Health: {}. Enemy "
                     "attacking player.",
-                    current_enemy_->get().getName(),
-                    current_enemy_->get().getHealth());
+                    enemy_name, enemy_health);
 
-      int enemy_damage = current_enemy_->get().getAttackPower();
+      int enemy_damage = enemy_attack_power;
       player_->takeDamage(enemy_damage);
-      events.push_back(std::make_unique<Domain::Event::EnemyAttackedEvent>(
-          current_enemy_->get().getName(), enemy_damage, player_->getHp()));
-      if (auto desc_event = createDescriptionEvent(
-              Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-        events.push_back(std::move(desc_event));
-      }
-      spdlog::info("{} attacked player for {} damage. Player's health: {}",
-                   current_enemy_->get().getName(), enemy_damage,
-                   player_->getHp());
+      stateChanged();
+      requestDescription(
+          turn_->events.emplace<Domain::Event::EnemyAttackedEvent>(
+              enemy_name, enemy_damage, player_->getHp()));
+      TRG_LOG_INFO("{} attacked player for {} damage. Player's health: {}",
+                   enemy_name, enemy_damage, player_->getHp());
 
       if (player_->getHp() <= 0) {
-        spdlog::debug("GameEngine: Player defeated, but will be resurrected.");
+        TRG_LOG_DEBUG("GameEngine: Player defeated, but will be resurrected.");
 
-        events.push_back(std::make_unique<Domain::Event::PlayerDiedEvent>());
+        const auto &died_event =
+            turn_->events.emplace<Domain::Event::PlayerDiedEvent>();
         player_->setHp(player_->getMaxHp());
+        stateChanged();
 
-        if (auto desc_event = createDescriptionEvent(
-                Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-          events.push_back(std::move(desc_event));
-        }
+        requestDescription(died_event);
 
-        spdlog::info("Player defeated, but resurrected!");
+        TRG_LOG_INFO("Player defeated, but resurrected!");
       }
     }
     break;
   }
   case TuiRogGame::Port::In::PlayerActionCommand::INTERACT:
 
-    spdlog::info("Player interacted.");
+    TRG_LOG_INFO("Player interacted.");
     break;
   case TuiRogGame::Port::In::PlayerActionCommand::USE_ITEM: {
-    spdlog::info("Player initiated use item.");
+    TRG_LOG_INFO("Player initiated use item.");
     if (std::holds_alternative<std::string>(command.payload)) {
       const std::string &item_name = std::get<std::string>(command.payload);
       if (player_->useItem(item_name)) {
-        events.push_back(
-            std::make_unique<Domain::Event::ItemUsedEvent>(item_name));
-        if (auto desc_event = createDescriptionEvent(
-                Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-          events.push_back(std::move(desc_event));
-        }
-        spdlog::info("Player used item: {}", item_name);
+        stateChanged();
+        requestDescription(
+            turn_->events.emplace<Domain::Event::ItemUsedEvent>(item_name));
+        TRG_LOG_INFO("Player used item: {}", item_name);
       } else {
-        spdlog::warn("Player tried to use item '{}' but it was not found or "
+        TRG_LOG_WARN("Player tried to use item '{}' but it was not found or "
                      "could not be used.",
                      item_name);
       }
     } else {
-      spdlog::error("USE_ITEM command received without a string payload.");
+      TRG_LOG_ERROR("USE_ITEM command received without a string payload.");
     }
     break;
   }
   case TuiRogGame::Port::In::PlayerActionCommand::QUIT:
     is_running_ = false;
-    spdlog::info("Game quit by player.");
+    TRG_LOG_INFO("Game quit by player.");
     break;
   case TuiRogGame::Port::In::PlayerActionCommand::UNKNOWN:
   default:
-    spdlog::warn("Unknown player action received.");
+    TRG_LOG_WARN("Unknown player action received.");
     break;
   }
 
-  processEvents(events);
+  // Rendering and saving reuse the turn's last snapshot if nothing changed
+  // since; the copy is kept alive here since the worker may release it.
+  std::shared_ptr<const Port::Out::GameStateDTO> snapshot;
+  std::optional<Port::Out::GameStateDTO> local_state;
+  if (!state_changed_ && !turn_->snapshots.empty()) {
+    snapshot = turn_->snapshots.back();
+  } else if (render_port_.load() || save_port_) {
+    local_state.emplace(*map_, *player_);
+  }
+  const Port::Out::GameStateDTO *game_state =
+      snapshot ? snapshot.get() : local_state ? &*local_state : nullptr;
+
+  processEvents(turn_->events.view(), game_state);
+  dispatchDescriptionRequests();
 
   if (save_port_) {
-    Port::Out::GameStateDTO game_state_to_save(*map_, *player_);
-    save_port_->saveGameState(game_state_to_save);
-    spdlog::info("Game auto-saved.");
+    save_port_->saveGameState(*game_state);
+    TRG_LOG_DEBUG("Game auto-saved.");
+    if (command.type == TuiRogGame::Port::In::PlayerActionCommand::QUIT) {
+      // Saves may be written behind; make sure the last one lands on quit.
+      save_port_->flush();
+    }
+  }
+  // Change sets cover one save interval; clear them even without a save port
+  // so they do not grow without bound.
+  if (map_ && player_) {
+    map_->clearChanges();
+    player_->clearChanges();
   }
 }
 
-std::vector<std::unique_ptr<TuiRogGame::Domain::Event::DomainEvent>>
-GameEngine::processPlayerMove(int dx, int dy) {
-  spdlog::info("GameEngine: Entering processPlayerMove(dx={}, dy={}).", dx, dy);
+void GameEngine::processPlayerMove(int dx, int dy) {
+  TRG_LOG_DEBUG("GameEngine: Entering processPlayerMove(dx={}, dy={}).", dx,
+                dy);
   Model::Position current_pos = player_->getPosition();
   Model::Position new_pos = {current_pos.x + dx, current_pos.y + dy};
 
   if (!map_->isWalkable(new_pos.x, new_pos.y)) {
-    spdlog::info("GameEngine: Player move blocked to ({}, {}). Wall detected.",
+    TRG_LOG_INFO("GameEngine: Player move blocked to ({}, {}). Wall detected.",
                  new_pos.x, new_pos.y);
-    return {}; // Return no events, player does not move
+    return; // No events, player does not move
   }
 
-  spdlog::info(
+  TRG_LOG_DEBUG(
       "GameEngine: Player current position ({}, {}), new position ({}, {}).",
       current_pos.x, current_pos.y, new_pos.x, new_pos.y);
   player_->moveTo(new_pos);
-  spdlog::info("GameEngine: Player moved to new position ({}, {}).", new_pos.x,
-               new_pos.y);
+  stateChanged();
+  TRG_LOG_DEBUG("GameEngine: Player moved to new position ({}, {}).", new_pos.x,
+                new_pos.y);
 
-  std::vector<std::unique_ptr<Domain::Event::DomainEvent>> events;
-  events.push_back(std::make_unique<Domain::Event::PlayerMovedEvent>(new_pos));
-  spdlog::info("GameEngine: PlayerMovedEvent created.");
+  const auto &moved_event =
+      turn_->events.emplace<Domain::Event::PlayerMovedEvent>(new_pos);
+  TRG_LOG_DEBUG("GameEngine: PlayerMovedEvent created.");
 
-  if (auto desc_event = createDescriptionEvent(
-          Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-    events.push_back(std::move(desc_event));
-  }
+  requestDescription(moved_event);
 
-  if (auto enemy_opt = map_->getEnemyAt(new_pos)) {
-    current_enemy_ = std::ref(enemy_opt->get()); // Store the enemy for combat
-    spdlog::debug("GameEngine: Enemy encountered at ({}, {}): {}. Setting "
+  if (auto enemy_opt = std::as_const(*map_).getEnemyAt(new_pos)) {
+    const Model::Enemy &enemy = enemy_opt->get();
+    current_enemy_ = new_pos; // Store the enemy for combat
+    TRG_LOG_DEBUG("GameEngine: Enemy encountered at ({}, {}): {}. Setting "
                   "current_enemy_.",
-                  new_pos.x, new_pos.y, current_enemy_->get().getName());
-    events.push_back(std::make_unique<Domain::Event::CombatStartedEvent>(
-        current_enemy_->get().getTypeName(), current_enemy_->get().getName(),
-        current_enemy_->get().getHealth(),
-        current_enemy_->get().getStats().strength,
-        current_enemy_->get().getStats().vitality));
-    if (auto desc_event = createDescriptionEvent(
-            Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-      events.push_back(std::move(desc_event));
-    }
-    spdlog::info(
+                  new_pos.x, new_pos.y, enemy.getName());
+    requestDescription(turn_->events.emplace<Domain::Event::CombatStartedEvent>(
+        enemy.getTypeName(), enemy.getName(), enemy.getHealth(),
+        enemy.getStats().strength, enemy.getStats().vitality));
+    TRG_LOG_INFO(
         "GameEngine: CombatStartedEvent created with enemy {} at ({}, {}).",
-        current_enemy_->get().getName(), new_pos.x, new_pos.y);
-  } else if (auto item_opt = map_->getItemAt(new_pos)) {
+        enemy.getName(), new_pos.x, new_pos.y);
+  } else if (std::as_const(*map_).getItemAt(new_pos)) {
 
     auto item_unique_ptr = map_->takeItemAt(new_pos);
+    stateChanged();
     if (item_unique_ptr) {
-      events.push_back(std::make_unique<Domain::Event::ItemFoundEvent>(
+      requestDescription(turn_->events.emplace<Domain::Event::ItemFoundEvent>(
           static_cast<Domain::Event::ItemFoundEvent::ItemType>(
               item_unique_ptr->getType()),
           item_unique_ptr->getName(), ""));
-      if (auto desc_event = createDescriptionEvent(
-              Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-        events.push_back(std::move(desc_event));
-      }
       player_->addItem(
           std::move(item_unique_ptr)); // Add item to player inventory
-      spdlog::info("GameEngine: ItemFoundEvent created with item at ({}, {}).",
+      stateChanged();
+      TRG_LOG_INFO("GameEngine: ItemFoundEvent created with item at ({}, {}).",
                    new_pos.x, new_pos.y);
     }
   } else if (map_->getTile(new_pos.x, new_pos.y) == Model::Tile::EXIT) {
 
-    map_->generate();
+    generateMap();
+    current_enemy_.reset();
 
     player_->moveTo(map_->getStartPlayerPosition());
+    stateChanged();
 
-    events.push_back(std::make_unique<Domain::Event::MapChangedEvent>());
-    if (auto desc_event = createDescriptionEvent(
-            Port::Out::GameStateDTO(*map_, *player_), *events.back())) {
-      events.push_back(std::move(desc_event));
-    }
-    events.push_back(std::make_unique<Domain::Event::PlayerMovedEvent>(
-        player_->getPosition()));
-    spdlog::info("GameEngine: Player reached exit. New map generated.");
+    requestDescription(turn_->events.emplace<Domain::Event::MapChangedEvent>());
+    turn_->events.emplace<Domain::Event::PlayerMovedEvent>(
+        player_->getPosition());
+    TRG_LOG_INFO("GameEngine: Player reached exit. New map generated.");
   }
-
-  return events;
 }
 
-void GameEngine::processEvents(
-    const std::vector<std::unique_ptr<Domain::Event::DomainEvent>> &events) {
-  spdlog::info("GameEngine: Entering processEvents. Event count: {}",
-               events.size());
+void GameEngine::processEvents(Domain::Event::EventSpan events,
+                               const Port::Out::GameStateDTO *game_state) {
+  TRG_LOG_DEBUG("GameEngine: Entering processEvents. Event count: {}",
+                events.size());
 
-  if (render_port_) {
-
-    Port::Out::GameStateDTO game_state_dto{*map_, *player_};
-    render_port_->render(game_state_dto, events);
+  auto *render_port = render_port_.load();
+  if (render_port && game_state) {
+    render_port->render(*game_state, events);
   }
 
   if (events.empty()) {
-    spdlog::info("GameEngine: No new events to process.");
+    TRG_LOG_DEBUG("GameEngine: No new events to process.");
   } else {
     for (const auto &event : events) {
-      spdlog::info("GameEngine: Processing event: {}", event->toString());
+      TRG_LOG_DEBUG("GameEngine: Processing event: {}", event->toString());
     }
   }
 
-  spdlog::info("GameEngine: Exiting processEvents.");
+  TRG_LOG_DEBUG("GameEngine: Exiting processEvents.");
+}
+
+Model::Enemy *GameEngine::currentEnemy() {
+  if (!current_enemy_) {
+    return nullptr;
+  }
+  if (auto enemy_opt = map_->getEnemyAt(*current_enemy_)) {
+    return &enemy_opt->get();
+  }
+  // The enemy is gone (e.g. the map was replaced); leave combat.
+  current_enemy_.reset();
+  return nullptr;
+}
+
+void GameEngine::generateMap() {
+  const std::uint64_t map_seed =
+      Model::Rng::deriveSeed(seed_, generated_map_count_++);
+  Model::Rng rng(map_seed);
+  map_->generate(rng);
+  TRG_LOG_DEBUG("GameEngine: Generated map {} from seed {}.",
+                generated_map_count_, map_seed);
 }
 
 void GameEngine::toggleDescriptionPort() {
   use_alternative_description_port_ = !use_alternative_description_port_;
-  spdlog::info("Description port toggled. Using {} description port.",
+  TRG_LOG_INFO("Description port toggled. Using {} description port.",
                use_alternative_description_port_ ? "alternative" : "primary");
 }
 
-std::unique_ptr<TuiRogGame::Domain::Event::DescriptionGeneratedEvent>
-GameEngine::createDescriptionEvent(const Port::Out::GameStateDTO &game_state,
-                                   const Domain::Event::DomainEvent &event) {
-  Port::Out::IGenerateDescriptionPort *active_description_port = nullptr;
+TuiRogGame::Port::Out::IGenerateDescriptionPort *
+GameEngine::activeDescriptionPort() const {
   if (use_alternative_description_port_ && alternative_description_port_) {
-    active_description_port = alternative_description_port_.get();
-  } else if (primary_description_port_) {
-    active_description_port = primary_description_port_.get();
+    return alternative_description_port_.get();
   }
+  return primary_description_port_.get();
+}
 
-  if (active_description_port) {
-    std::string generated_description =
-        active_description_port->generateDescription(game_state, event);
-    if (!generated_description.empty()) {
-      return std::make_unique<Domain::Event::DescriptionGeneratedEvent>(
-          generated_description);
+GameEngine::TurnRecord &GameEngine::acquireTurnRecord() {
+  TurnRecord *record = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(description_tasks_mutex_);
+    for (auto &candidate : turn_records_) {
+      if (!candidate->in_use) {
+        record = candidate.get();
+        break;
+      }
     }
+    if (!record) {
+      // Both are still queued or being described; input does not wait on
+      // the description port.
+      turn_records_.push_back(std::make_unique<TurnRecord>());
+      record = turn_records_.back().get();
+      TRG_LOG_DEBUG("GameEngine: Added turn record {}.", turn_records_.size());
+    }
+    record->in_use = true;
   }
-  return nullptr;
+  record->events.clear();
+  record->requests.clear();
+  return *record;
+}
+
+void GameEngine::releaseTurnRecord(TurnRecord &record) {
+  // Snapshots share the map's storage; holding on to them would make the
+  // next change to the map copy that storage.
+  record.snapshots.clear();
+  std::lock_guard<std::mutex> lock(description_tasks_mutex_);
+  record.in_use = false;
+}
+
+void GameEngine::requestDescription(const Domain::Event::DomainEvent &event) {
+  if (!activeDescriptionPort()) {
+    return; // Nobody to describe it; skip the snapshot.
+  }
+  // The description reflects the state at the time the event happened. The
+  // event itself stays in the turn's buffer, which the worker reads in place.
+  if (state_changed_ || turn_->snapshots.empty()) {
+    turn_->snapshots.push_back(
+        std::make_shared<const Port::Out::GameStateDTO>(*map_, *player_));
+    state_changed_ = false;
+  }
+  turn_->requests.push_back({&event, turn_->snapshots.back().get()});
+}
+
+void GameEngine::dispatchDescriptionRequests() {
+  TurnRecord &record = *std::exchange(turn_, nullptr);
+  Port::Out::IGenerateDescriptionPort *port = activeDescriptionPort();
+  if (record.requests.empty() || !port) {
+    releaseTurnRecord(record);
+    return;
+  }
+
+  record.port = port;
+  record.turn_id = current_turn_id_;
+  record.first_sequence_id = next_description_sequence_id_;
+  next_description_sequence_id_ += record.requests.size();
+  TRG_LOG_DEBUG("GameEngine: Queued {} description request(s) for turn {}.",
+                record.requests.size(), record.turn_id);
+
+  {
+    std::lock_guard<std::mutex> lock(description_tasks_mutex_);
+    ++pending_description_tasks_;
+  }
+  // From here on the record belongs to the worker until it releases it.
+  description_pool_->submit([this, &record] {
+    generateDescriptions(record);
+    releaseTurnRecord(record);
+    finishDescriptionTask();
+  });
+}
+
+void GameEngine::generateDescriptions(TurnRecord &record) {
+  // Description ports are not required to be thread-safe; a shared pool may
+  // run tasks of consecutive turns concurrently.
+  std::lock_guard<std::mutex> port_lock(description_port_mutex_);
+
+  const std::uint64_t turn_id = record.turn_id;
+  const std::uint64_t first_sequence_id = record.first_sequence_id;
+  const std::size_t count = record.requests.size();
+  if (descriptions_cancelled_ || turn_id != current_turn_id_) {
+    TRG_LOG_DEBUG("GameEngine: Dropping {} stale description request(s) of "
+                  "turn {}.",
+                  count, turn_id);
+    return;
+  }
+
+  // The whole turn goes to the port at once, so ports that batch answer it
+  // with a single round trip.
+  std::vector<Port::Out::DescriptionSubject> subjects;
+  subjects.reserve(count);
+  for (const auto &request : record.requests) {
+    subjects.push_back({*request.game_state, *request.event});
+  }
+  // Ports that stream show text as it arrives; the final descriptions below
+  // complete or replace it.
+  auto on_chunk = [&](std::size_t index, const std::string &chunk) {
+    if (index >= count || turn_id != current_turn_id_) {
+      return;
+    }
+    if (auto *render_port = render_port_.load()) {
+      render_port->renderDescription(Domain::Event::DescriptionGeneratedEvent(
+          chunk, turn_id, first_sequence_id + index, true));
+    }
+  };
+  std::vector<std::string> generated_descriptions =
+      record.port->streamDescriptions(subjects, on_chunk);
+  if (generated_descriptions.size() != count) {
+    TRG_LOG_WARN("GameEngine: Expected {} descriptions for turn {}, got {}.",
+                 count, turn_id, generated_descriptions.size());
+    generated_descriptions.resize(count);
+  }
+
+  for (std::size_t i = 0; i < generated_descriptions.size(); ++i) {
+    if (generated_descriptions[i].empty() || turn_id != current_turn_id_) {
+      continue;
+    }
+    if (auto *render_port = render_port_.load()) {
+      render_port->renderDescription(Domain::Event::DescriptionGeneratedEvent(
+          generated_descriptions[i], turn_id, first_sequence_id + i));
+    }
+  }
+}
+
+void GameEngine::finishDescriptionTask() {
+  std::lock_guard<std::mutex> lock(description_tasks_mutex_);
+  if (--pending_description_tasks_ == 0) {
+    description_tasks_done_.notify_all();
+  }
+}
+
+void GameEngine::waitForDescriptions() {
+  std::unique_lock<std::mutex> lock(description_tasks_mutex_);
+  description_tasks_done_.wait(
+      lock, [this] { return pending_description_tasks_ == 0; });
 }
+
 } // namespace Service
 } // namespace Domain
 } // namespace TuiRogGame
@@ -11,6 +11,7 @@
 #include "Orc.h"
 #include "Player.h"
 #include "PlayerActionCommand.h"
+#include "Rng.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -22,8 +23,25 @@ using namespace TuiRogGame::Domain::Event;
 
 using ::testing::_;
 using ::testing::ByRef;
+using ::testing::Invoke;
 using ::testing::Return;
 
+namespace {
+// A plain floor tile whose southern neighbour is plain floor as well, so
+// moving down from it produces nothing but a PlayerMovedEvent.
+std::optional<Position> findOpenColumn(const Map &map) {
+  for (int y = 0; y + 1 < map.getHeight(); ++y) {
+    for (int x = 0; x < map.getWidth(); ++x) {
+      if (map.getTile(x, y) == Tile::FLOOR &&
+          map.getTile(x, y + 1) == Tile::FLOOR) {
+        return Position{x, y};
+      }
+    }
+  }
+  return std::nullopt;
+}
+} // namespace
+
 class MockSaveGameStatePort : public ISaveGameStatePort {
 public:
   MOCK_METHOD(void, saveGameState, (const GameStateDTO &game_state),
@@ -38,9 +56,10 @@ public:
 class MockRenderPort : public IRenderPort {
 public:
   MOCK_METHOD(void, render,
-              (const GameStateDTO &game_state,
-               const std::vector<std::unique_ptr<DomainEvent>> &events),
+              (const GameStateDTO &game_state, EventSpan events),
               (override));
+  MOCK_METHOD(void, renderDescription,
+              (const DescriptionGeneratedEvent &description), (override));
 };
 
 class MockGenerateDescriptionPort : public IGenerateDescriptionPort {
@@ -51,6 +70,16 @@ public:
               (override));
 };
 
+class MockBatchDescriptionPort : public IGenerateDescriptionPort {
+public:
+  MOCK_METHOD(std::string, generateDescription,
+              (const GameStateDTO &game_state,
+               const TuiRogGame::Domain::Event::DomainEvent &event),
+              (override));
+  MOCK_METHOD(std::vector<std::string>, generateDescriptions,
+              (const std::vector<DescriptionSubject> &subjects), (override));
+};
+
 class GameEngineTest : public ::testing::Test {
 protected:
   std::shared_ptr<MockSaveGameStatePort> mock_save_port_;
@@ -88,7 +117,11 @@ TEST_F(GameEngineTest, InitializeNewGame) {
   EXPECT_CALL(*mock_load_port_, loadGameState())
       .WillOnce(Return(nullptr)); // Return nullptr for no saved game
 
-  EXPECT_CALL(mock_render_port_, render(_, _));
+  EXPECT_CALL(mock_render_port_, render(_, _))
+      .WillOnce(Invoke([](const GameStateDTO &game_state, EventSpan events) {
+        ASSERT_EQ(events.size(), 1u);
+        EXPECT_EQ(events[0].getType(), DomainEvent::Type::PlayerMoved);
+      }));
   EXPECT_CALL(*mock_save_port_, saveGameState(_));
 
   PlayerActionCommand command(PlayerActionCommand::INITIALIZE);
@@ -97,9 +130,12 @@ TEST_F(GameEngineTest, InitializeNewGame) {
 
 TEST_F(GameEngineTest, PlayerMoves) {
 
-  Player initialPlayer("TestPlayer", Stats{}, {1, 1});
   Map initialMap(10, 10);
-  initialMap.generate(); // Ensure map has floor tiles
+  Rng rng(7);
+  initialMap.generate(rng); // Ensure map has floor tiles
+  auto start = findOpenColumn(initialMap);
+  ASSERT_TRUE(start.has_value());
+  Player initialPlayer("TestPlayer", Stats{}, *start);
 
   EXPECT_CALL(*mock_load_port_, loadGameState())
       .WillOnce(Return(std::make_unique<GameStateDTO>(
@@ -115,14 +151,19 @@ TEST_F(GameEngineTest, PlayerMoves) {
 
   EXPECT_CALL(mock_render_port_, render(_, _))
       .Times(2); // Initialize and then move
+  EXPECT_CALL(mock_render_port_, renderDescription(_))
+      .Times(2); // Descriptions arrive asynchronously, one per action
   EXPECT_CALL(*mock_save_port_, saveGameState(_))
       .Times(2); // Initialize and then move
 
   PlayerActionCommand initCommand(PlayerActionCommand::INITIALIZE);
   game_engine_->handlePlayerAction(initCommand);
+  // A newer turn makes older descriptions stale, so drain before moving on.
+  game_engine_->waitForDescriptions();
 
   PlayerActionCommand moveCommand(PlayerActionCommand::MOVE_DOWN);
   game_engine_->handlePlayerAction(moveCommand);
+  game_engine_->waitForDescriptions();
 }
 
 TEST_F(GameEngineTest, ComplexScenario) {
@@ -134,7 +175,8 @@ TEST_F(GameEngineTest, ComplexScenario) {
 
   Player initialPlayer("Hero", Stats{}, playerStartPos);
   Map initialMap(10, 10);
-  initialMap.generate(); // Generate base map with floor tiles
+  Rng rng(7);
+  initialMap.generate(rng); // Generate base map with floor tiles
 
   initialMap.setTile(itemPos.x, itemPos.y, Tile::ITEM);
   initialMap.setTile(enemyPos.x, enemyPos.y,
@@ -160,15 +202,19 @@ TEST_F(GameEngineTest, ComplexScenario) {
 
   EXPECT_CALL(mock_render_port_, render(_, _))
       .Times(::testing::AtLeast(1)); // At least one render call per action
+  EXPECT_CALL(mock_render_port_, renderDescription(_))
+      .Times(::testing::AtLeast(1));
 
   EXPECT_CALL(*mock_save_port_, saveGameState(_))
       .Times(::testing::AtLeast(1)); // At least one save call per action
 
   PlayerActionCommand initCommand(PlayerActionCommand::INITIALIZE);
   game_engine_->handlePlayerAction(initCommand);
+  game_engine_->waitForDescriptions();
 
   PlayerActionCommand moveDown1(PlayerActionCommand::MOVE_DOWN);
   game_engine_->handlePlayerAction(moveDown1);
+  game_engine_->waitForDescriptions();
 
   PlayerActionCommand moveDown2(PlayerActionCommand::MOVE_DOWN);
   game_engine_->handlePlayerAction(moveDown2);
@@ -184,3 +230,81 @@ TEST_F(GameEngineTest, ComplexScenario) {
   PlayerActionCommand moveDown4(PlayerActionCommand::MOVE_DOWN);
   game_engine_->handlePlayerAction(moveDown4);
 }
+
+TEST(GameEngineBatchTest, DescribesAllEventsOfATurnInOneCall) {
+  auto save_port =
+      std::make_shared<::testing::NiceMock<MockSaveGameStatePort>>();
+  auto load_port = std::make_shared<MockLoadGameStatePort>();
+  ::testing::NiceMock<MockRenderPort> render_port;
+
+  Map map(10, 10, {0, 0}, std::vector<Tile>(100, Tile::FLOOR), {}, {});
+  map.addItem({0, 1}, std::make_unique<Item>(Item::ItemType::HealthPotion,
+                                             "Health Potion"));
+  Player player("TestPlayer", Stats{}, {0, 0});
+  EXPECT_CALL(*load_port, loadGameState())
+      .WillOnce(Return(std::make_unique<GameStateDTO>(map, player)));
+
+  auto desc_port = std::make_unique<MockBatchDescriptionPort>();
+  EXPECT_CALL(*desc_port, generateDescription(_, _)).Times(0);
+  EXPECT_CALL(*desc_port, generateDescriptions(_))
+      .WillOnce(Invoke([](const std::vector<DescriptionSubject> &subjects) {
+        EXPECT_EQ(subjects.size(), 1u);
+        return std::vector<std::string>{"Loaded."};
+      }))
+      .WillOnce(Invoke([](const std::vector<DescriptionSubject> &subjects) {
+        EXPECT_EQ(subjects.size(), 2u);
+        if (subjects.size() == 2u) {
+          EXPECT_EQ(subjects[0].event.getType(),
+                    DomainEvent::Type::PlayerMoved);
+          EXPECT_EQ(subjects[1].event.getType(), DomainEvent::Type::ItemFound);
+          // Each event keeps the state it happened in.
+          EXPECT_TRUE(subjects[0].game_state.player.getInventory().empty());
+        }
+        return std::vector<std::string>{"Moved.", "Found a potion."};
+      }));
+
+  std::vector<std::string> rendered;
+  EXPECT_CALL(render_port, renderDescription(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&rendered](const DescriptionGeneratedEvent &e) {
+        rendered.push_back(e.getDescription());
+      }));
+
+  GameEngine engine(save_port, load_port, std::move(desc_port), nullptr);
+  engine.setRenderPort(&render_port);
+  engine.handlePlayerAction(
+      PlayerActionCommand(PlayerActionCommand::INITIALIZE));
+  engine.waitForDescriptions();
+  engine.handlePlayerAction(
+      PlayerActionCommand(PlayerActionCommand::MOVE_DOWN));
+  engine.waitForDescriptions();
+
+  ASSERT_EQ(rendered,
+            (std::vector<std::string>{"Loaded.", "Moved.", "Found a potion."}));
+}
+
+TEST(GameEngineSeedTest, SameSeedGeneratesSameMaps) {
+  auto generatedTiles = [](std::uint64_t seed) {
+    auto save_port =
+        std::make_shared<::testing::NiceMock<MockSaveGameStatePort>>();
+    auto load_port =
+        std::make_shared<::testing::NiceMock<MockLoadGameStatePort>>();
+    std::vector<Tile> tiles;
+    ON_CALL(*save_port, saveGameState(_))
+        .WillByDefault(Invoke([&tiles](const GameStateDTO &game_state) {
+          auto grid = game_state.map.getTiles();
+          tiles.assign(grid.begin(), grid.end());
+        }));
+
+    GameEngine engine(save_port, load_port, nullptr, nullptr, nullptr, seed);
+    EXPECT_EQ(engine.getSeed(), seed);
+    engine.handlePlayerAction(
+        PlayerActionCommand(PlayerActionCommand::INITIALIZE));
+    return tiles;
+  };
+
+  auto first = generatedTiles(99);
+  ASSERT_FALSE(first.empty());
+  ASSERT_EQ(first, generatedTiles(99));
+  ASSERT_NE(first, generatedTiles(100));
+}
@@ -7,6 +7,9 @@ namespace TuiRogGame {
 namespace Port {
 namespace Out {
 
+// Snapshot of the game state handed to the out-ports. Map copies share their
+// tiles and entities with the engine's map (see Map), so building one per
+// render, save or description request does not deep-copy the map.
 struct GameStateDTO {
   Domain::Model::Map map;
   Domain::Model::Player player;
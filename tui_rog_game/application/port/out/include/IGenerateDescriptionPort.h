@@ -2,18 +2,56 @@
 
 #include "DomainEvent.h"
 #include "GameStateDTO.h"
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace TuiRogGame {
 namespace Port {
 namespace Out {
 
+// An event to describe, together with the game state it happened in.
+struct DescriptionSubject {
+  const GameStateDTO &game_state;
+  const Domain::Event::DomainEvent &event;
+};
+
+// Receives description text while it is generated: the index of the subject
+// it belongs to and the next piece of that subject's description.
+using DescriptionChunkHandler =
+    std::function<void(std::size_t index, const std::string &chunk)>;
+
 class IGenerateDescriptionPort {
 public:
   virtual ~IGenerateDescriptionPort() = default;
   virtual std::string
   generateDescription(const GameStateDTO &game_state,
                       const Domain::Event::DomainEvent &event) = 0;
+
+  // Describes all events of a turn, returning one description per subject in
+  // the same order; an empty one means the event goes undescribed. Ports that
+  // can answer several events with a single request override this, the
+  // default describes them one by one.
+  virtual std::vector<std::string>
+  generateDescriptions(const std::vector<DescriptionSubject> &subjects) {
+    std::vector<std::string> descriptions;
+    descriptions.reserve(subjects.size());
+    for (const auto &subject : subjects) {
+      descriptions.push_back(
+          generateDescription(subject.game_state, subject.event));
+    }
+    return descriptions;
+  }
+
+  // Like generateDescriptions, but ports that can stream also hand each
+  // piece of text to on_chunk as it arrives. The returned descriptions stay
+  // authoritative and may differ from the streamed text, e.g. after a retry.
+  virtual std::vector<std::string>
+  streamDescriptions(const std::vector<DescriptionSubject> &subjects,
+                     const DescriptionChunkHandler &on_chunk) {
+    return generateDescriptions(subjects);
+  }
 };
 
 } // namespace Out
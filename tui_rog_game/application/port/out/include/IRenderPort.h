@@ -1,9 +1,8 @@
 #pragma once
 
-#include "DomainEvent.h"
+#include "DescriptionGeneratedEvent.h"
+#include "EventBuffer.h"
 #include "GameStateDTO.h"
-#include <memory>
-#include <vector>
 
 namespace TuiRogGame {
 namespace Port {
@@ -13,10 +12,15 @@ class IRenderPort {
 public:
   virtual ~IRenderPort() = default;
 
-  virtual void
-  render(const GameStateDTO &game_state,
-         const std::vector<std::unique_ptr<Domain::Event::DomainEvent>>
-             &events) = 0;
+  // The events are only valid for the duration of the call.
+  virtual void render(const GameStateDTO &game_state,
+                      Domain::Event::EventSpan events) = 0;
+
+  // Descriptions are generated off the turn path and delivered here once they
+  // are ready. This is called from a description worker thread, so
+  // implementations must hand the event over to their own thread themselves.
+  virtual void renderDescription(
+      const Domain::Event::DescriptionGeneratedEvent &description) = 0;
 };
 
 } // namespace Out
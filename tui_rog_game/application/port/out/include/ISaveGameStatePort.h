@@ -13,6 +13,10 @@ public:
 
   virtual void
   saveGameState(const TuiRogGame::Port::Out::GameStateDTO &gameState) = 0;
+
+  // Blocks until every save accepted so far has reached storage. Ports that
+  // write synchronously have nothing to do.
+  virtual void flush() {}
 };
 
 } // namespace Out
@@ -1,15 +1,28 @@
 #pragma once
 
+#include "GameServer.h"
 #include "TuiAdapter.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace TuiRogGame {
 namespace Assembly {
 
 class ApplicationBuilder {
 public:
+  // Without a seed, every run generates different maps.
   static std::unique_ptr<Adapter::In::Tui::TuiAdapter>
-  build(ftxui::ScreenInteractive &screen);
+  build(ftxui::ScreenInteractive &screen,
+        std::optional<std::uint64_t> seed = std::nullopt);
+
+  // Headless server mode: every session gets its own engine, saved to the
+  // database at db_path under session-scoped keys. Sessions have no
+  // description ports, since nobody would read the descriptions.
+  static std::unique_ptr<Adapter::In::Server::GameServer>
+  buildServer(std::size_t worker_count, const std::string &db_path);
 };
 
 } // namespace Assembly
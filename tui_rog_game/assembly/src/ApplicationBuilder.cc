@@ -1,41 +1,62 @@
 #include "ApplicationBuilder.h"
 
 #include "GameEngine.h"
+#include "GameServer.h"
 #include "HardcodedDescAdapter.h"
 #include "ILoadGameStatePort.h"
 #include "ISaveGameStatePort.h"
 #include "InMemoryAdapter.h"
 #include "LevelDbAdapter.h"
+#include "LevelDbProvider.h"
 #include "LlmAdapter.h"
 #include "TuiAdapter.h"
+#include "WriteBehindSaveAdapter.h"
 #include "ftxui/component/screen_interactive.hpp"
 #include <memory>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
+#include <string>
 
 namespace TuiRogGame {
 namespace Assembly {
 
+namespace {
+// Saves have always lived here (the provider used to open this path whatever
+// it was given), so existing games keep loading.
+const char *const kSaveDatabasePath = "./game.db";
+} // namespace
+
 std::unique_ptr<TuiRogGame::Adapter::In::Tui::TuiAdapter>
 TuiRogGame::Assembly::ApplicationBuilder::build(
-    ftxui::ScreenInteractive &screen) {
+    ftxui::ScreenInteractive &screen, std::optional<std::uint64_t> seed) {
   auto persistence_adapter =
       std::make_shared<Adapter::Out::Persistence::LevelDbAdapter>(
-          "./game_data.db");
+          kSaveDatabasePath);
   //  auto persistence_adapter =
   //      std::make_shared<Adapter::Out::Persistence::InMemoryAdapter>();
 
   auto hardcoded_desc_adapter =
       std::make_unique<Adapter::Out::Description::HardcodedDescAdapter>();
+  // Descriptions survive restarts next to the saved game, so replaying a
+  // familiar stretch does not pay for the same requests again.
+  Adapter::Out::Description::LlmAdapter::Options llm_options;
+  llm_options.cache.persist_path = "./description_cache.json";
+  // Text shows up in the message log while it is still being generated.
+  llm_options.stream = true;
   auto chatgpt_desc_adapter =
-      std::make_unique<Adapter::Out::Description::LlmAdapter>();
+      std::make_unique<Adapter::Out::Description::LlmAdapter>(llm_options);
+
+  // Saves run on a background writer so a turn never waits on disk I/O.
+  auto save_adapter =
+      std::make_shared<Adapter::Out::Persistence::WriteBehindSaveAdapter>(
+          persistence_adapter);
 
   auto game_engine = std::make_shared<Domain::Service::GameEngine>(
-      std::static_pointer_cast<Port::Out::ISaveGameStatePort>(
-          persistence_adapter),
+      std::static_pointer_cast<Port::Out::ISaveGameStatePort>(save_adapter),
       std::static_pointer_cast<Port::Out::ILoadGameStatePort>(
           persistence_adapter),
-      std::move(hardcoded_desc_adapter), std::move(chatgpt_desc_adapter));
+      std::move(hardcoded_desc_adapter), std::move(chatgpt_desc_adapter),
+      nullptr, seed);
 
   auto tui_adapter =
       std::make_unique<Adapter::In::Tui::TuiAdapter>(game_engine, screen);
@@ -45,5 +66,27 @@ TuiRogGame::Assembly::ApplicationBuilder::build(
   return tui_adapter;
 }
 
+std::unique_ptr<TuiRogGame::Adapter::In::Server::GameServer>
+TuiRogGame::Assembly::ApplicationBuilder::buildServer(
+    std::size_t worker_count, const std::string &db_path) {
+  // LevelDB allows one open handle per database, so sessions share it.
+  auto provider =
+      std::make_shared<Adapter::Out::Persistence::LevelDbProvider>(db_path);
+  auto session_factory = [provider](const std::string &session_id)
+      -> std::shared_ptr<Port::In::IGetPlayerActionUseCase> {
+    auto persistence_adapter =
+        std::make_shared<Adapter::Out::Persistence::LevelDbAdapter>(
+            provider, session_id);
+    return std::make_shared<Domain::Service::GameEngine>(
+        std::static_pointer_cast<Port::Out::ISaveGameStatePort>(
+            persistence_adapter),
+        std::static_pointer_cast<Port::Out::ILoadGameStatePort>(
+            persistence_adapter),
+        nullptr, nullptr);
+  };
+  return std::make_unique<Adapter::In::Server::GameServer>(
+      std::move(session_factory), worker_count);
+}
+
 } // namespace Assembly
 } // namespace TuiRogGame
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <spdlog/spdlog.h>
+#include <string>
+
+// Logging facade over the default spdlog logger.
+//
+// TRG_LOG_ACTIVE_LEVEL (one of SPDLOG_LEVEL_*, set by CMake through
+// TUI_ROG_GAME_LOG_LEVEL) removes calls below it at compile time. Calls that
+// remain check the runtime level before their arguments are evaluated, so
+// something like TRG_LOG_DEBUG("{}", event->toString()) builds no string
+// unless debug output is actually enabled.
+#ifndef TRG_LOG_ACTIVE_LEVEL
+#define TRG_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_DEBUG
+#endif
+
+#define TRG_LOG_CALL(level, ...)                                               \
+  do {                                                                         \
+    auto *trg_logger = spdlog::default_logger_raw();                           \
+    if (trg_logger->should_log(level)) {                                       \
+      trg_logger->log(level, __VA_ARGS__);                                     \
+    }                                                                          \
+  } while (false)
+
+#if TRG_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define TRG_LOG_TRACE(...) TRG_LOG_CALL(spdlog::level::trace, __VA_ARGS__)
+#else
+#define TRG_LOG_TRACE(...) (void)0
+#endif
+
+#if TRG_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define TRG_LOG_DEBUG(...) TRG_LOG_CALL(spdlog::level::debug, __VA_ARGS__)
+#else
+#define TRG_LOG_DEBUG(...) (void)0
+#endif
+
+#if TRG_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define TRG_LOG_INFO(...) TRG_LOG_CALL(spdlog::level::info, __VA_ARGS__)
+#else
+#define TRG_LOG_INFO(...) (void)0
+#endif
+
+#if TRG_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define TRG_LOG_WARN(...) TRG_LOG_CALL(spdlog::level::warn, __VA_ARGS__)
+#else
+#define TRG_LOG_WARN(...) (void)0
+#endif
+
+#if TRG_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define TRG_LOG_ERROR(...) TRG_LOG_CALL(spdlog::level::err, __VA_ARGS__)
+#else
+#define TRG_LOG_ERROR(...) (void)0
+#endif
+
+namespace TuiRogGame {
+namespace Common {
+
+struct LogOptions {
+  std::string file_path = "game.log";
+  spdlog::level::level_enum level = spdlog::level::info;
+  // Messages at or above this level are flushed right away; the rest are
+  // flushed periodically.
+  spdlog::level::level_enum flush_level = spdlog::level::warn;
+  // Capacity of the async queue. When it is full the oldest message is
+  // dropped rather than blocking the game thread. 0 writes synchronously.
+  std::size_t async_queue_size = 8192;
+};
+
+// Replaces the default logger with a file logger configured by options.
+// Throws spdlog::spdlog_ex if the log file cannot be opened.
+void initLogging(const LogOptions &options);
+
+} // namespace Common
+} // namespace TuiRogGame
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ThreadPool.h"
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace TuiRogGame {
+namespace Common {
+
+// Serializes tasks on a shared ThreadPool: tasks posted to one strand run one
+// at a time in posting order, while different strands run in parallel. A
+// strand gives up its worker after kMaxTasksPerRun tasks so that one busy
+// strand cannot starve the others. Create strands with std::make_shared; the
+// pool must outlive every task posted to them.
+class Strand : public std::enable_shared_from_this<Strand> {
+public:
+  using Task = ThreadPool::Task;
+
+  static constexpr std::size_t kMaxTasksPerRun = 16;
+
+  explicit Strand(ThreadPool &pool);
+
+  Strand(const Strand &) = delete;
+  Strand &operator=(const Strand &) = delete;
+
+  void post(Task task);
+
+private:
+  void schedule();
+  void run();
+
+  ThreadPool &pool_;
+  std::mutex mutex_;
+  std::deque<Task> tasks_;
+  bool scheduled_ = false;
+};
+
+} // namespace Common
+} // namespace TuiRogGame
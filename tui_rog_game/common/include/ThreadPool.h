@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TuiRogGame {
+namespace Common {
+
+// Fixed-size pool of worker threads consuming a FIFO task queue.
+// Tasks still queued when the pool is destroyed are discarded; tasks that are
+// already running are allowed to finish.
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(std::size_t worker_count);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void submit(Task task);
+  void waitIdle();
+
+  std::size_t getWorkerCount() const { return workers_.size(); }
+
+private:
+  void workerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable idle_;
+  std::deque<Task> tasks_;
+  std::size_t running_tasks_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace Common
+} // namespace TuiRogGame
@@ -0,0 +1,31 @@
+#include "Log.h"
+#include <chrono>
+#include <memory>
+#include <spdlog/async.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+namespace TuiRogGame {
+namespace Common {
+
+void initLogging(const LogOptions &options) {
+  auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(
+      options.file_path);
+
+  std::shared_ptr<spdlog::logger> logger;
+  if (options.async_queue_size > 0) {
+    spdlog::init_thread_pool(options.async_queue_size, 1);
+    logger = std::make_shared<spdlog::async_logger>(
+        "file_logger", std::move(sink), spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+  } else {
+    logger = std::make_shared<spdlog::logger>("file_logger", std::move(sink));
+  }
+  logger->set_level(options.level);
+  logger->flush_on(options.flush_level);
+
+  spdlog::set_default_logger(std::move(logger));
+  spdlog::flush_every(std::chrono::seconds(1));
+}
+
+} // namespace Common
+} // namespace TuiRogGame
@@ -0,0 +1,44 @@
+#include "Strand.h"
+#include <utility>
+
+namespace TuiRogGame {
+namespace Common {
+
+Strand::Strand(ThreadPool &pool) : pool_(pool) {}
+
+void Strand::post(Task task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if (scheduled_) {
+      return; // The running (or queued) run() will pick it up.
+    }
+    scheduled_ = true;
+  }
+  schedule();
+}
+
+void Strand::schedule() {
+  pool_.submit([self = shared_from_this()] { self->run(); });
+}
+
+void Strand::run() {
+  for (std::size_t i = 0; i < kMaxTasksPerRun; ++i) {
+    Task task;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (tasks_.empty()) {
+        scheduled_ = false;
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+  // Still scheduled_: go to the back of the pool's queue with the rest.
+  schedule();
+}
+
+} // namespace Common
+} // namespace TuiRogGame
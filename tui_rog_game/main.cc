@@ -1,24 +1,139 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cxxopts.hpp>
 #include <iostream>
 #include <memory>
-#include <spdlog/sinks/basic_file_sink.h>
+#include <optional>
 #include <spdlog/spdlog.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "ApplicationBuilder.h"
+#include "CommandScript.h"
+#include "Log.h"
+#include "PlayerActionCommand.h"
 
-int main() {
+namespace {
+
+// Plays random commands in many sessions at once and reports the aggregate
+// throughput.
+int runServer(std::size_t session_count, std::size_t worker_count,
+              std::size_t turn_count, const std::string &db_path) {
+  auto server = TuiRogGame::Assembly::ApplicationBuilder::buildServer(
+      worker_count, db_path);
+
+  std::vector<std::string> session_ids;
+  std::vector<std::vector<TuiRogGame::Port::In::PlayerActionCommand>> scripts;
+  session_ids.reserve(session_count);
+  scripts.reserve(session_count);
+  for (std::size_t i = 0; i < session_count; ++i) {
+    session_ids.push_back("session" + std::to_string(i));
+    scripts.push_back(TuiRogGame::Adapter::In::Headless::generateRandomCommands(
+        turn_count, static_cast<std::uint32_t>(i)));
+    server->openSession(session_ids.back());
+  }
+  server->waitIdle();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t turn = 0; turn < turn_count; ++turn) {
+    for (std::size_t i = 0; i < session_count; ++i) {
+      server->submit(session_ids[i], scripts[i][turn]);
+    }
+  }
+  server->waitIdle();
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+  const std::size_t actions = session_count * turn_count;
+  std::cout << actions << " actions in " << session_count << " sessions on "
+            << server->getWorkerCount() << " workers: " << seconds << " s, "
+            << (seconds > 0 ? actions / seconds : 0.0) << " actions/s"
+            << std::endl;
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+  cxxopts::Options options("tui_rog_game", "TUI roguelike game");
+  options.add_options()(
+      "seed", "Seed for map generation; the same seed replays the same maps",
+      cxxopts::value<std::uint64_t>())(
+      "log-level", "trace, debug, info, warn, error, critical or off",
+      cxxopts::value<std::string>()->default_value("info"))(
+      "log-file", "Log file path",
+      cxxopts::value<std::string>()->default_value("game.log"))(
+      "log-sync", "Write log messages on the game thread instead of a "
+                  "background logger")(
+      "sessions", "Run headless server mode with this many random sessions",
+      cxxopts::value<std::size_t>())(
+      "workers", "Server mode worker threads",
+      cxxopts::value<std::size_t>()->default_value(
+          std::to_string(std::max(1u, std::thread::hardware_concurrency()))))(
+      "turns", "Server mode actions per session",
+      cxxopts::value<std::size_t>()->default_value("100"))(
+      "server-db", "Server mode save database, kept apart from the game's "
+                   "own saves so random sessions never land in them",
+      cxxopts::value<std::string>()->default_value("server.db"))(
+      "h,help", "Print usage");
+
+  std::optional<std::uint64_t> seed;
+  TuiRogGame::Common::LogOptions log_options;
+  std::optional<std::size_t> session_count;
+  std::size_t worker_count = 1;
+  std::size_t turn_count = 0;
+  std::string server_db_path;
+  try {
+    auto result = options.parse(argc, argv);
+    if (result.count("help")) {
+      std::cout << options.help() << std::endl;
+      return 0;
+    }
+    if (result.count("seed")) {
+      seed = result["seed"].as<std::uint64_t>();
+    }
+    const auto level_name = result["log-level"].as<std::string>();
+    log_options.level = spdlog::level::from_str(level_name);
+    if (log_options.level == spdlog::level::off && level_name != "off") {
+      std::cerr << "Invalid arguments: unknown log level '" << level_name
+                << "'" << std::endl;
+      return 1;
+    }
+    log_options.file_path = result["log-file"].as<std::string>();
+    if (result.count("log-sync")) {
+      log_options.async_queue_size = 0;
+    }
+    if (result.count("sessions")) {
+      session_count = result["sessions"].as<std::size_t>();
+    }
+    worker_count = result["workers"].as<std::size_t>();
+    turn_count = result["turns"].as<std::size_t>();
+    server_db_path = result["server-db"].as<std::string>();
+  } catch (const cxxopts::exceptions::exception &ex) {
+    std::cerr << "Invalid arguments: " << ex.what() << std::endl;
+    return 1;
+  }
 
   try {
-    auto file_logger = spdlog::basic_logger_mt("file_logger", "game.log");
-    spdlog::set_default_logger(file_logger);
-    spdlog::set_level(spdlog::level::debug);
-    spdlog::flush_on(spdlog::level::info);
+    TuiRogGame::Common::initLogging(log_options);
   } catch (const spdlog::spdlog_ex &ex) {
     std::cerr << "Log initialization failed: " << ex.what() << std::endl;
     return 1;
   }
 
+  if (session_count) {
+    return runServer(*session_count, worker_count, turn_count,
+                     server_db_path);
+  }
+
   auto screen = ftxui::ScreenInteractive::Fullscreen();
-  auto tui_adapter = TuiRogGame::Assembly::ApplicationBuilder::build(screen);
+  auto tui_adapter =
+      TuiRogGame::Assembly::ApplicationBuilder::build(screen, seed);
   tui_adapter->run();
 
   return 0;